@@ -43,13 +43,13 @@
 #include "ox/ox_types.h"
 #include "ox/ox_log.h"
 #include "ox/ox_mem.h"
+#include "ox/ox_error.h"
 #include "ox/ox_vector.h"
 #include "ox/ox_char_buffer.h"
 #include "ox/ox_list.h"
 #include "ox/ox_hash.h"
 #include "ox/ox_value.h"
 #include "ox/ox_gc.h"
-#include "ox/ox_error.h"
 #include "ox/ox_string.h"
 #include "ox/ox_array.h"
 #include "ox/ox_function.h"
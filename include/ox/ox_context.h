@@ -76,6 +76,28 @@ ox_set_file_enc (OX_Context *ctxt, const char *enc);
 extern OX_Result
 ox_set_dump_throw (OX_Context *ctxt, OX_Bool b);
 
+/**
+ * Set the bytecode optimization level of the compiler.
+ * @param ctxt The current running context.
+ * @param level The optimization level.
+ * 0 means do not optimize the bytecode.
+ * @retval OX_OK On success.
+ * @retval OX_ERR On error.
+ */
+extern OX_Result
+ox_set_opt_level (OX_Context *ctxt, int level);
+
+/**
+ * Enable or disable the JIT compiler.
+ * The JIT compiler is only available on x86-64 Linux.
+ * @param ctxt The current running context.
+ * @param b Enable the JIT compiler or not.
+ * @retval OX_OK On success.
+ * @retval OX_ERR On error.
+ */
+extern OX_Result
+ox_set_jit (OX_Context *ctxt, OX_Bool b);
+
 /**
  * Set the OX installation directory.
  * @param ctxt The current running context.
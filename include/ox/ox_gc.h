@@ -50,6 +50,119 @@ ox_gc_add (OX_Context *ctxt, void *ptr);
 extern void
 ox_gc_run (OX_Context *ctxt);
 
+/**
+ * Set the number of the threads used in the marking process.
+ * @param ctxt The current running context.
+ * @param n Number of the marking threads.
+ * @retval OX_OK On success.
+ * @retval OX_ERR On error.
+ */
+extern OX_Result
+ox_gc_set_thread_num (OX_Context *ctxt, int n);
+
+/**
+ * Set the memory size to start running the garbage collecter.
+ * @param ctxt The current running context.
+ * @param size The memory size in bytes.
+ */
+extern void
+ox_gc_set_start_size (OX_Context *ctxt, size_t size);
+
+/**
+ * Get the memory size to start running the garbage collecter.
+ * @param ctxt The current running context.
+ * @return The memory size in bytes.
+ */
+extern size_t
+ox_gc_get_start_size (OX_Context *ctxt);
+
+/**
+ * Set the memory growth to start the next full collection.
+ * The full collection starts when the allocated memory size exceeds
+ * "percent"% of the size after the last full collection.
+ * @param ctxt The current running context.
+ * @param percent The growth in percent, at least 101.
+ */
+extern void
+ox_gc_set_growth (OX_Context *ctxt, int percent);
+
+/**
+ * Get the memory growth to start the next full collection.
+ * @param ctxt The current running context.
+ * @return The growth in percent.
+ */
+extern int
+ox_gc_get_growth (OX_Context *ctxt);
+
+/**
+ * Set the number of objects scanned in an incremental marking slice.
+ * A smaller value shortens the pauses of the allocations,
+ * and a larger value finishes the marking in less slices.
+ * @param ctxt The current running context.
+ * @param n Number of objects, at least 1.
+ */
+extern void
+ox_gc_set_slice_work (OX_Context *ctxt, size_t n);
+
+/**
+ * Get the number of objects scanned in an incremental marking slice.
+ * @param ctxt The current running context.
+ * @return Number of objects.
+ */
+extern size_t
+ox_gc_get_slice_work (OX_Context *ctxt);
+
+/**
+ * Set the maximum heap size.
+ * An allocation exceeding the maximum heap size runs a full collection first.
+ * If it still exceeds the maximum heap size, the allocation fails,
+ * and the caller throws a no memory error.
+ * @param ctxt The current running context.
+ * @param size The maximum heap size in bytes, 0 means no limit.
+ */
+extern void
+ox_gc_set_max_size (OX_Context *ctxt, size_t size);
+
+/**
+ * Get the maximum heap size.
+ * @param ctxt The current running context.
+ * @return The maximum heap size in bytes, 0 means no limit.
+ */
+extern size_t
+ox_gc_get_max_size (OX_Context *ctxt);
+
+/**
+ * Get the statistics of the garbage collecter.
+ * @param ctxt The current running context.
+ * @param[out] stats Return the statistics.
+ */
+extern void
+ox_gc_get_stats (OX_Context *ctxt, OX_GcStats *stats);
+
+/**
+ * Set the callback function invoked when a collection finished.
+ * The callback is invoked in the garbage collecter,
+ * it must not allocate GC managed objects or run scripts.
+ * @param ctxt The current running context.
+ * @param cb The callback function, NULL means no callback.
+ * @param data The user defined data passed to the callback.
+ */
+extern void
+ox_gc_set_callback (OX_Context *ctxt, OX_GcCallback cb, void *data);
+
+/**
+ * Check if the GC managed object is unused and waiting to be freed.
+ * After a full collection, the unused objects are freed lazily.
+ * An object found in a table not scanned by the garbage collecter
+ * must be checked before it is used again.
+ * @param ctxt The current running context.
+ * @param gco The GC managed object.
+ * @retval OX_TRUE The object is unused.
+ * @retval OX_FALSE The object is still alive.
+ */
+extern OX_Bool
+ox_gc_is_dead (OX_Context *ctxt, OX_GcObject *gco);
+
 /**
  * Mark the GC managed object as used.
  * This function must be invoked in garbage collection process.
@@ -59,6 +172,34 @@ ox_gc_run (OX_Context *ctxt);
 extern void
 ox_gc_mark_inner (OX_Context *ctxt, OX_GcObject *gco);
 
+/**
+ * Add the old GC managed object to the remembered set.
+ * @param ctxt The current running context.
+ * @param gco The GC managed object.
+ */
+extern void
+ox_gc_remember (OX_Context *ctxt, OX_GcObject *gco);
+
+/**
+ * Write barrier of the generational garbage collecter.
+ * Invoke it when a reference is stored in the GC managed object.
+ * An old object (survived a collection) is added to the remembered set,
+ * so the minor collection can find the young objects referenced by it.
+ * When the incremental marking is running, a scanned object is scanned again
+ * when the marking finished.
+ * @param ctxt The current running context.
+ * @param ptr The GC managed object's pointer.
+ */
+static inline void
+ox_gc_write_barrier (OX_Context *ctxt, void *ptr)
+{
+    OX_GcObject *gco = ptr;
+
+    /*Old objects keep the marked flag between collections.*/
+    if ((gco->next_flags & (OX_GC_FL_MARKED|OX_GC_FL_REMEMBERED)) == OX_GC_FL_MARKED)
+        ox_gc_remember(ctxt, gco);
+}
+
 /**
  * Mark the GC managed object as used.
  * This function must be invoked in garbage collection process.
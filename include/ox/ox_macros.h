@@ -136,6 +136,13 @@ extern "C" {
 #define OX_CONTAINER_OF(p, s, m)\
     OX_SIZE2PTR(OX_PTR2SIZE(p) - OX_OFFSET_OF(s, m))
 
+#if defined(__GNUC__) || defined(__clang__)
+/** Inline function which is always inlined even in the very large function.*/
+#define OX_ALWAYS_INLINE static inline __attribute__((always_inline))
+#else
+#define OX_ALWAYS_INLINE static inline
+#endif
+
 #ifndef OX_TEXT_DOMAIN
 #define OX_TEXT_DOMAIN "ox"
 #endif
@@ -42,7 +42,8 @@ extern "C" {
  * @param osize The old buffer's size.
  * @param nsize The new buffer's size.
  * @return The new buffer's pointer.
- * @retval NULL Cannot allocate the new buffer if nsize is not 0.
+ * @retval NULL Cannot allocate the new buffer if nsize is not 0,
+ * or the allocation exceeds the maximum heap size.
  */
 extern void*
 ox_realloc (OX_Context *ctxt, void *optr, size_t osize, size_t nsize);
@@ -92,6 +92,7 @@ ox_object_set_interface (OX_Context *ctxt, OX_Value *o, OX_Value *inf)
 
     op = ox_value_get_gco(ctxt, o);
 
+    ox_gc_write_barrier(ctxt, op);
     ox_value_copy(ctxt, &op->inf, inf);
     return OX_OK;
 }
@@ -448,6 +448,15 @@ ox_to_ssize (OX_Context *ctxt, OX_Value *v, ssize_t *pi);
 static inline OX_Result
 ox_to_index (OX_Context *ctxt, OX_Value *v, size_t *pi)
 {
+    if (ox_value_is_int32(ctxt, v)) {
+        int32_t i = ox_value_get_int32(ctxt, v);
+
+        if (i >= 0) {
+            *pi = i;
+            return OX_OK;
+        }
+    }
+
     return ox_to_size(ctxt, v, pi);
 }
 
@@ -487,6 +496,11 @@ ox_to_int32 (OX_Context *ctxt, OX_Value *v, int32_t *pi)
     OX_Number n;
     OX_Result r;
 
+    if (ox_value_is_int32(ctxt, v)) {
+        *pi = ox_value_get_int32(ctxt, v);
+        return OX_OK;
+    }
+
     if ((r = ox_to_number(ctxt, v, &n)) == OX_ERR) {
         *pi = 0;
         return r;
@@ -200,6 +200,7 @@ typedef enum {
     OX_GCO_CTYPE        = OX_GCO_TYPE(19,OX_GCO_FL_OPS|OX_GCO_FL_OBJECT), /**< C type.*/
     OX_GCO_CVALUE       = OX_GCO_TYPE(20,OX_GCO_FL_OPS|OX_GCO_FL_OBJECT), /**< C value.*/
     OX_GCO_PROXY        = OX_GCO_TYPE(21,OX_GCO_FL_OPS|OX_GCO_FL_OBJECT), /**< Proxy object.*/
+    OX_GCO_CELL         = OX_GCO_TYPE(22, 0),               /**< Captured declaration's cell.*/
 } OX_GcObjectType;
 
 /** GC managed object.*/
@@ -218,6 +219,8 @@ typedef struct {
 #define OX_GC_FL_MARKED  (1 << 0)
 /** The GC managed object is scanned.*/
 #define OX_GC_FL_SCANNED (1 << 1)
+/** The old GC managed object is in the remembered set.*/
+#define OX_GC_FL_REMEMBERED (1 << 2)
 
 /** GC managed object.*/
 struct OX_GcObject_s {
@@ -225,6 +228,28 @@ struct OX_GcObject_s {
     size_t                next_flags; /**< The next GC managed object and flags.*/
 };
 
+/** Statistics of the garbage collecter.*/
+typedef struct {
+    size_t   minor_count;  /**< Number of the minor collections.*/
+    size_t   full_count;   /**< Number of the full collections.*/
+    uint64_t pause_total;  /**< Total pause time in nanoseconds.*/
+    uint64_t pause_max;    /**< Maximum pause time in nanoseconds.*/
+    uint64_t allocated;    /**< Total allocated memory size in bytes.*/
+    uint64_t freed;        /**< Total freed memory size in bytes.*/
+    size_t   live_size;    /**< Memory size after the last collection.*/
+    size_t   mem_size;     /**< Current allocated memory size.*/
+    size_t   max_mem_size; /**< Maximum allocated memory size.*/
+} OX_GcStats;
+
+/**
+ * Callback function invoked when a collection finished.
+ * @param ctxt The current running context.
+ * @param full The collection is a full collection.
+ * @param stats The statistics of the garbage collecter.
+ * @param data The user defined data.
+ */
+typedef void (*OX_GcCallback) (OX_Context *ctxt, OX_Bool full, const OX_GcStats *stats, void *data);
+
 /** String.*/
 typedef struct {
     OX_GcObject gco;   /**< Base GC managed object data.*/
@@ -287,8 +312,6 @@ typedef enum {
 /** Property.*/
 typedef struct {
     OX_PropertyType  type; /**< Property type.*/
-    OX_List          ln;   /**< List node data.*/
-    OX_HashEntry     he;   /**< Hash table entry data.*/
     union {
         struct {
             OX_Value get;  /**< Getter of accessor.*/
@@ -308,12 +331,19 @@ typedef struct {
 
 /** Object.*/
 typedef struct OX_Object_s OX_Object;
+/** Shape of the objects.*/
+typedef struct OX_Shape_s OX_Shape;
+/** Properties dictionary of the object.*/
+typedef struct OX_PropertyDict_s OX_PropertyDict;
 /** Object.*/
 struct OX_Object_s {
     OX_GcObject  gco;     /**< Base GC managed object data.*/
     OX_Value     inf;     /**< Interface object.*/
-    OX_List      p_list;  /**< Properties list.*/
-    OX_Hash      p_hash;  /**< Properties hash table.*/
+    OX_Shape    *shape;   /**< The shape of the object. NULL means the object is in dictionary mode.*/
+    union {
+        OX_Property     *props; /**< Properties array in shape mode.*/
+        OX_PropertyDict *dict;  /**< Properties dictionary in dictionary mode.*/
+    } p;                  /**< Properties data.*/
     const OX_PrivateOps *priv_ops; /**< Private data's operation functions.*/
     void        *priv;    /**< Private data.*/
 };
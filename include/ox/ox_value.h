@@ -41,6 +41,8 @@ extern "C" {
 #define OX_VALUE_TAG_BOOL    0x7ffa
 /** GC managed object value tag.*/
 #define OX_VALUE_TAG_GCO     0x7ffb
+/** 32 bits integer number value tag.*/
+#define OX_VALUE_TAG_INT32   0x7ffc
 
 /**
  * Get the current value stack.
@@ -68,7 +70,7 @@ ox_get_value_stack (OX_Context *ctxt)
  * @param v The value.
  * @return The value's real pointer.
  */
-static inline OX_Value*
+OX_ALWAYS_INLINE OX_Value*
 ox_value_get_pointer (OX_Context *ctxt, OX_Value *v)
 {
     if (OX_VALUE_IN_STACK(v)) {
@@ -150,7 +152,7 @@ ox_values_copy (OX_Context *ctxt, OX_Value *dst, OX_Value *src, size_t n)
  * @param v The value pointer.
  * @return The tag of the value.
  */
-static inline int
+OX_ALWAYS_INLINE int
 ox_value_get_tag (OX_Value *v)
 {
     return *v >> 48;
@@ -162,7 +164,7 @@ ox_value_get_tag (OX_Value *v)
  * @param v The value's pointer.
  * @return The value's type.
  */
-static inline OX_ValueType
+OX_ALWAYS_INLINE OX_ValueType
 ox_value_get_type (OX_Context *ctxt, OX_Value *v)
 {
     int tag;
@@ -235,17 +237,41 @@ ox_value_set_bool (OX_Context *ctxt, OX_Value *v, int b)
  * @param v The value to be set.
  * @param n The number value.
  */
-static inline void
+OX_ALWAYS_INLINE void
 ox_value_set_number (OX_Context *ctxt, OX_Value *v, OX_Number n)
 {
     v = ox_value_get_pointer(ctxt, v);
 
+    /*Integer numbers in 32 bits range are always stored with the integer tag.*/
+    if ((n >= INT32_MIN) && (n <= INT32_MAX)) {
+        int32_t i = n;
+
+        if ((i == n) && (i || !signbit(n))) {
+            *v = (((OX_Value)OX_VALUE_TAG_INT32) << 48) | (uint32_t)i;
+            return;
+        }
+    }
+
     if (isnan(n))
         *(OX_Number*)v = NAN;
     else
         *(OX_Number*)v = n;
 }
 
+/**
+ * Set the value as a 32 bits integer number.
+ * @param ctxt The current running context.
+ * @param v The value to be set.
+ * @param i The integer number.
+ */
+OX_ALWAYS_INLINE void
+ox_value_set_int32 (OX_Context *ctxt, OX_Value *v, int32_t i)
+{
+    v = ox_value_get_pointer(ctxt, v);
+
+    *v = (((OX_Value)OX_VALUE_TAG_INT32) << 48) | (uint32_t)i;
+}
+
 /**
  * Set the value as a GC managed object.
  * @param ctxt The current running context.
@@ -286,14 +312,32 @@ ox_value_get_bool (OX_Context *ctxt, OX_Value *v)
  * @param v The value.
  * @return The number value.
  */
-static inline OX_Number
+OX_ALWAYS_INLINE OX_Number
 ox_value_get_number (OX_Context *ctxt, OX_Value *v)
 {
     v = ox_value_get_pointer(ctxt, v);
 
+    if (ox_value_get_tag(v) == OX_VALUE_TAG_INT32)
+        return (int32_t)(uint32_t)*v;
+
     return *(OX_Number*)v;
 }
 
+/**
+ * Get the 32 bits integer number from a value.
+ * The value must be a 32 bits integer number.
+ * @param ctxt The current running context.
+ * @param v The value.
+ * @return The integer number.
+ */
+OX_ALWAYS_INLINE int32_t
+ox_value_get_int32 (OX_Context *ctxt, OX_Value *v)
+{
+    v = ox_value_get_pointer(ctxt, v);
+
+    return (int32_t)(uint32_t)*v;
+}
+
 /**
  * Get the GC managed object pointer from a value pointer.
  * @param v The value.
@@ -418,12 +462,27 @@ ox_value_is_gco (OX_Context *ctxt, OX_Value *v, OX_GcObjectType type)
  * @retval OX_TRUE v is a number.
  * @retval OX_FALSE v is not a number.
  */
-static inline OX_Bool
+OX_ALWAYS_INLINE OX_Bool
 ox_value_is_number (OX_Context *ctxt, OX_Value *v)
 {
     return ox_value_get_type(ctxt, v) == OX_VALUE_NUMBER;
 }
 
+/**
+ * Check if the value is a number stored as 32 bits integer.
+ * @param ctxt The current running context.
+ * @param v The value.
+ * @retval OX_TRUE v is a 32 bits integer number.
+ * @retval OX_FALSE v is not a 32 bits integer number.
+ */
+OX_ALWAYS_INLINE OX_Bool
+ox_value_is_int32 (OX_Context *ctxt, OX_Value *v)
+{
+    v = ox_value_get_pointer(ctxt, v);
+
+    return ox_value_get_tag(v) == OX_VALUE_TAG_INT32;
+}
+
 /**
  * Get the current value stack's top.
  * @param ctxt The current running context.
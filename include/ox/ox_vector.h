@@ -110,7 +110,7 @@ ox_gen_vector_set_capacity (OX_Context *ctxt, OX_GenVector *gv, size_t cap, size
         uint8_t *nitems = ox_realloc(ctxt, gv->items, gv->cap * es, cap *es);
 
         if (!nitems)
-            return OX_ERR;
+            return ox_throw_no_mem_error(ctxt);
 
         gv->items = nitems;
         gv->cap = cap;
@@ -150,7 +150,7 @@ ox_gen_vector_expand_capacity (OX_Context *ctxt, OX_GenVector *gv, size_t cap, s
         nitems = ox_realloc(ctxt, gv->items, gv->cap * es, cap *es);
 
         if (!nitems)
-            return OX_ERR;
+            return ox_throw_no_mem_error(ctxt);
 
         gv->items = nitems;
         gv->cap = cap;
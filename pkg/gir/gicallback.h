@@ -254,7 +254,7 @@ gicallback_to_value (OX_Context *ctxt, OX_GIRepository *repo, void *p, GICallabl
     OX_Result r;
 
     cb = ox_hash_lookup_c(ctxt, &repo->cb_hash, p, NULL, OX_GICallback, he);
-    if (!cb) {
+    if (!cb || ox_gc_is_dead(ctxt, ox_value_get_gco(ctxt, &cb->v))) {
         r = ox_throw_type_error(ctxt, OX_TEXT("the value is not a GLib callback"));
         goto end;
     }
@@ -107,9 +107,15 @@ giinst_to_value (OX_Context *ctxt, OX_GIRepository *repo, void *p, OX_GIOwn *pow
 
     inst = ox_hash_lookup_c(ctxt, &repo->inst_hash, p, &pe, OX_GIInst, he);
     if (inst) {
-        ox_value_copy(ctxt, v, &inst->v);
-        r = OX_OK;
-        goto end;
+        if (!ox_gc_is_dead(ctxt, ox_value_get_gco(ctxt, &inst->v))) {
+            ox_value_copy(ctxt, v, &inst->v);
+            r = OX_OK;
+            goto end;
+        }
+
+        /*The unused instance is waiting to be freed, create a new one.*/
+        ox_hash_remove(ctxt, &repo->inst_hash, p, pe);
+        inst->he.key = NULL;
     }
 
     if ((r = gibaseinfo_to_value(ctxt, repo, bi, tyv)) == OX_ERR)
@@ -163,7 +169,9 @@ giinst_to_value (OX_Context *ctxt, OX_GIRepository *repo, void *p, OX_GIOwn *pow
         goto end;
     }
 
-    r = ox_hash_insert(ctxt, &repo->inst_hash, p, &inst->he, pe);
+    /*The unused instances may be removed from the hash table by the garbage collecter
+     *while the new one is created, so the position is looked up again.*/
+    r = ox_hash_insert(ctxt, &repo->inst_hash, p, &inst->he, NULL);
 end:
     OX_VS_POP(ctxt, tyv)
     return r;
@@ -174,6 +174,7 @@ Fiber_inf_init (OX_Context *ctxt, OX_Value *f, OX_Value *thiz, OX_Value *args, s
 
     frame->ip = 0;
     fiber->rsr.frame = frame;
+    ox_frame_escape(ctxt, frame);
     ctxt->frames = old_frame;
     ox_value_copy(ctxt, &frame->thiz, targ);
 
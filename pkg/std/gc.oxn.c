@@ -0,0 +1,158 @@
+/******************************************************************************
+ *                                 OX Language                                *
+ *                                                                            *
+ * Copyright 2024 Gong Ke                                                     *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the              *
+ * "Software"), to deal in the Software without restriction, including        *
+ * without limitation the rights to use, copy, modify, merge, publish,        *
+ * distribute, sublicense, and/or sell copies of the Software, and to permit  *
+ * persons to whom the Software is furnished to do so, subject to the         *
+ * following conditions:                                                      *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included    *
+ * in all copies or substantial portions of the Software.                     *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS    *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF                 *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN  *
+ * NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,   *
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR      *
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE  *
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.                                     *
+ ******************************************************************************/
+
+/**
+ * @file
+ * Garbage collecter.
+ */
+
+#define OX_LOG_TAG "gc"
+
+#include "std.h"
+
+/*Declaration index.*/
+enum {
+    ID_run,
+    ID_stats,
+    ID_MAX
+};
+
+/*Public table.*/
+static const char*
+pub_tab[] = {
+    "run",
+    "stats",
+    NULL
+};
+
+/*Script description.*/
+static const OX_ScriptDesc
+script_desc = {
+    NULL,
+    pub_tab,
+    ID_MAX
+};
+
+/*run.*/
+static OX_Result
+GC_run (OX_Context *ctxt, OX_Value *f, OX_Value *thiz, OX_Value *args, size_t argc, OX_Value *rv)
+{
+    ox_gc_run(ctxt);
+    return OX_OK;
+}
+
+/*Set a number property of the object.*/
+static OX_Result
+set_number (OX_Context *ctxt, OX_Value *o, const char *p, OX_Number n)
+{
+    OX_VS_PUSH(ctxt, v)
+    OX_Result r;
+
+    ox_value_set_number(ctxt, v, n);
+    r = ox_set_s(ctxt, o, p, v);
+
+    OX_VS_POP(ctxt, v)
+    return r;
+}
+
+/*stats.*/
+static OX_Result
+GC_stats (OX_Context *ctxt, OX_Value *f, OX_Value *thiz, OX_Value *args, size_t argc, OX_Value *rv)
+{
+    OX_GcStats stats;
+    OX_Result r;
+
+    ox_gc_get_stats(ctxt, &stats);
+
+    if ((r = ox_object_new(ctxt, rv, NULL)) == OX_ERR)
+        return r;
+
+    if ((r = set_number(ctxt, rv, "minor_count", stats.minor_count)) == OX_ERR)
+        return r;
+    if ((r = set_number(ctxt, rv, "full_count", stats.full_count)) == OX_ERR)
+        return r;
+    if ((r = set_number(ctxt, rv, "pause_total", stats.pause_total / 1000000.)) == OX_ERR)
+        return r;
+    if ((r = set_number(ctxt, rv, "pause_max", stats.pause_max / 1000000.)) == OX_ERR)
+        return r;
+    if ((r = set_number(ctxt, rv, "allocated", stats.allocated)) == OX_ERR)
+        return r;
+    if ((r = set_number(ctxt, rv, "freed", stats.freed)) == OX_ERR)
+        return r;
+    if ((r = set_number(ctxt, rv, "live_size", stats.live_size)) == OX_ERR)
+        return r;
+    if ((r = set_number(ctxt, rv, "mem_size", stats.mem_size)) == OX_ERR)
+        return r;
+    if ((r = set_number(ctxt, rv, "max_mem_size", stats.max_mem_size)) == OX_ERR)
+        return r;
+
+    return OX_OK;
+}
+
+/*Load this module.*/
+OX_Result
+ox_load (OX_Context *ctxt, OX_Value *s)
+{
+    ox_not_error(ox_script_set_desc(ctxt, s, &script_desc));
+    return OX_OK;
+}
+
+/*?
+ *? @lib Garbage collecter.
+ *?
+ *? @func run Run a full garbage collection.
+ *?
+ *? @func stats Get the statistics of the garbage collecter.
+ *? @return {Object} The statistics object.
+ *? @ul{
+ *? @li minor_count: Number of the finished minor collections.
+ *? @li full_count: Number of the finished full collections.
+ *? @li pause_total: Cumulative pause time in milliseconds.
+ *? @li pause_max: Maximum pause time in milliseconds.
+ *? @li allocated: Total bytes allocated.
+ *? @li freed: Total bytes freed.
+ *? @li live_size: Allocated bytes after the last collection.
+ *? @li mem_size: Current allocated bytes.
+ *? @li max_mem_size: Maximum allocated bytes.
+ *? @ul}
+ */
+
+/*Execute.*/
+OX_Result
+ox_exec (OX_Context *ctxt, OX_Value *f, OX_Value *s, OX_Value *args, size_t argc, OX_Value *rv)
+{
+    OX_VS_PUSH(ctxt, v)
+
+    /*run*/
+    ox_not_error(ox_named_native_func_new_s(ctxt, v, GC_run, NULL, "run"));
+    ox_not_error(ox_script_set_value(ctxt, s, ID_run, v));
+
+    /*stats*/
+    ox_not_error(ox_named_native_func_new_s(ctxt, v, GC_stats, NULL, "stats"));
+    ox_not_error(ox_script_set_value(ctxt, s, ID_stats, v));
+
+    OX_VS_POP(ctxt, v)
+    return OX_OK;
+}
@@ -186,42 +186,58 @@ StackEntry_inf_line_get (OX_Context *ctxt, OX_Value *f, OX_Value *thiz, OX_Value
     return OX_OK;
 }
 
-/*Lookup the name in the frame.*/
+/*Lookup the name in the frame.
+ *"pv" returns the value's slot. "po" returns the function
+ *if the slot is the value captured by the function.*/
 static OX_Result
-stack_lookup (OX_Context *ctxt, OX_Frame *f, OX_Value *n, OX_Frame **pf, OX_ScriptDecl **psd)
+stack_lookup (OX_Context *ctxt, OX_Frame *f, OX_Value *n, OX_Value **pv, OX_ScriptDecl **psd,
+        OX_Function **po)
 {
     OX_ScriptDecl *sd;
-    OX_Frame *cf = f;
-    OX_Function *func;
+    OX_Function *func, *bf;
+    OX_Value *v = NULL;
     OX_String *k;
     OX_Result r;
 
     if ((r = ox_string_singleton(ctxt, n)) == OX_ERR)
         return r;
 
-    func = ox_value_get_gco(ctxt, &cf->func);
+    *po = NULL;
+
+    func = ox_value_get_gco(ctxt, &f->func);
     k = ox_value_get_gco(ctxt, n);
     sd = ox_hash_lookup_c(ctxt, &func->sfunc->decl_hash, k, NULL, OX_ScriptDecl, he);
-    if (!sd) {
-        OX_Frame **sf, **ef;
+    if (sd) {
+        v = &f->v[sd->id];
+    } else {
+        int i;
 
-        sf = func->frames;
-        ef = sf + func->sfunc->frame_num;
+        /*Lookup the values captured by the function.*/
+        for (i = 0; i < func->sfunc->cap_num; i ++) {
+            OX_ScriptCapture *cap = &func->sfunc->caps[i];
 
-        while (sf < ef) {
-            cf = *sf;
-            func = ox_value_get_gco(ctxt, &cf->func);
-            sd = ox_hash_lookup_c(ctxt, &func->sfunc->decl_hash, k, NULL, OX_ScriptDecl, he);
-            if (sd)
+            if (cap->decl && ((OX_String*)cap->decl->he.key == k)) {
+                sd = cap->decl;
+                v = &func->caps[i];
+                *po = func;
                 break;
+            }
+        }
+
+        /*Lookup the script's frames.*/
+        for (i = 0; !sd && (i < func->sfunc->frame_num); i ++) {
+            OX_Frame *cf = func->frames[i];
 
-            sf ++;
+            bf = ox_value_get_gco(ctxt, &cf->func);
+            sd = ox_hash_lookup_c(ctxt, &bf->sfunc->decl_hash, k, NULL, OX_ScriptDecl, he);
+            if (sd)
+                v = &cf->v[sd->id];
         }
     }
 
-    *pf = cf;
+    *pv = v;
     *psd = sd;
-    return OX_OK;
+    return sd ? OX_OK : OX_FALSE;
 }
 
 /*StackEntry.$inf.get.*/
@@ -242,14 +258,15 @@ StackEntry_inf_get (OX_Context *ctxt, OX_Value *f, OX_Value *thiz, OX_Value *arg
         goto end;
 
     if (ox_value_get_gco_type(ctxt, &se->frame->func) == OX_GCO_FUNCTION) {
-        OX_Frame *tf;
+        OX_Value *sv;
         OX_ScriptDecl *sd;
+        OX_Function *o;
 
-        if ((r = stack_lookup(ctxt, se->frame, n, &tf, &sd)) == OX_ERR)
+        if ((r = stack_lookup(ctxt, se->frame, n, &sv, &sd, &o)) == OX_ERR)
             goto end;
 
         if (r)
-            ox_value_copy(ctxt, rv, &tf->v[sd->id]);
+            ox_value_copy(ctxt, rv, ox_cell_value(ctxt, sv));
         else
             ox_value_set_null(ctxt, rv);
     } else {
@@ -281,10 +298,11 @@ StackEntry_inf_set (OX_Context *ctxt, OX_Value *f, OX_Value *thiz, OX_Value *arg
         goto end;
 
     if (ox_value_get_gco_type(ctxt, &se->frame->func) == OX_GCO_FUNCTION) {
-        OX_Frame *tf;
+        OX_Value *sv;
         OX_ScriptDecl *sd;
+        OX_Function *o;
 
-        if ((r = stack_lookup(ctxt, se->frame, n, &tf, &sd)) == OX_ERR)
+        if ((r = stack_lookup(ctxt, se->frame, n, &sv, &sd, &o)) == OX_ERR)
             goto end;
 
         if (!r) {
@@ -293,13 +311,18 @@ StackEntry_inf_set (OX_Context *ctxt, OX_Value *f, OX_Value *thiz, OX_Value *arg
             goto end;
         }
 
-        if ((sd->type == OX_DECL_CONST) || (sd->type == OX_DECL_REF)) {
+        if (((sd->type & OX_DECL_TYPE_MASK) == OX_DECL_CONST)
+                || ((sd->type & OX_DECL_TYPE_MASK) == OX_DECL_REF)) {
             r = ox_throw_access_error(ctxt, OX_TEXT("cannot set the constant \"%s\""),
                     ox_string_get_char_star(ctxt, n));
             goto end;
         }
 
-        ox_value_copy(ctxt, &tf->v[sd->id], v);
+        ox_cell_set(ctxt, sv, v);
+
+        /*The value captured without cell is stored in the function.*/
+        if (o)
+            ox_gc_write_barrier(ctxt, o);
     } else {
         r = ox_throw_reference_error(ctxt, OX_TEXT("cannot set variable in native function"));
         goto end;
@@ -457,6 +480,10 @@ stack_func (OX_Context *ctxt, OX_Value *f, OX_Value *thiz, OX_Value *args, size_
         goto end;
 
     frame = ox_frame_get(ctxt);
+
+    /*The stack entries reference the frames.*/
+    ox_frame_escape(ctxt, frame);
+
     while (frame && (i < size)) {
         if ((r = stack_entry_new(ctxt, item, frame, inf)) == OX_ERR)
             goto end;
@@ -543,6 +570,106 @@ OX_install_dir_get (OX_Context *ctxt, OX_Value *f, OX_Value *thiz, OX_Value *arg
     return r;
 }
 
+/*OX.gc_start_size getter.*/
+static OX_Result
+OX_gc_start_size_get (OX_Context *ctxt, OX_Value *f, OX_Value *thiz, OX_Value *args, size_t argc, OX_Value *rv)
+{
+    ox_value_set_number(ctxt, rv, ox_gc_get_start_size(ctxt));
+    return OX_OK;
+}
+
+/*OX.gc_start_size setter.*/
+static OX_Result
+OX_gc_start_size_set (OX_Context *ctxt, OX_Value *f, OX_Value *thiz, OX_Value *args, size_t argc, OX_Value *rv)
+{
+    OX_Value *arg = ox_argument(ctxt, args, argc, 0);
+    size_t size;
+    OX_Result r;
+
+    if ((r = ox_to_index(ctxt, arg, &size)) == OX_ERR)
+        return r;
+
+    ox_gc_set_start_size(ctxt, size);
+    return OX_OK;
+}
+
+/*OX.gc_growth getter.*/
+static OX_Result
+OX_gc_growth_get (OX_Context *ctxt, OX_Value *f, OX_Value *thiz, OX_Value *args, size_t argc, OX_Value *rv)
+{
+    ox_value_set_number(ctxt, rv, ox_gc_get_growth(ctxt));
+    return OX_OK;
+}
+
+/*OX.gc_growth setter.*/
+static OX_Result
+OX_gc_growth_set (OX_Context *ctxt, OX_Value *f, OX_Value *thiz, OX_Value *args, size_t argc, OX_Value *rv)
+{
+    OX_Value *arg = ox_argument(ctxt, args, argc, 0);
+    int32_t i;
+    OX_Result r;
+
+    if ((r = ox_to_int32(ctxt, arg, &i)) == OX_ERR)
+        return r;
+
+    if (i <= 100)
+        return ox_throw_range_error(ctxt, OX_TEXT("memory growth must be greater than 100"));
+
+    ox_gc_set_growth(ctxt, i);
+    return OX_OK;
+}
+
+/*OX.gc_slice_work getter.*/
+static OX_Result
+OX_gc_slice_work_get (OX_Context *ctxt, OX_Value *f, OX_Value *thiz, OX_Value *args, size_t argc, OX_Value *rv)
+{
+    ox_value_set_number(ctxt, rv, ox_gc_get_slice_work(ctxt));
+    return OX_OK;
+}
+
+/*OX.gc_slice_work setter.*/
+static OX_Result
+OX_gc_slice_work_set (OX_Context *ctxt, OX_Value *f, OX_Value *thiz, OX_Value *args, size_t argc, OX_Value *rv)
+{
+    OX_Value *arg = ox_argument(ctxt, args, argc, 0);
+    size_t n;
+    OX_Result r;
+
+    if ((r = ox_to_index(ctxt, arg, &n)) == OX_ERR)
+        return r;
+
+    if (n == 0)
+        return ox_throw_range_error(ctxt, OX_TEXT("marking slice must be greater than 0"));
+
+    ox_gc_set_slice_work(ctxt, n);
+    return OX_OK;
+}
+
+/*OX.gc_max_size getter.*/
+static OX_Result
+OX_gc_max_size_get (OX_Context *ctxt, OX_Value *f, OX_Value *thiz, OX_Value *args, size_t argc, OX_Value *rv)
+{
+    ox_value_set_number(ctxt, rv, ox_gc_get_max_size(ctxt));
+    return OX_OK;
+}
+
+/*OX.gc_max_size setter.*/
+static OX_Result
+OX_gc_max_size_set (OX_Context *ctxt, OX_Value *f, OX_Value *thiz, OX_Value *args, size_t argc, OX_Value *rv)
+{
+    OX_Value *arg = ox_argument(ctxt, args, argc, 0);
+    size_t size = 0;
+    OX_Result r;
+
+    if (!ox_value_is_null(ctxt, arg)) {
+        if ((r = ox_to_index(ctxt, arg, &size)) == OX_ERR)
+            return r;
+    }
+
+    ox_gc_set_max_size(ctxt, size);
+    return OX_OK;
+}
+
 /*Load this module.*/
 OX_Result
 ox_load (OX_Context *ctxt, OX_Value *s)
@@ -602,6 +729,14 @@ ox_load (OX_Context *ctxt, OX_Value *s)
  *? @return The abstract syntax tree object.
  *? @throw {SyntaxError} The script has syntax error.
  *?
+ *? @acc gc_start_size {Number} The memory size in bytes to start running the garbage collecter.
+ *? @acc gc_growth {Number} The next full garbage collection starts when the memory size
+ *? grows to this percent of the size after the last full collection. It must be greater than 100.
+ *? @acc gc_max_size {Number} The maximum heap size in bytes, 0 means no limit.
+ *? An allocation exceeding the maximum heap size throws a NoMemoryError.
+ *? @acc gc_slice_work {Number} The number of objects scanned in an incremental marking slice.
+ *? It must be greater than 0.
+ *?
  *? @const package_dirs {[String]} The package lookup directories array,
  *? @const install_dir {String} The OX installation directory.
  *? @const lib_dir {String} The OX libraries directory.
@@ -660,6 +795,18 @@ ox_exec (OX_Context *ctxt, OX_Value *f, OX_Value *s, OX_Value *args, size_t argc
     /*OX.install_dir.*/
     ox_not_error(ox_object_add_n_accessor_s(ctxt, o, "install_dir", OX_install_dir_get, NULL));
 
+    /*OX.gc_start_size.*/
+    ox_not_error(ox_object_add_n_accessor_s(ctxt, o, "gc_start_size", OX_gc_start_size_get, OX_gc_start_size_set));
+
+    /*OX.gc_growth.*/
+    ox_not_error(ox_object_add_n_accessor_s(ctxt, o, "gc_growth", OX_gc_growth_get, OX_gc_growth_set));
+
+    /*OX.gc_max_size.*/
+    ox_not_error(ox_object_add_n_accessor_s(ctxt, o, "gc_max_size", OX_gc_max_size_get, OX_gc_max_size_set));
+
+    /*OX.gc_slice_work.*/
+    ox_not_error(ox_object_add_n_accessor_s(ctxt, o, "gc_slice_work", OX_gc_slice_work_get, OX_gc_slice_work_set));
+
     /*OX.lib_dir.*/
     ox_not_error(ox_string_from_const_char_star(ctxt, v, ox_get_lib_dir(ctxt)));
     ox_not_error(ox_object_add_const_s(ctxt, o, "lib_dir", v));
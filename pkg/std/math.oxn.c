@@ -726,6 +726,7 @@ ox_exec (OX_Context *ctxt, OX_Value *f, OX_Value *s, OX_Value *args, size_t argc
 
     /*sqrt.*/
     ox_not_error(ox_named_native_func_new_s(ctxt, v, Math_sqrt, NULL, "sqrt"));
+    ox_native_func_set_intrinsic(ctxt, v, OX_INTRINSIC_MATH_SQRT);
     ox_not_error(ox_script_set_value(ctxt, s, ID_sqrt, v));
 
     /*cbrt.*/
@@ -754,6 +755,7 @@ ox_exec (OX_Context *ctxt, OX_Value *f, OX_Value *s, OX_Value *args, size_t argc
 
     /*floor.*/
     ox_not_error(ox_named_native_func_new_s(ctxt, v, Math_floor, NULL, "floor"));
+    ox_native_func_set_intrinsic(ctxt, v, OX_INTRINSIC_MATH_FLOOR);
     ox_not_error(ox_script_set_value(ctxt, s, ID_floor, v));
 
     /*ceil.*/
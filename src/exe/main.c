@@ -50,7 +50,12 @@ enum {
     OPTION_BC,
     OPTION_PR,
     OPTION_ENC,
-    OPTION_DUMP_THROW
+    OPTION_DUMP_THROW,
+    OPTION_NO_JIT,
+    OPTION_GC_START,
+    OPTION_GC_GROWTH,
+    OPTION_GC_MAX,
+    OPTION_GC_SLICE
 };
 
 /*Log file.*/
@@ -87,6 +92,16 @@ show_usage (char *cmd)
 "  -d DIR            Add package lookup directory\n"
 "  --dump-throw      Dump stack when throw an error\n"
 "  --enc ENCODING    Set the files' character encoding\n"
+"  --gc-growth PERCENT\n"
+"                    Start the full garbage collection when the memory size\n"
+"                    grows to PERCENT%% of the size after the last one,\n"
+"                    default is 133\n"
+"  --gc-max SIZE     Set the maximum heap size, default is no limit\n"
+"  --gc-slice NUM    Set the number of objects scanned in an incremental\n"
+"                    marking slice, default is 2048\n"
+"  --gc-start SIZE   Set the memory size to start running the garbage collecter,\n"
+"                    default is 64K\n"
+"                    SIZE is a number with an optional suffix K, M or G\n"
 "  --help            Show this help message\n"
 "  --log LEVEL       Set the log output level\n"
 "                    LEVEL should be any of the following values:\n"
@@ -110,6 +125,10 @@ show_usage (char *cmd)
 "                      L  line number\n"
 "                      i  thread id\n"
 "  --log-file FILE   Set the log filename\n"
+"  --no-jit          Disable the JIT compiler\n"
+"  -O[LEVEL]         Set the bytecode optimization level\n"
+"                    LEVEL should be 0 (no optimization) or 1,\n"
+"                    -O without LEVEL means 1, default is 0\n"
 "  -p                Only parses the source file, not compiling it\n"
 "  --pr              Print the result value\n"
 "  -r                Run the executable program managed by the package manager\n"
@@ -261,11 +280,83 @@ set_log_file (OX_Context *ctxt, char *optarg)
     return ox_log_set_file(ctxt, log_file);
 }
 
+/*Set the bytecode optimization level.*/
+static OX_Result
+set_opt_level (OX_Context *ctxt, char *optarg)
+{
+    int level = 1;
+
+    if (optarg) {
+        char *end;
+
+        level = strtol(optarg, &end, 10);
+        if ((*end != 0) || (level < 0)) {
+            fprintf(stderr, OX_TEXT("illegal optimization level \"%s\"\n"), optarg);
+            return OX_ERR;
+        }
+    }
+
+    return ox_set_opt_level(ctxt, level);
+}
+
+/*Set the memory size parameter of the garbage collecter.*/
+static OX_Result
+set_gc_size (OX_Context *ctxt, int opt, char *optarg)
+{
+    size_t size;
+
+    if (ox_gc_parse_size(optarg, &size) == OX_ERR) {
+        fprintf(stderr, OX_TEXT("illegal memory size \"%s\"\n"), optarg);
+        return OX_ERR;
+    }
+
+    if (opt == OPTION_GC_START)
+        ox_gc_set_start_size(ctxt, size);
+    else
+        ox_gc_set_max_size(ctxt, size);
+
+    return OX_OK;
+}
+
+/*Set the memory growth to start the full collection.*/
+static OX_Result
+set_gc_growth (OX_Context *ctxt, char *optarg)
+{
+    char *end;
+    long percent;
+
+    percent = strtol(optarg, &end, 10);
+    if ((*end != 0) || (percent <= 100) || (percent > INT_MAX)) {
+        fprintf(stderr, OX_TEXT("illegal memory growth \"%s\"\n"), optarg);
+        return OX_ERR;
+    }
+
+    ox_gc_set_growth(ctxt, percent);
+    return OX_OK;
+}
+
+/*Set the number of objects scanned in a marking slice.*/
+static OX_Result
+set_gc_slice (OX_Context *ctxt, char *optarg)
+{
+    char *end;
+    long n;
+
+    n = strtol(optarg, &end, 10);
+    if ((*end != 0) || (n <= 0)) {
+        fprintf(stderr, OX_TEXT("illegal marking slice \"%s\"\n"), optarg);
+        return OX_ERR;
+    }
+
+    ox_gc_set_slice_work(ctxt, n);
+    return OX_OK;
+}
+
 /*Parse options.*/
 static OX_Result
 parse_options (OX_Context *ctxt, int argc, char **argv)
 {
-    const char *short_opts = "+s:pcd:r";
+    const char *short_opts = "+s:pcd:rO::";
     static const struct option long_opts[] = {
         {"ast",       no_argument,       0, OPTION_AST},
         {"bc",        no_argument,       0, OPTION_BC},
@@ -276,6 +367,11 @@ parse_options (OX_Context *ctxt, int argc, char **argv)
         {"log",       required_argument, 0, OPTION_LOG},
         {"log-field", required_argument, 0, OPTION_LOG_FIELD},
         {"log-file",  required_argument, 0, OPTION_LOG_FILE},
+        {"no-jit",    no_argument,       0, OPTION_NO_JIT},
+        {"gc-start",  required_argument, 0, OPTION_GC_START},
+        {"gc-growth", required_argument, 0, OPTION_GC_GROWTH},
+        {"gc-max",    required_argument, 0, OPTION_GC_MAX},
+        {"gc-slice",  required_argument, 0, OPTION_GC_SLICE},
         {0,           0,                 0, 0}
     };
     OX_Bool need_file = OX_TRUE;
@@ -307,6 +403,10 @@ parse_options (OX_Context *ctxt, int argc, char **argv)
         case 'r':
             run_pm_exe = OX_TRUE;
             break;
+        case 'O':
+            if ((r = set_opt_level(ctxt, optarg)) == OX_ERR)
+                return r;
+            break;
         case OPTION_AST:
             output_ast = OX_TRUE;
             break;
@@ -316,6 +416,9 @@ parse_options (OX_Context *ctxt, int argc, char **argv)
         case OPTION_DUMP_THROW:
             ox_set_dump_throw(ctxt, OX_TRUE);
             break;
+        case OPTION_NO_JIT:
+            ox_set_jit(ctxt, OX_FALSE);
+            break;
         case OPTION_ENC:
             if ((r = ox_set_file_enc(ctxt, optarg)) == OX_ERR)
                 return r;
@@ -343,6 +446,19 @@ parse_options (OX_Context *ctxt, int argc, char **argv)
             if ((r = set_log_file(ctxt, optarg)) == OX_ERR)
                 return r;
             break;
+        case OPTION_GC_START:
+        case OPTION_GC_MAX:
+            if ((r = set_gc_size(ctxt, c, optarg)) == OX_ERR)
+                return r;
+            break;
+        case OPTION_GC_GROWTH:
+            if ((r = set_gc_growth(ctxt, optarg)) == OX_ERR)
+                return r;
+            break;
+        case OPTION_GC_SLICE:
+            if ((r = set_gc_slice(ctxt, optarg)) == OX_ERR)
+                return r;
+            break;
         default:
             return OX_ERR;
         }
@@ -570,6 +686,9 @@ end:
     if (rc) {
         OX_VS_PUSH_2(ctxt, err, s)
 
+        /*The error may be caused by the maximum heap size, remove the limit to output it.*/
+        ox_gc_set_max_size(ctxt, 0);
+
         ox_catch(ctxt, err);
 
         if (!ox_value_is_null(ctxt, err)) {
@@ -321,6 +321,7 @@ ox_array_set_item (OX_Context *ctxt, OX_Value *a, size_t id, OX_Value *iv)
             return r;
     }
 
+    ox_gc_write_barrier(ctxt, ap);
     ox_value_copy(ctxt, &ox_vector_item(&ap->items, id), iv);
     return OX_OK;
 }
@@ -349,6 +350,7 @@ ox_array_set_items (OX_Context *ctxt, OX_Value *a, size_t id, OX_Value *iv, size
     if ((r = ox_array_set_length(ctxt, a, id + n)) == OX_ERR)
         return r;
 
+    ox_gc_write_barrier(ctxt, ap);
     ox_values_copy(ctxt, ap->items.items + id, iv, n);
     return OX_OK;
 }
@@ -377,6 +379,7 @@ ox_array_append (OX_Context *ctxt, OX_Value *a, OX_Value *iv)
     if ((r = ox_array_set_length(ctxt, a, len + 1)) == OX_ERR)
         return r;
 
+    ox_gc_write_barrier(ctxt, ap);
     ox_value_copy(ctxt, &ox_vector_item(&ap->items, len), iv);
     return OX_OK;
 }
@@ -630,6 +633,38 @@ Array_inf_iter (OX_Context *ctxt, OX_Value *f, OX_Value *thiz, OX_Value *args, s
     return array_iter_new(ctxt, rv, thiz);
 }
 
+/*Fast iteration step of the array.*/
+static OX_Result
+array_iter_step (OX_Context *ctxt, OX_Value *a, size_t *pos, OX_Value *v)
+{
+    OX_Array *ap = ox_value_get_gco(ctxt, a);
+
+    if (*pos >= ox_vector_length(&ap->items))
+        return OX_FALSE;
+
+    ox_value_copy(ctxt, v, &ox_vector_item(&ap->items, *pos));
+    (*pos) ++;
+
+    return OX_TRUE;
+}
+
+/**
+ * Get the fast iteration step function of the array.
+ * @param ctxt The current running context.
+ * @param v The value to be iterated.
+ * @param cf The "$iter" method of the value.
+ * @return The step function.
+ * @retval NULL The value is not an array or cf is not the array's "$iter" method.
+ */
+OX_IterStepFunc
+ox_array_iter_step_get (OX_Context *ctxt, OX_Value *v, OX_CFunc cf)
+{
+    if ((cf != Array_inf_iter) || !ox_value_is_array(ctxt, v))
+        return NULL;
+
+    return array_iter_step;
+}
+
 /*Array.$inf.insert*/
 static OX_Result
 Array_inf_insert (OX_Context *ctxt, OX_Value *f, OX_Value *thiz, OX_Value *args, size_t argc, OX_Value *rv)
@@ -679,6 +714,7 @@ Array_inf_insert (OX_Context *ctxt, OX_Value *f, OX_Value *thiz, OX_Value *args,
             memmove(a->items.items + pos + add, a->items.items + pos, sizeof(OX_Value) * left);
 
         src = ox_values_item(ctxt, args, 1);
+        ox_gc_write_barrier(ctxt, a);
         ox_values_copy(ctxt, a->items.items + pos, src, add);
     }
 
@@ -1234,6 +1270,10 @@ ox_array_class_init (OX_Context *ctxt)
             Array_inf_to_str));
     ox_not_error(ox_object_add_n_method_s(ctxt, OX_OBJECT(ctxt, Array_inf), "push",
             Array_inf_push));
+    ox_not_error(ox_object_set_intrinsic_s(ctxt, OX_OBJECT(ctxt, Array_inf), "length",
+            OX_INTRINSIC_ARRAY_LENGTH));
+    ox_not_error(ox_object_set_intrinsic_s(ctxt, OX_OBJECT(ctxt, Array_inf), "push",
+            OX_INTRINSIC_ARRAY_PUSH));
     ox_not_error(ox_object_add_n_method_s(ctxt, OX_OBJECT(ctxt, Array_inf), "pop",
             Array_inf_pop));
     ox_not_error(ox_object_add_n_method_s(ctxt, OX_OBJECT(ctxt, Array_inf), "$iter",
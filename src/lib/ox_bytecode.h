@@ -32,6 +32,29 @@ typedef enum {
     OX_BC_and,
     OX_BC_xor,
     OX_BC_or,
+    OX_BC_add_n,
+    OX_BC_sub_n,
+    OX_BC_mul_n,
+    OX_BC_lt_n,
+    OX_BC_gt_n,
+    OX_BC_le_n,
+    OX_BC_ge_n,
+    OX_BC_eq_n,
+    OX_BC_ne_n,
+    OX_BC_get_t_nn,
+    OX_BC_get_p_c,
+    OX_BC_lt_jf,
+    OX_BC_gt_jf,
+    OX_BC_le_jf,
+    OX_BC_ge_jf,
+    OX_BC_eq_jf,
+    OX_BC_ne_jf,
+    OX_BC_call0,
+    OX_BC_call1,
+    OX_BC_call2,
+    OX_BC_call3,
+    OX_BC_p_get_t,
+    OX_BC_get_a_t,
     OX_BC_load_null,
     OX_BC_load_true,
     OX_BC_load_false,
@@ -48,6 +71,13 @@ typedef enum {
     OX_BC_get_t_b,
     OX_BC_set_t_b,
     OX_BC_set_t_b_ac,
+    OX_BC_cell_t,
+    OX_BC_get_t_c,
+    OX_BC_set_t_c,
+    OX_BC_set_t_c_ac,
+    OX_BC_get_cap,
+    OX_BC_set_cap,
+    OX_BC_set_cap_ac,
     OX_BC_get_n,
     OX_BC_get_g,
     OX_BC_get_r,
@@ -72,10 +102,8 @@ typedef enum {
     OX_BC_arg_spread,
     OX_BC_call_end,
     OX_BC_call_end_tail,
-    OX_BC_try_start,
     OX_BC_try_end,
     OX_BC_catch,
-    OX_BC_catch_end,
     OX_BC_finally,
     OX_BC_sched,
     OX_BC_sched_start,
@@ -134,6 +162,14 @@ typedef enum {
     OX_BC_MODEL_d,
     OX_BC_MODEL_ss,
     OX_BC_MODEL_ssd,
+    OX_BC_MODEL_icd,
+    OX_BC_MODEL_scdC,
+    OX_BC_MODEL_ssl,
+    OX_BC_MODEL_sssd,
+    OX_BC_MODEL_ssssd,
+    OX_BC_MODEL_sssssd,
+    OX_BC_MODEL_i,
+    OX_BC_MODEL_ii,
     OX_BC_MODEL_od,
     OX_BC_MODEL_cd,
     OX_BC_MODEL_pd,
@@ -143,14 +179,16 @@ typedef enum {
     OX_BC_MODEL_is,
     OX_BC_MODEL_oid,
     OX_BC_MODEL_ois,
-    OX_BC_MODEL_sss,
+    OX_BC_MODEL_cdC,
+    OX_BC_MODEL_ssdC,
+    OX_BC_MODEL_sssC,
     OX_BC_MODEL_l,
     OX_BC_MODEL_ol,
     OX_BC_MODEL_sl,
-    OX_BC_MODEL_ll,
     OX_BC_MODEL_noarg,
     OX_BC_MODEL_dl,
     OX_BC_MODEL_dd,
+    OX_BC_MODEL_sss,
     OX_BC_MODEL_ssss,
     OX_BC_MODEL_c,
     OX_BC_MODEL_ps
@@ -193,6 +231,58 @@ typedef union {
         int s1;
         int d2;
     } ssd;
+    struct {
+        OX_GenCommand g;
+        int i0;
+        int c1;
+        int d2;
+    } icd;
+    struct {
+        OX_GenCommand g;
+        int s0;
+        int c1;
+        int d2;
+        int C3;
+    } scdC;
+    struct {
+        OX_GenCommand g;
+        int s0;
+        int s1;
+        int l2;
+    } ssl;
+    struct {
+        OX_GenCommand g;
+        int s0;
+        int s1;
+        int s2;
+        int d3;
+    } sssd;
+    struct {
+        OX_GenCommand g;
+        int s0;
+        int s1;
+        int s2;
+        int s3;
+        int d4;
+    } ssssd;
+    struct {
+        OX_GenCommand g;
+        int s0;
+        int s1;
+        int s2;
+        int s3;
+        int s4;
+        int d5;
+    } sssssd;
+    struct {
+        OX_GenCommand g;
+        int i0;
+    } i;
+    struct {
+        OX_GenCommand g;
+        int i0;
+        int i1;
+    } ii;
     struct {
         OX_GenCommand g;
         int o0;
@@ -240,12 +330,26 @@ typedef union {
         int i1;
         int s2;
     } ois;
+    struct {
+        OX_GenCommand g;
+        int c0;
+        int d1;
+        int C2;
+    } cdC;
+    struct {
+        OX_GenCommand g;
+        int s0;
+        int s1;
+        int d2;
+        int C3;
+    } ssdC;
     struct {
         OX_GenCommand g;
         int s0;
         int s1;
         int s2;
-    } sss;
+        int C3;
+    } sssC;
     struct {
         OX_GenCommand g;
         int l0;
@@ -260,11 +364,6 @@ typedef union {
         int s0;
         int l1;
     } sl;
-    struct {
-        OX_GenCommand g;
-        int l0;
-        int l1;
-    } ll;
 
     struct {
         OX_GenCommand g;
@@ -276,6 +375,12 @@ typedef union {
         int d0;
         int d1;
     } dd;
+    struct {
+        OX_GenCommand g;
+        int s0;
+        int s1;
+        int s2;
+    } sss;
     struct {
         OX_GenCommand g;
         int s0;
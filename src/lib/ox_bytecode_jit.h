@@ -0,0 +1,154 @@
+    {(OX_JitFunc)do_dup, "sd", 0},
+    {(OX_JitFunc)do_not, "sd", 0},
+    {(OX_JitFunc)do_to_num, "sd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_rev, "sd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_neg, "sd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_typeof, "sd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_not_null, "sd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_global, "s", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_owned, "cs", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_curr, "d", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_get_ptr, "sd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_get_value, "sd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_set_value, "ss", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_add, "ssd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_sub, "ssd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_match, "ssd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_exp, "ssd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_mul, "ssd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_div, "ssd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_mod, "ssd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_shl, "ssd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_shr, "ssd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_ushr, "ssd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_lt, "ssd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_gt, "ssd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_le, "ssd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_ge, "ssd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_instof, "ssd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_eq, "ssd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_ne, "ssd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_and, "ssd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_xor, "ssd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_or, "ssd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_add_n, "ssd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_sub_n, "ssd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_mul_n, "ssd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_lt_n, "ssd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_gt_n, "ssd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_le_n, "ssd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_ge_n, "ssd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_eq_n, "ssd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_ne_n, "ssd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_get_t_nn, "icd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_get_p_c, "scdC", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_lt_jf, "ssl", OX_JIT_FL_SAVE_IP|OX_JIT_FL_BRANCH},
+    {(OX_JitFunc)do_gt_jf, "ssl", OX_JIT_FL_SAVE_IP|OX_JIT_FL_BRANCH},
+    {(OX_JitFunc)do_le_jf, "ssl", OX_JIT_FL_SAVE_IP|OX_JIT_FL_BRANCH},
+    {(OX_JitFunc)do_ge_jf, "ssl", OX_JIT_FL_SAVE_IP|OX_JIT_FL_BRANCH},
+    {(OX_JitFunc)do_eq_jf, "ssl", OX_JIT_FL_SAVE_IP|OX_JIT_FL_BRANCH},
+    {(OX_JitFunc)do_ne_jf, "ssl", OX_JIT_FL_SAVE_IP|OX_JIT_FL_BRANCH},
+    {(OX_JitFunc)do_call0, "ssd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_call1, "sssd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_call2, "ssssd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_call3, "sssssd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_p_get_t, "i", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_get_a_t, "ii", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_load_null, "d", 0},
+    {(OX_JitFunc)do_load_true, "d", 0},
+    {(OX_JitFunc)do_load_false, "d", 0},
+    {(OX_JitFunc)do_this, "d", 0},
+    {(OX_JitFunc)do_this_b, "od", 0},
+    {(OX_JitFunc)do_argv, "d", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_get_cv, "cd", 0},
+    {(OX_JitFunc)do_get_pp, "pd", 0},
+    {(OX_JitFunc)do_get_lt, "td", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_get_ltt, "Td", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_get_t, "id", 0},
+    {(OX_JitFunc)do_set_t, "is", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_set_t_ac, "is", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_get_t_b, "oid", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_set_t_b, "ois", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_set_t_b_ac, "ois", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_cell_t, "i", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_get_t_c, "id", 0},
+    {(OX_JitFunc)do_set_t_c, "is", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_set_t_c_ac, "is", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_get_cap, "id", 0},
+    {(OX_JitFunc)do_set_cap, "is", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_set_cap_ac, "is", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_get_n, "cdC", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_get_g, "cdC", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_get_r, "id", 0},
+    {(OX_JitFunc)do_get_p, "ssdC", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_lookup_p, "ssdC", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_set_p, "sssC", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_get_a, "id", 0},
+    {(OX_JitFunc)do_throw, "s", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_ret, "s", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_jmp, "l", OX_JIT_FL_BRANCH},
+    {(OX_JitFunc)do_deep_jmp, "ol", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_jt, "sl", OX_JIT_FL_BRANCH},
+    {(OX_JitFunc)do_jf, "sl", OX_JIT_FL_BRANCH},
+    {(OX_JitFunc)do_jnn, "sl", OX_JIT_FL_BRANCH},
+    {(OX_JitFunc)do_str_start, "s", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_str_start_t, "ss", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_str_item, "s", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_str_item_f, "cs", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_str_end, "d", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_call_start, "ss", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_arg, "s", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_arg_spread, "s", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_call_end, "d", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_call_end_tail, "d", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_try_end, "l", 0},
+    {(OX_JitFunc)do_catch, "d", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_finally, "", OX_JIT_FL_SAVE_IP},
+    {NULL, "", 0},
+    {NULL, "", 0},
+    {NULL, "", 0},
+    {(OX_JitFunc)do_s_pop, "", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_iter_start, "s", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_iter_step, "dl", OX_JIT_FL_SAVE_IP|OX_JIT_FL_BRANCH},
+    {(OX_JitFunc)do_apat_start, "s", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_apat_next, "", 0},
+    {(OX_JitFunc)do_apat_get, "d", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_apat_rest, "d", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_opat_start, "s", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_opat_get, "sd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_opat_rest, "d", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_a_new, "d", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_a_start, "s", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_a_next, "", 0},
+    {(OX_JitFunc)do_a_item, "s", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_a_spread, "s", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_a_end, "", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_o_new, "d", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_o_start, "s", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_o_prop, "ss", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_o_spread, "s", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_p_start, "", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_p_get, "d", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_p_rest, "d", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_f_new, "id", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_c_new, "dd", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_c_parent, "ss", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_c_const, "sss", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_c_var, "sss", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_c_acce, "ssss", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_c_ro_acce, "sss", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_e_start, "s", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_e_start_n, "cs", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_e_item, "c", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_b_start, "s", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_b_start_n, "cs", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_b_item, "c", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_set_name, "ss", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_set_name_g, "ss", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_set_name_s, "ss", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_set_scope, "ss", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_name_nn, "cs", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_prop_nn, "cs", OX_JIT_FL_SAVE_IP},
+    {(OX_JitFunc)do_pprop_nn, "ps", OX_JIT_FL_SAVE_IP},
+    {NULL, "", 0},
+    {(OX_JitFunc)do_nop, "", 0}
@@ -0,0 +1,154 @@
+    &&bc_label_dup,
+    &&bc_label_not,
+    &&bc_label_to_num,
+    &&bc_label_rev,
+    &&bc_label_neg,
+    &&bc_label_typeof,
+    &&bc_label_not_null,
+    &&bc_label_global,
+    &&bc_label_owned,
+    &&bc_label_curr,
+    &&bc_label_get_ptr,
+    &&bc_label_get_value,
+    &&bc_label_set_value,
+    &&bc_label_add,
+    &&bc_label_sub,
+    &&bc_label_match,
+    &&bc_label_exp,
+    &&bc_label_mul,
+    &&bc_label_div,
+    &&bc_label_mod,
+    &&bc_label_shl,
+    &&bc_label_shr,
+    &&bc_label_ushr,
+    &&bc_label_lt,
+    &&bc_label_gt,
+    &&bc_label_le,
+    &&bc_label_ge,
+    &&bc_label_instof,
+    &&bc_label_eq,
+    &&bc_label_ne,
+    &&bc_label_and,
+    &&bc_label_xor,
+    &&bc_label_or,
+    &&bc_label_add_n,
+    &&bc_label_sub_n,
+    &&bc_label_mul_n,
+    &&bc_label_lt_n,
+    &&bc_label_gt_n,
+    &&bc_label_le_n,
+    &&bc_label_ge_n,
+    &&bc_label_eq_n,
+    &&bc_label_ne_n,
+    &&bc_label_get_t_nn,
+    &&bc_label_get_p_c,
+    &&bc_label_lt_jf,
+    &&bc_label_gt_jf,
+    &&bc_label_le_jf,
+    &&bc_label_ge_jf,
+    &&bc_label_eq_jf,
+    &&bc_label_ne_jf,
+    &&bc_label_call0,
+    &&bc_label_call1,
+    &&bc_label_call2,
+    &&bc_label_call3,
+    &&bc_label_p_get_t,
+    &&bc_label_get_a_t,
+    &&bc_label_load_null,
+    &&bc_label_load_true,
+    &&bc_label_load_false,
+    &&bc_label_this,
+    &&bc_label_this_b,
+    &&bc_label_argv,
+    &&bc_label_get_cv,
+    &&bc_label_get_pp,
+    &&bc_label_get_lt,
+    &&bc_label_get_ltt,
+    &&bc_label_get_t,
+    &&bc_label_set_t,
+    &&bc_label_set_t_ac,
+    &&bc_label_get_t_b,
+    &&bc_label_set_t_b,
+    &&bc_label_set_t_b_ac,
+    &&bc_label_cell_t,
+    &&bc_label_get_t_c,
+    &&bc_label_set_t_c,
+    &&bc_label_set_t_c_ac,
+    &&bc_label_get_cap,
+    &&bc_label_set_cap,
+    &&bc_label_set_cap_ac,
+    &&bc_label_get_n,
+    &&bc_label_get_g,
+    &&bc_label_get_r,
+    &&bc_label_get_p,
+    &&bc_label_lookup_p,
+    &&bc_label_set_p,
+    &&bc_label_get_a,
+    &&bc_label_throw,
+    &&bc_label_ret,
+    &&bc_label_jmp,
+    &&bc_label_deep_jmp,
+    &&bc_label_jt,
+    &&bc_label_jf,
+    &&bc_label_jnn,
+    &&bc_label_str_start,
+    &&bc_label_str_start_t,
+    &&bc_label_str_item,
+    &&bc_label_str_item_f,
+    &&bc_label_str_end,
+    &&bc_label_call_start,
+    &&bc_label_arg,
+    &&bc_label_arg_spread,
+    &&bc_label_call_end,
+    &&bc_label_call_end_tail,
+    &&bc_label_try_end,
+    &&bc_label_catch,
+    &&bc_label_finally,
+    &&bc_label_sched,
+    &&bc_label_sched_start,
+    &&bc_label_yield,
+    &&bc_label_s_pop,
+    &&bc_label_iter_start,
+    &&bc_label_iter_step,
+    &&bc_label_apat_start,
+    &&bc_label_apat_next,
+    &&bc_label_apat_get,
+    &&bc_label_apat_rest,
+    &&bc_label_opat_start,
+    &&bc_label_opat_get,
+    &&bc_label_opat_rest,
+    &&bc_label_a_new,
+    &&bc_label_a_start,
+    &&bc_label_a_next,
+    &&bc_label_a_item,
+    &&bc_label_a_spread,
+    &&bc_label_a_end,
+    &&bc_label_o_new,
+    &&bc_label_o_start,
+    &&bc_label_o_prop,
+    &&bc_label_o_spread,
+    &&bc_label_p_start,
+    &&bc_label_p_get,
+    &&bc_label_p_rest,
+    &&bc_label_f_new,
+    &&bc_label_c_new,
+    &&bc_label_c_parent,
+    &&bc_label_c_const,
+    &&bc_label_c_var,
+    &&bc_label_c_acce,
+    &&bc_label_c_ro_acce,
+    &&bc_label_e_start,
+    &&bc_label_e_start_n,
+    &&bc_label_e_item,
+    &&bc_label_b_start,
+    &&bc_label_b_start_n,
+    &&bc_label_b_item,
+    &&bc_label_set_name,
+    &&bc_label_set_name_g,
+    &&bc_label_set_name_s,
+    &&bc_label_set_scope,
+    &&bc_label_name_nn,
+    &&bc_label_prop_nn,
+    &&bc_label_pprop_nn,
+    &&bc_label_invalid,
+    &&bc_label_nop
@@ -1,1371 +1,1234 @@
-    case OX_BC_dup: {
+    OX_BC_CASE(dup) {
         uint8_t s0;
         uint8_t d1;
         s0 = bc[1];
         d1 = bc[2];
         r = do_dup(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, d1));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 3;
-        break;
+        OX_BC_NEXT(3);
     }
-    case OX_BC_not: {
+    OX_BC_CASE(not) {
         uint8_t s0;
         uint8_t d1;
         s0 = bc[1];
         d1 = bc[2];
         r = do_not(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, d1));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 3;
-        break;
+        OX_BC_NEXT(3);
     }
-    case OX_BC_to_num: {
+    OX_BC_CASE(to_num) {
         uint8_t s0;
         uint8_t d1;
         s0 = bc[1];
         d1 = bc[2];
+        OX_BC_SAVE_IP();
         r = do_to_num(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, d1));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 3;
-        break;
+        OX_BC_NEXT(3);
     }
-    case OX_BC_rev: {
+    OX_BC_CASE(rev) {
         uint8_t s0;
         uint8_t d1;
         s0 = bc[1];
         d1 = bc[2];
+        OX_BC_SAVE_IP();
         r = do_rev(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, d1));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 3;
-        break;
+        OX_BC_NEXT(3);
     }
-    case OX_BC_neg: {
+    OX_BC_CASE(neg) {
         uint8_t s0;
         uint8_t d1;
         s0 = bc[1];
         d1 = bc[2];
+        OX_BC_SAVE_IP();
         r = do_neg(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, d1));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 3;
-        break;
+        OX_BC_NEXT(3);
     }
-    case OX_BC_typeof: {
+    OX_BC_CASE(typeof) {
         uint8_t s0;
         uint8_t d1;
         s0 = bc[1];
         d1 = bc[2];
+        OX_BC_SAVE_IP();
         r = do_typeof(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, d1));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 3;
-        break;
+        OX_BC_NEXT(3);
     }
-    case OX_BC_not_null: {
+    OX_BC_CASE(not_null) {
         uint8_t s0;
         uint8_t d1;
         s0 = bc[1];
         d1 = bc[2];
+        OX_BC_SAVE_IP();
         r = do_not_null(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, d1));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 3;
-        break;
+        OX_BC_NEXT(3);
     }
-    case OX_BC_global: {
+    OX_BC_CASE(global) {
         uint8_t s0;
         s0 = bc[1];
+        OX_BC_SAVE_IP();
         r = do_global(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 2;
-        break;
-    }
-    case OX_BC_owned: {
+        OX_BC_NEXT(2);
+    }
+    OX_BC_CASE(owned) {
         uint16_t c0;
         uint8_t s1;
         c0 = bc[1] << 8 | bc[2];
         s1 = bc[3];
+        OX_BC_SAVE_IP();
         r = do_owned(ctxt, &rs, &rs.s->cvs[c0], ox_values_item(ctxt, rs.regs, s1));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
-    }
-    case OX_BC_curr: {
+        OX_BC_NEXT(4);
+    }
+    OX_BC_CASE(curr) {
         uint8_t d0;
         d0 = bc[1];
+        OX_BC_SAVE_IP();
         r = do_curr(ctxt, &rs, ox_values_item(ctxt, rs.regs, d0));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 2;
-        break;
+        OX_BC_NEXT(2);
     }
-    case OX_BC_get_ptr: {
+    OX_BC_CASE(get_ptr) {
         uint8_t s0;
         uint8_t d1;
         s0 = bc[1];
         d1 = bc[2];
+        OX_BC_SAVE_IP();
         r = do_get_ptr(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, d1));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 3;
-        break;
+        OX_BC_NEXT(3);
     }
-    case OX_BC_get_value: {
+    OX_BC_CASE(get_value) {
         uint8_t s0;
         uint8_t d1;
         s0 = bc[1];
         d1 = bc[2];
+        OX_BC_SAVE_IP();
         r = do_get_value(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, d1));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 3;
-        break;
+        OX_BC_NEXT(3);
     }
-    case OX_BC_set_value: {
+    OX_BC_CASE(set_value) {
         uint8_t s0;
         uint8_t s1;
         s0 = bc[1];
         s1 = bc[2];
+        OX_BC_SAVE_IP();
         r = do_set_value(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 3;
-        break;
+        OX_BC_NEXT(3);
     }
-    case OX_BC_add: {
+    OX_BC_CASE(add) {
         uint8_t s0;
         uint8_t s1;
         uint8_t d2;
         s0 = bc[1];
         s1 = bc[2];
         d2 = bc[3];
+        OX_BC_SAVE_IP();
         r = do_add(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, d2));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
+        OX_BC_NEXT(4);
     }
-    case OX_BC_sub: {
+    OX_BC_CASE(sub) {
         uint8_t s0;
         uint8_t s1;
         uint8_t d2;
         s0 = bc[1];
         s1 = bc[2];
         d2 = bc[3];
+        OX_BC_SAVE_IP();
         r = do_sub(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, d2));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
+        OX_BC_NEXT(4);
     }
-    case OX_BC_match: {
+    OX_BC_CASE(match) {
         uint8_t s0;
         uint8_t s1;
         uint8_t d2;
         s0 = bc[1];
         s1 = bc[2];
         d2 = bc[3];
+        OX_BC_SAVE_IP();
         r = do_match(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, d2));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
+        OX_BC_NEXT(4);
     }
-    case OX_BC_exp: {
+    OX_BC_CASE(exp) {
         uint8_t s0;
         uint8_t s1;
         uint8_t d2;
         s0 = bc[1];
         s1 = bc[2];
         d2 = bc[3];
+        OX_BC_SAVE_IP();
         r = do_exp(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, d2));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
+        OX_BC_NEXT(4);
     }
-    case OX_BC_mul: {
+    OX_BC_CASE(mul) {
         uint8_t s0;
         uint8_t s1;
         uint8_t d2;
         s0 = bc[1];
         s1 = bc[2];
         d2 = bc[3];
+        OX_BC_SAVE_IP();
         r = do_mul(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, d2));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
+        OX_BC_NEXT(4);
     }
-    case OX_BC_div: {
+    OX_BC_CASE(div) {
         uint8_t s0;
         uint8_t s1;
         uint8_t d2;
         s0 = bc[1];
         s1 = bc[2];
         d2 = bc[3];
+        OX_BC_SAVE_IP();
         r = do_div(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, d2));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
+        OX_BC_NEXT(4);
     }
-    case OX_BC_mod: {
+    OX_BC_CASE(mod) {
         uint8_t s0;
         uint8_t s1;
         uint8_t d2;
         s0 = bc[1];
         s1 = bc[2];
         d2 = bc[3];
+        OX_BC_SAVE_IP();
         r = do_mod(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, d2));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
+        OX_BC_NEXT(4);
     }
-    case OX_BC_shl: {
+    OX_BC_CASE(shl) {
         uint8_t s0;
         uint8_t s1;
         uint8_t d2;
         s0 = bc[1];
         s1 = bc[2];
         d2 = bc[3];
+        OX_BC_SAVE_IP();
         r = do_shl(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, d2));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
+        OX_BC_NEXT(4);
     }
-    case OX_BC_shr: {
+    OX_BC_CASE(shr) {
         uint8_t s0;
         uint8_t s1;
         uint8_t d2;
         s0 = bc[1];
         s1 = bc[2];
         d2 = bc[3];
+        OX_BC_SAVE_IP();
         r = do_shr(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, d2));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
+        OX_BC_NEXT(4);
     }
-    case OX_BC_ushr: {
+    OX_BC_CASE(ushr) {
         uint8_t s0;
         uint8_t s1;
         uint8_t d2;
         s0 = bc[1];
         s1 = bc[2];
         d2 = bc[3];
+        OX_BC_SAVE_IP();
         r = do_ushr(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, d2));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
+        OX_BC_NEXT(4);
     }
-    case OX_BC_lt: {
+    OX_BC_CASE(lt) {
         uint8_t s0;
         uint8_t s1;
         uint8_t d2;
         s0 = bc[1];
         s1 = bc[2];
         d2 = bc[3];
+        OX_BC_SAVE_IP();
         r = do_lt(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, d2));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
+        OX_BC_NEXT(4);
     }
-    case OX_BC_gt: {
+    OX_BC_CASE(gt) {
         uint8_t s0;
         uint8_t s1;
         uint8_t d2;
         s0 = bc[1];
         s1 = bc[2];
         d2 = bc[3];
+        OX_BC_SAVE_IP();
         r = do_gt(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, d2));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
+        OX_BC_NEXT(4);
     }
-    case OX_BC_le: {
+    OX_BC_CASE(le) {
         uint8_t s0;
         uint8_t s1;
         uint8_t d2;
         s0 = bc[1];
         s1 = bc[2];
         d2 = bc[3];
+        OX_BC_SAVE_IP();
         r = do_le(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, d2));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
+        OX_BC_NEXT(4);
     }
-    case OX_BC_ge: {
+    OX_BC_CASE(ge) {
         uint8_t s0;
         uint8_t s1;
         uint8_t d2;
         s0 = bc[1];
         s1 = bc[2];
         d2 = bc[3];
+        OX_BC_SAVE_IP();
         r = do_ge(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, d2));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
+        OX_BC_NEXT(4);
     }
-    case OX_BC_instof: {
+    OX_BC_CASE(instof) {
         uint8_t s0;
         uint8_t s1;
         uint8_t d2;
         s0 = bc[1];
         s1 = bc[2];
         d2 = bc[3];
+        OX_BC_SAVE_IP();
         r = do_instof(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, d2));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
+        OX_BC_NEXT(4);
     }
-    case OX_BC_eq: {
+    OX_BC_CASE(eq) {
         uint8_t s0;
         uint8_t s1;
         uint8_t d2;
         s0 = bc[1];
         s1 = bc[2];
         d2 = bc[3];
+        OX_BC_SAVE_IP();
         r = do_eq(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, d2));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
+        OX_BC_NEXT(4);
     }
-    case OX_BC_ne: {
+    OX_BC_CASE(ne) {
         uint8_t s0;
         uint8_t s1;
         uint8_t d2;
         s0 = bc[1];
         s1 = bc[2];
         d2 = bc[3];
+        OX_BC_SAVE_IP();
         r = do_ne(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, d2));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
+        OX_BC_NEXT(4);
     }
-    case OX_BC_and: {
+    OX_BC_CASE(and) {
         uint8_t s0;
         uint8_t s1;
         uint8_t d2;
         s0 = bc[1];
         s1 = bc[2];
         d2 = bc[3];
+        OX_BC_SAVE_IP();
         r = do_and(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, d2));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
+        OX_BC_NEXT(4);
     }
-    case OX_BC_xor: {
+    OX_BC_CASE(xor) {
         uint8_t s0;
         uint8_t s1;
         uint8_t d2;
         s0 = bc[1];
         s1 = bc[2];
         d2 = bc[3];
+        OX_BC_SAVE_IP();
         r = do_xor(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, d2));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
+        OX_BC_NEXT(4);
     }
-    case OX_BC_or: {
+    OX_BC_CASE(or) {
         uint8_t s0;
         uint8_t s1;
         uint8_t d2;
         s0 = bc[1];
         s1 = bc[2];
         d2 = bc[3];
+        OX_BC_SAVE_IP();
         r = do_or(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, d2));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
-    }
-    case OX_BC_load_null: {
+        OX_BC_NEXT(4);
+    }
+    OX_BC_CASE(add_n) {
+        uint8_t s0;
+        uint8_t s1;
+        uint8_t d2;
+        s0 = bc[1];
+        s1 = bc[2];
+        d2 = bc[3];
+        OX_BC_SAVE_IP();
+        r = do_add_n(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, d2));
+        OX_BC_NEXT(4);
+    }
+    OX_BC_CASE(sub_n) {
+        uint8_t s0;
+        uint8_t s1;
+        uint8_t d2;
+        s0 = bc[1];
+        s1 = bc[2];
+        d2 = bc[3];
+        OX_BC_SAVE_IP();
+        r = do_sub_n(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, d2));
+        OX_BC_NEXT(4);
+    }
+    OX_BC_CASE(mul_n) {
+        uint8_t s0;
+        uint8_t s1;
+        uint8_t d2;
+        s0 = bc[1];
+        s1 = bc[2];
+        d2 = bc[3];
+        OX_BC_SAVE_IP();
+        r = do_mul_n(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, d2));
+        OX_BC_NEXT(4);
+    }
+    OX_BC_CASE(lt_n) {
+        uint8_t s0;
+        uint8_t s1;
+        uint8_t d2;
+        s0 = bc[1];
+        s1 = bc[2];
+        d2 = bc[3];
+        OX_BC_SAVE_IP();
+        r = do_lt_n(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, d2));
+        OX_BC_NEXT(4);
+    }
+    OX_BC_CASE(gt_n) {
+        uint8_t s0;
+        uint8_t s1;
+        uint8_t d2;
+        s0 = bc[1];
+        s1 = bc[2];
+        d2 = bc[3];
+        OX_BC_SAVE_IP();
+        r = do_gt_n(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, d2));
+        OX_BC_NEXT(4);
+    }
+    OX_BC_CASE(le_n) {
+        uint8_t s0;
+        uint8_t s1;
+        uint8_t d2;
+        s0 = bc[1];
+        s1 = bc[2];
+        d2 = bc[3];
+        OX_BC_SAVE_IP();
+        r = do_le_n(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, d2));
+        OX_BC_NEXT(4);
+    }
+    OX_BC_CASE(ge_n) {
+        uint8_t s0;
+        uint8_t s1;
+        uint8_t d2;
+        s0 = bc[1];
+        s1 = bc[2];
+        d2 = bc[3];
+        OX_BC_SAVE_IP();
+        r = do_ge_n(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, d2));
+        OX_BC_NEXT(4);
+    }
+    OX_BC_CASE(eq_n) {
+        uint8_t s0;
+        uint8_t s1;
+        uint8_t d2;
+        s0 = bc[1];
+        s1 = bc[2];
+        d2 = bc[3];
+        OX_BC_SAVE_IP();
+        r = do_eq_n(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, d2));
+        OX_BC_NEXT(4);
+    }
+    OX_BC_CASE(ne_n) {
+        uint8_t s0;
+        uint8_t s1;
+        uint8_t d2;
+        s0 = bc[1];
+        s1 = bc[2];
+        d2 = bc[3];
+        OX_BC_SAVE_IP();
+        r = do_ne_n(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, d2));
+        OX_BC_NEXT(4);
+    }
+    OX_BC_CASE(get_t_nn) {
+        uint16_t i0;
+        uint16_t c1;
+        uint8_t d2;
+        i0 = bc[1] << 8 | bc[2];
+        c1 = bc[3] << 8 | bc[4];
+        d2 = bc[5];
+        OX_BC_SAVE_IP();
+        r = do_get_t_nn(ctxt, &rs, i0, &rs.s->cvs[c1], ox_values_item(ctxt, rs.regs, d2));
+        OX_BC_NEXT(6);
+    }
+    OX_BC_CASE(get_p_c) {
+        uint8_t s0;
+        uint16_t c1;
+        uint8_t d2;
+        uint16_t C3;
+        s0 = bc[1];
+        c1 = bc[2] << 8 | bc[3];
+        d2 = bc[4];
+        C3 = bc[5] << 8 | bc[6];
+        OX_BC_SAVE_IP();
+        r = do_get_p_c(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), &rs.s->cvs[c1], ox_values_item(ctxt, rs.regs, d2), &rs.s->pcs[C3]);
+        OX_BC_NEXT(7);
+    }
+    OX_BC_CASE(lt_jf) {
+        uint8_t s0;
+        uint8_t s1;
+        uint16_t l2;
+        s0 = bc[1];
+        s1 = bc[2];
+        l2 = bc[3] << 8 | bc[4];
+        OX_BC_SAVE_IP();
+        r = do_lt_jf(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), l2);
+        OX_BC_NEXT(5);
+    }
+    OX_BC_CASE(gt_jf) {
+        uint8_t s0;
+        uint8_t s1;
+        uint16_t l2;
+        s0 = bc[1];
+        s1 = bc[2];
+        l2 = bc[3] << 8 | bc[4];
+        OX_BC_SAVE_IP();
+        r = do_gt_jf(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), l2);
+        OX_BC_NEXT(5);
+    }
+    OX_BC_CASE(le_jf) {
+        uint8_t s0;
+        uint8_t s1;
+        uint16_t l2;
+        s0 = bc[1];
+        s1 = bc[2];
+        l2 = bc[3] << 8 | bc[4];
+        OX_BC_SAVE_IP();
+        r = do_le_jf(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), l2);
+        OX_BC_NEXT(5);
+    }
+    OX_BC_CASE(ge_jf) {
+        uint8_t s0;
+        uint8_t s1;
+        uint16_t l2;
+        s0 = bc[1];
+        s1 = bc[2];
+        l2 = bc[3] << 8 | bc[4];
+        OX_BC_SAVE_IP();
+        r = do_ge_jf(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), l2);
+        OX_BC_NEXT(5);
+    }
+    OX_BC_CASE(eq_jf) {
+        uint8_t s0;
+        uint8_t s1;
+        uint16_t l2;
+        s0 = bc[1];
+        s1 = bc[2];
+        l2 = bc[3] << 8 | bc[4];
+        OX_BC_SAVE_IP();
+        r = do_eq_jf(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), l2);
+        OX_BC_NEXT(5);
+    }
+    OX_BC_CASE(ne_jf) {
+        uint8_t s0;
+        uint8_t s1;
+        uint16_t l2;
+        s0 = bc[1];
+        s1 = bc[2];
+        l2 = bc[3] << 8 | bc[4];
+        OX_BC_SAVE_IP();
+        r = do_ne_jf(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), l2);
+        OX_BC_NEXT(5);
+    }
+    OX_BC_CASE(call0) {
+        uint8_t s0;
+        uint8_t s1;
+        uint8_t d2;
+        s0 = bc[1];
+        s1 = bc[2];
+        d2 = bc[3];
+        OX_BC_SAVE_IP();
+        r = do_call0(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, d2));
+        OX_BC_NEXT(4);
+    }
+    OX_BC_CASE(call1) {
+        uint8_t s0;
+        uint8_t s1;
+        uint8_t s2;
+        uint8_t d3;
+        s0 = bc[1];
+        s1 = bc[2];
+        s2 = bc[3];
+        d3 = bc[4];
+        OX_BC_SAVE_IP();
+        r = do_call1(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, s2), ox_values_item(ctxt, rs.regs, d3));
+        OX_BC_NEXT(5);
+    }
+    OX_BC_CASE(call2) {
+        uint8_t s0;
+        uint8_t s1;
+        uint8_t s2;
+        uint8_t s3;
+        uint8_t d4;
+        s0 = bc[1];
+        s1 = bc[2];
+        s2 = bc[3];
+        s3 = bc[4];
+        d4 = bc[5];
+        OX_BC_SAVE_IP();
+        r = do_call2(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, s2), ox_values_item(ctxt, rs.regs, s3), ox_values_item(ctxt, rs.regs, d4));
+        OX_BC_NEXT(6);
+    }
+    OX_BC_CASE(call3) {
+        uint8_t s0;
+        uint8_t s1;
+        uint8_t s2;
+        uint8_t s3;
+        uint8_t s4;
+        uint8_t d5;
+        s0 = bc[1];
+        s1 = bc[2];
+        s2 = bc[3];
+        s3 = bc[4];
+        s4 = bc[5];
+        d5 = bc[6];
+        OX_BC_SAVE_IP();
+        r = do_call3(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, s2), ox_values_item(ctxt, rs.regs, s3), ox_values_item(ctxt, rs.regs, s4), ox_values_item(ctxt, rs.regs, d5));
+        OX_BC_NEXT(7);
+    }
+    OX_BC_CASE(p_get_t) {
+        uint16_t i0;
+        i0 = bc[1] << 8 | bc[2];
+        OX_BC_SAVE_IP();
+        r = do_p_get_t(ctxt, &rs, i0);
+        OX_BC_NEXT(3);
+    }
+    OX_BC_CASE(get_a_t) {
+        uint16_t i0;
+        uint16_t i1;
+        i0 = bc[1] << 8 | bc[2];
+        i1 = bc[3] << 8 | bc[4];
+        OX_BC_SAVE_IP();
+        r = do_get_a_t(ctxt, &rs, i0, i1);
+        OX_BC_NEXT(5);
+    }
+    OX_BC_CASE(load_null) {
         uint8_t d0;
         d0 = bc[1];
         r = do_load_null(ctxt, &rs, ox_values_item(ctxt, rs.regs, d0));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 2;
-        break;
-    }
-    case OX_BC_load_true: {
+        OX_BC_NEXT(2);
+    }
+    OX_BC_CASE(load_true) {
         uint8_t d0;
         d0 = bc[1];
         r = do_load_true(ctxt, &rs, ox_values_item(ctxt, rs.regs, d0));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 2;
-        break;
-    }
-    case OX_BC_load_false: {
+        OX_BC_NEXT(2);
+    }
+    OX_BC_CASE(load_false) {
         uint8_t d0;
         d0 = bc[1];
         r = do_load_false(ctxt, &rs, ox_values_item(ctxt, rs.regs, d0));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 2;
-        break;
-    }
-    case OX_BC_this: {
+        OX_BC_NEXT(2);
+    }
+    OX_BC_CASE(this) {
         uint8_t d0;
         d0 = bc[1];
         r = do_this(ctxt, &rs, ox_values_item(ctxt, rs.regs, d0));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 2;
-        break;
-    }
-    case OX_BC_this_b: {
+        OX_BC_NEXT(2);
+    }
+    OX_BC_CASE(this_b) {
         uint8_t o0;
         uint8_t d1;
         o0 = bc[1];
         d1 = bc[2];
         r = do_this_b(ctxt, &rs, o0, ox_values_item(ctxt, rs.regs, d1));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 3;
-        break;
-    }
-    case OX_BC_argv: {
+        OX_BC_NEXT(3);
+    }
+    OX_BC_CASE(argv) {
         uint8_t d0;
         d0 = bc[1];
+        OX_BC_SAVE_IP();
         r = do_argv(ctxt, &rs, ox_values_item(ctxt, rs.regs, d0));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 2;
-        break;
-    }
-    case OX_BC_get_cv: {
+        OX_BC_NEXT(2);
+    }
+    OX_BC_CASE(get_cv) {
         uint16_t c0;
         uint8_t d1;
         c0 = bc[1] << 8 | bc[2];
         d1 = bc[3];
         r = do_get_cv(ctxt, &rs, &rs.s->cvs[c0], ox_values_item(ctxt, rs.regs, d1));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
-    }
-    case OX_BC_get_pp: {
+        OX_BC_NEXT(4);
+    }
+    OX_BC_CASE(get_pp) {
         uint16_t p0;
         uint8_t d1;
         p0 = bc[1] << 8 | bc[2];
         d1 = bc[3];
         r = do_get_pp(ctxt, &rs, &rs.s->pps[p0], ox_values_item(ctxt, rs.regs, d1));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
-    }
-    case OX_BC_get_lt: {
+        OX_BC_NEXT(4);
+    }
+    OX_BC_CASE(get_lt) {
         uint16_t t0;
         uint8_t d1;
         t0 = bc[1] << 8 | bc[2];
         d1 = bc[3];
+        OX_BC_SAVE_IP();
         r = do_get_lt(ctxt, &rs, t0, ox_values_item(ctxt, rs.regs, d1));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
-    }
-    case OX_BC_get_ltt: {
+        OX_BC_NEXT(4);
+    }
+    OX_BC_CASE(get_ltt) {
         uint16_t T0;
         uint8_t d1;
         T0 = bc[1] << 8 | bc[2];
         d1 = bc[3];
+        OX_BC_SAVE_IP();
         r = do_get_ltt(ctxt, &rs, T0, ox_values_item(ctxt, rs.regs, d1));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
-    }
-    case OX_BC_get_t: {
+        OX_BC_NEXT(4);
+    }
+    OX_BC_CASE(get_t) {
         uint16_t i0;
         uint8_t d1;
         i0 = bc[1] << 8 | bc[2];
         d1 = bc[3];
         r = do_get_t(ctxt, &rs, i0, ox_values_item(ctxt, rs.regs, d1));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
-    }
-    case OX_BC_set_t: {
+        OX_BC_NEXT(4);
+    }
+    OX_BC_CASE(set_t) {
         uint16_t i0;
         uint8_t s1;
         i0 = bc[1] << 8 | bc[2];
         s1 = bc[3];
+        OX_BC_SAVE_IP();
         r = do_set_t(ctxt, &rs, i0, ox_values_item(ctxt, rs.regs, s1));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
-    }
-    case OX_BC_set_t_ac: {
+        OX_BC_NEXT(4);
+    }
+    OX_BC_CASE(set_t_ac) {
         uint16_t i0;
         uint8_t s1;
         i0 = bc[1] << 8 | bc[2];
         s1 = bc[3];
+        OX_BC_SAVE_IP();
         r = do_set_t_ac(ctxt, &rs, i0, ox_values_item(ctxt, rs.regs, s1));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
-    }
-    case OX_BC_get_t_b: {
+        OX_BC_NEXT(4);
+    }
+    OX_BC_CASE(get_t_b) {
         uint8_t o0;
         uint16_t i1;
         uint8_t d2;
         o0 = bc[1];
         i1 = bc[2] << 8 | bc[3];
         d2 = bc[4];
+        OX_BC_SAVE_IP();
         r = do_get_t_b(ctxt, &rs, o0, i1, ox_values_item(ctxt, rs.regs, d2));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 5;
-        break;
-    }
-    case OX_BC_set_t_b: {
+        OX_BC_NEXT(5);
+    }
+    OX_BC_CASE(set_t_b) {
         uint8_t o0;
         uint16_t i1;
         uint8_t s2;
         o0 = bc[1];
         i1 = bc[2] << 8 | bc[3];
         s2 = bc[4];
+        OX_BC_SAVE_IP();
         r = do_set_t_b(ctxt, &rs, o0, i1, ox_values_item(ctxt, rs.regs, s2));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 5;
-        break;
-    }
-    case OX_BC_set_t_b_ac: {
+        OX_BC_NEXT(5);
+    }
+    OX_BC_CASE(set_t_b_ac) {
         uint8_t o0;
         uint16_t i1;
         uint8_t s2;
         o0 = bc[1];
         i1 = bc[2] << 8 | bc[3];
         s2 = bc[4];
+        OX_BC_SAVE_IP();
         r = do_set_t_b_ac(ctxt, &rs, o0, i1, ox_values_item(ctxt, rs.regs, s2));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 5;
-        break;
-    }
-    case OX_BC_get_n: {
+        OX_BC_NEXT(5);
+    }
+    OX_BC_CASE(cell_t) {
+        uint16_t i0;
+        i0 = bc[1] << 8 | bc[2];
+        OX_BC_SAVE_IP();
+        r = do_cell_t(ctxt, &rs, i0);
+        OX_BC_NEXT(3);
+    }
+    OX_BC_CASE(get_t_c) {
+        uint16_t i0;
+        uint8_t d1;
+        i0 = bc[1] << 8 | bc[2];
+        d1 = bc[3];
+        r = do_get_t_c(ctxt, &rs, i0, ox_values_item(ctxt, rs.regs, d1));
+        OX_BC_NEXT(4);
+    }
+    OX_BC_CASE(set_t_c) {
+        uint16_t i0;
+        uint8_t s1;
+        i0 = bc[1] << 8 | bc[2];
+        s1 = bc[3];
+        OX_BC_SAVE_IP();
+        r = do_set_t_c(ctxt, &rs, i0, ox_values_item(ctxt, rs.regs, s1));
+        OX_BC_NEXT(4);
+    }
+    OX_BC_CASE(set_t_c_ac) {
+        uint16_t i0;
+        uint8_t s1;
+        i0 = bc[1] << 8 | bc[2];
+        s1 = bc[3];
+        OX_BC_SAVE_IP();
+        r = do_set_t_c_ac(ctxt, &rs, i0, ox_values_item(ctxt, rs.regs, s1));
+        OX_BC_NEXT(4);
+    }
+    OX_BC_CASE(get_cap) {
+        uint16_t i0;
+        uint8_t d1;
+        i0 = bc[1] << 8 | bc[2];
+        d1 = bc[3];
+        r = do_get_cap(ctxt, &rs, i0, ox_values_item(ctxt, rs.regs, d1));
+        OX_BC_NEXT(4);
+    }
+    OX_BC_CASE(set_cap) {
+        uint16_t i0;
+        uint8_t s1;
+        i0 = bc[1] << 8 | bc[2];
+        s1 = bc[3];
+        OX_BC_SAVE_IP();
+        r = do_set_cap(ctxt, &rs, i0, ox_values_item(ctxt, rs.regs, s1));
+        OX_BC_NEXT(4);
+    }
+    OX_BC_CASE(set_cap_ac) {
+        uint16_t i0;
+        uint8_t s1;
+        i0 = bc[1] << 8 | bc[2];
+        s1 = bc[3];
+        OX_BC_SAVE_IP();
+        r = do_set_cap_ac(ctxt, &rs, i0, ox_values_item(ctxt, rs.regs, s1));
+        OX_BC_NEXT(4);
+    }
+    OX_BC_CASE(get_n) {
         uint16_t c0;
         uint8_t d1;
+        uint16_t C2;
         c0 = bc[1] << 8 | bc[2];
         d1 = bc[3];
-        r = do_get_n(ctxt, &rs, &rs.s->cvs[c0], ox_values_item(ctxt, rs.regs, d1));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
-    }
-    case OX_BC_get_g: {
+        C2 = bc[4] << 8 | bc[5];
+        OX_BC_SAVE_IP();
+        r = do_get_n(ctxt, &rs, &rs.s->cvs[c0], ox_values_item(ctxt, rs.regs, d1), &rs.s->pcs[C2]);
+        OX_BC_NEXT(6);
+    }
+    OX_BC_CASE(get_g) {
         uint16_t c0;
         uint8_t d1;
+        uint16_t C2;
         c0 = bc[1] << 8 | bc[2];
         d1 = bc[3];
-        r = do_get_g(ctxt, &rs, &rs.s->cvs[c0], ox_values_item(ctxt, rs.regs, d1));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
-    }
-    case OX_BC_get_r: {
+        C2 = bc[4] << 8 | bc[5];
+        OX_BC_SAVE_IP();
+        r = do_get_g(ctxt, &rs, &rs.s->cvs[c0], ox_values_item(ctxt, rs.regs, d1), &rs.s->pcs[C2]);
+        OX_BC_NEXT(6);
+    }
+    OX_BC_CASE(get_r) {
         uint16_t i0;
         uint8_t d1;
         i0 = bc[1] << 8 | bc[2];
         d1 = bc[3];
         r = do_get_r(ctxt, &rs, i0, ox_values_item(ctxt, rs.regs, d1));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
+        OX_BC_NEXT(4);
     }
-    case OX_BC_get_p: {
+    OX_BC_CASE(get_p) {
         uint8_t s0;
         uint8_t s1;
         uint8_t d2;
+        uint16_t C3;
         s0 = bc[1];
         s1 = bc[2];
         d2 = bc[3];
-        r = do_get_p(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, d2));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
+        C3 = bc[4] << 8 | bc[5];
+        OX_BC_SAVE_IP();
+        r = do_get_p(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, d2), &rs.s->pcs[C3]);
+        OX_BC_NEXT(6);
     }
-    case OX_BC_lookup_p: {
+    OX_BC_CASE(lookup_p) {
         uint8_t s0;
         uint8_t s1;
         uint8_t d2;
+        uint16_t C3;
         s0 = bc[1];
         s1 = bc[2];
         d2 = bc[3];
-        r = do_lookup_p(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, d2));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
+        C3 = bc[4] << 8 | bc[5];
+        OX_BC_SAVE_IP();
+        r = do_lookup_p(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, d2), &rs.s->pcs[C3]);
+        OX_BC_NEXT(6);
     }
-    case OX_BC_set_p: {
+    OX_BC_CASE(set_p) {
         uint8_t s0;
         uint8_t s1;
         uint8_t s2;
+        uint16_t C3;
         s0 = bc[1];
         s1 = bc[2];
         s2 = bc[3];
-        r = do_set_p(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, s2));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
-    }
-    case OX_BC_get_a: {
+        C3 = bc[4] << 8 | bc[5];
+        OX_BC_SAVE_IP();
+        r = do_set_p(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, s2), &rs.s->pcs[C3]);
+        OX_BC_NEXT(6);
+    }
+    OX_BC_CASE(get_a) {
         uint16_t i0;
         uint8_t d1;
         i0 = bc[1] << 8 | bc[2];
         d1 = bc[3];
         r = do_get_a(ctxt, &rs, i0, ox_values_item(ctxt, rs.regs, d1));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
+        OX_BC_NEXT(4);
     }
-    case OX_BC_throw: {
+    OX_BC_CASE(throw) {
         uint8_t s0;
         s0 = bc[1];
+        OX_BC_SAVE_IP();
         r = do_throw(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 2;
-        break;
+        OX_BC_NEXT(2);
     }
-    case OX_BC_ret: {
+    OX_BC_CASE(ret) {
         uint8_t s0;
         s0 = bc[1];
+        OX_BC_SAVE_IP();
         r = do_ret(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 2;
-        break;
-    }
-    case OX_BC_jmp: {
+        OX_BC_NEXT(2);
+    }
+    OX_BC_CASE(jmp) {
         uint16_t l0;
         l0 = bc[1] << 8 | bc[2];
         r = do_jmp(ctxt, &rs, l0);
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 3;
-        break;
-    }
-    case OX_BC_deep_jmp: {
+        OX_BC_NEXT(3);
+    }
+    OX_BC_CASE(deep_jmp) {
         uint8_t o0;
         uint16_t l1;
         o0 = bc[1];
         l1 = bc[2] << 8 | bc[3];
+        OX_BC_SAVE_IP();
         r = do_deep_jmp(ctxt, &rs, o0, l1);
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
+        OX_BC_NEXT(4);
     }
-    case OX_BC_jt: {
+    OX_BC_CASE(jt) {
         uint8_t s0;
         uint16_t l1;
         s0 = bc[1];
         l1 = bc[2] << 8 | bc[3];
         r = do_jt(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), l1);
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
+        OX_BC_NEXT(4);
     }
-    case OX_BC_jf: {
+    OX_BC_CASE(jf) {
         uint8_t s0;
         uint16_t l1;
         s0 = bc[1];
         l1 = bc[2] << 8 | bc[3];
         r = do_jf(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), l1);
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
+        OX_BC_NEXT(4);
     }
-    case OX_BC_jnn: {
+    OX_BC_CASE(jnn) {
         uint8_t s0;
         uint16_t l1;
         s0 = bc[1];
         l1 = bc[2] << 8 | bc[3];
         r = do_jnn(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), l1);
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
+        OX_BC_NEXT(4);
     }
-    case OX_BC_str_start: {
+    OX_BC_CASE(str_start) {
         uint8_t s0;
         s0 = bc[1];
+        OX_BC_SAVE_IP();
         r = do_str_start(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 2;
-        break;
+        OX_BC_NEXT(2);
     }
-    case OX_BC_str_start_t: {
+    OX_BC_CASE(str_start_t) {
         uint8_t s0;
         uint8_t s1;
         s0 = bc[1];
         s1 = bc[2];
+        OX_BC_SAVE_IP();
         r = do_str_start_t(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 3;
-        break;
+        OX_BC_NEXT(3);
     }
-    case OX_BC_str_item: {
+    OX_BC_CASE(str_item) {
         uint8_t s0;
         s0 = bc[1];
+        OX_BC_SAVE_IP();
         r = do_str_item(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 2;
-        break;
-    }
-    case OX_BC_str_item_f: {
+        OX_BC_NEXT(2);
+    }
+    OX_BC_CASE(str_item_f) {
         uint16_t c0;
         uint8_t s1;
         c0 = bc[1] << 8 | bc[2];
         s1 = bc[3];
+        OX_BC_SAVE_IP();
         r = do_str_item_f(ctxt, &rs, &rs.s->cvs[c0], ox_values_item(ctxt, rs.regs, s1));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
-    }
-    case OX_BC_str_end: {
+        OX_BC_NEXT(4);
+    }
+    OX_BC_CASE(str_end) {
         uint8_t d0;
         d0 = bc[1];
+        OX_BC_SAVE_IP();
         r = do_str_end(ctxt, &rs, ox_values_item(ctxt, rs.regs, d0));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 2;
-        break;
+        OX_BC_NEXT(2);
     }
-    case OX_BC_call_start: {
+    OX_BC_CASE(call_start) {
         uint8_t s0;
         uint8_t s1;
         s0 = bc[1];
         s1 = bc[2];
+        OX_BC_SAVE_IP();
         r = do_call_start(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 3;
-        break;
+        OX_BC_NEXT(3);
     }
-    case OX_BC_arg: {
+    OX_BC_CASE(arg) {
         uint8_t s0;
         s0 = bc[1];
+        OX_BC_SAVE_IP();
         r = do_arg(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 2;
-        break;
+        OX_BC_NEXT(2);
     }
-    case OX_BC_arg_spread: {
+    OX_BC_CASE(arg_spread) {
         uint8_t s0;
         s0 = bc[1];
+        OX_BC_SAVE_IP();
         r = do_arg_spread(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 2;
-        break;
-    }
-    case OX_BC_call_end: {
+        OX_BC_NEXT(2);
+    }
+    OX_BC_CASE(call_end) {
         uint8_t d0;
         d0 = bc[1];
+        OX_BC_SAVE_IP();
         r = do_call_end(ctxt, &rs, ox_values_item(ctxt, rs.regs, d0));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 2;
-        break;
-    }
-    case OX_BC_call_end_tail: {
+        OX_BC_NEXT(2);
+    }
+    OX_BC_CASE(call_end_tail) {
         uint8_t d0;
         d0 = bc[1];
+        OX_BC_SAVE_IP();
         r = do_call_end_tail(ctxt, &rs, ox_values_item(ctxt, rs.regs, d0));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 2;
-        break;
-    }
-    case OX_BC_try_start: {
+        OX_BC_NEXT(2);
+    }
+    OX_BC_CASE(try_end) {
         uint16_t l0;
-        uint16_t l1;
         l0 = bc[1] << 8 | bc[2];
-        l1 = bc[3] << 8 | bc[4];
-        r = do_try_start(ctxt, &rs, l0, l1);
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 5;
-        break;
-    }
-    case OX_BC_try_end: {
-        r = do_try_end(ctxt, &rs);
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 1;
-        break;
-    }
-    case OX_BC_catch: {
+        r = do_try_end(ctxt, &rs, l0);
+        OX_BC_NEXT(3);
+    }
+    OX_BC_CASE(catch) {
         uint8_t d0;
         d0 = bc[1];
+        OX_BC_SAVE_IP();
         r = do_catch(ctxt, &rs, ox_values_item(ctxt, rs.regs, d0));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 2;
-        break;
-    }
-    case OX_BC_catch_end: {
-        r = do_catch_end(ctxt, &rs);
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 1;
-        break;
-    }
-    case OX_BC_finally: {
+        OX_BC_NEXT(2);
+    }
+    OX_BC_CASE(finally) {
+        OX_BC_SAVE_IP();
         r = do_finally(ctxt, &rs);
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 1;
-        break;
-    }
-    case OX_BC_sched: {
+        OX_BC_NEXT(1);
+    }
+    OX_BC_CASE(sched) {
+        OX_BC_SAVE_IP();
         r = do_sched(ctxt, &rs);
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 1;
-        break;
-    }
-    case OX_BC_sched_start: {
+        OX_BC_NEXT(1);
+    }
+    OX_BC_CASE(sched_start) {
+        OX_BC_SAVE_IP();
         r = do_sched_start(ctxt, &rs);
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 1;
-        break;
+        OX_BC_NEXT(1);
     }
-    case OX_BC_yield: {
+    OX_BC_CASE(yield) {
         uint8_t s0;
         uint8_t d1;
         s0 = bc[1];
         d1 = bc[2];
+        OX_BC_SAVE_IP();
         r = do_yield(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, d1));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 3;
-        break;
-    }
-    case OX_BC_s_pop: {
+        OX_BC_NEXT(3);
+    }
+    OX_BC_CASE(s_pop) {
+        OX_BC_SAVE_IP();
         r = do_s_pop(ctxt, &rs);
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 1;
-        break;
+        OX_BC_NEXT(1);
     }
-    case OX_BC_iter_start: {
+    OX_BC_CASE(iter_start) {
         uint8_t s0;
         s0 = bc[1];
+        OX_BC_SAVE_IP();
         r = do_iter_start(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 2;
-        break;
-    }
-    case OX_BC_iter_step: {
+        OX_BC_NEXT(2);
+    }
+    OX_BC_CASE(iter_step) {
         uint8_t d0;
         uint16_t l1;
         d0 = bc[1];
         l1 = bc[2] << 8 | bc[3];
+        OX_BC_SAVE_IP();
         r = do_iter_step(ctxt, &rs, ox_values_item(ctxt, rs.regs, d0), l1);
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
+        OX_BC_NEXT(4);
     }
-    case OX_BC_apat_start: {
+    OX_BC_CASE(apat_start) {
         uint8_t s0;
         s0 = bc[1];
+        OX_BC_SAVE_IP();
         r = do_apat_start(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 2;
-        break;
-    }
-    case OX_BC_apat_next: {
+        OX_BC_NEXT(2);
+    }
+    OX_BC_CASE(apat_next) {
         r = do_apat_next(ctxt, &rs);
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 1;
-        break;
-    }
-    case OX_BC_apat_get: {
+        OX_BC_NEXT(1);
+    }
+    OX_BC_CASE(apat_get) {
         uint8_t d0;
         d0 = bc[1];
+        OX_BC_SAVE_IP();
         r = do_apat_get(ctxt, &rs, ox_values_item(ctxt, rs.regs, d0));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 2;
-        break;
-    }
-    case OX_BC_apat_rest: {
+        OX_BC_NEXT(2);
+    }
+    OX_BC_CASE(apat_rest) {
         uint8_t d0;
         d0 = bc[1];
+        OX_BC_SAVE_IP();
         r = do_apat_rest(ctxt, &rs, ox_values_item(ctxt, rs.regs, d0));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 2;
-        break;
+        OX_BC_NEXT(2);
     }
-    case OX_BC_opat_start: {
+    OX_BC_CASE(opat_start) {
         uint8_t s0;
         s0 = bc[1];
+        OX_BC_SAVE_IP();
         r = do_opat_start(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 2;
-        break;
+        OX_BC_NEXT(2);
     }
-    case OX_BC_opat_get: {
+    OX_BC_CASE(opat_get) {
         uint8_t s0;
         uint8_t d1;
         s0 = bc[1];
         d1 = bc[2];
+        OX_BC_SAVE_IP();
         r = do_opat_get(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, d1));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 3;
-        break;
-    }
-    case OX_BC_opat_rest: {
+        OX_BC_NEXT(3);
+    }
+    OX_BC_CASE(opat_rest) {
         uint8_t d0;
         d0 = bc[1];
+        OX_BC_SAVE_IP();
         r = do_opat_rest(ctxt, &rs, ox_values_item(ctxt, rs.regs, d0));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 2;
-        break;
-    }
-    case OX_BC_a_new: {
+        OX_BC_NEXT(2);
+    }
+    OX_BC_CASE(a_new) {
         uint8_t d0;
         d0 = bc[1];
+        OX_BC_SAVE_IP();
         r = do_a_new(ctxt, &rs, ox_values_item(ctxt, rs.regs, d0));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 2;
-        break;
+        OX_BC_NEXT(2);
     }
-    case OX_BC_a_start: {
+    OX_BC_CASE(a_start) {
         uint8_t s0;
         s0 = bc[1];
+        OX_BC_SAVE_IP();
         r = do_a_start(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 2;
-        break;
-    }
-    case OX_BC_a_next: {
+        OX_BC_NEXT(2);
+    }
+    OX_BC_CASE(a_next) {
         r = do_a_next(ctxt, &rs);
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 1;
-        break;
+        OX_BC_NEXT(1);
     }
-    case OX_BC_a_item: {
+    OX_BC_CASE(a_item) {
         uint8_t s0;
         s0 = bc[1];
+        OX_BC_SAVE_IP();
         r = do_a_item(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 2;
-        break;
+        OX_BC_NEXT(2);
     }
-    case OX_BC_a_spread: {
+    OX_BC_CASE(a_spread) {
         uint8_t s0;
         s0 = bc[1];
+        OX_BC_SAVE_IP();
         r = do_a_spread(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 2;
-        break;
-    }
-    case OX_BC_a_end: {
+        OX_BC_NEXT(2);
+    }
+    OX_BC_CASE(a_end) {
+        OX_BC_SAVE_IP();
         r = do_a_end(ctxt, &rs);
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 1;
-        break;
-    }
-    case OX_BC_o_new: {
+        OX_BC_NEXT(1);
+    }
+    OX_BC_CASE(o_new) {
         uint8_t d0;
         d0 = bc[1];
+        OX_BC_SAVE_IP();
         r = do_o_new(ctxt, &rs, ox_values_item(ctxt, rs.regs, d0));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 2;
-        break;
+        OX_BC_NEXT(2);
     }
-    case OX_BC_o_start: {
+    OX_BC_CASE(o_start) {
         uint8_t s0;
         s0 = bc[1];
+        OX_BC_SAVE_IP();
         r = do_o_start(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 2;
-        break;
+        OX_BC_NEXT(2);
     }
-    case OX_BC_o_prop: {
+    OX_BC_CASE(o_prop) {
         uint8_t s0;
         uint8_t s1;
         s0 = bc[1];
         s1 = bc[2];
+        OX_BC_SAVE_IP();
         r = do_o_prop(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 3;
-        break;
+        OX_BC_NEXT(3);
     }
-    case OX_BC_o_spread: {
+    OX_BC_CASE(o_spread) {
         uint8_t s0;
         s0 = bc[1];
+        OX_BC_SAVE_IP();
         r = do_o_spread(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 2;
-        break;
-    }
-    case OX_BC_p_start: {
+        OX_BC_NEXT(2);
+    }
+    OX_BC_CASE(p_start) {
+        OX_BC_SAVE_IP();
         r = do_p_start(ctxt, &rs);
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 1;
-        break;
-    }
-    case OX_BC_p_get: {
+        OX_BC_NEXT(1);
+    }
+    OX_BC_CASE(p_get) {
         uint8_t d0;
         d0 = bc[1];
+        OX_BC_SAVE_IP();
         r = do_p_get(ctxt, &rs, ox_values_item(ctxt, rs.regs, d0));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 2;
-        break;
-    }
-    case OX_BC_p_rest: {
+        OX_BC_NEXT(2);
+    }
+    OX_BC_CASE(p_rest) {
         uint8_t d0;
         d0 = bc[1];
+        OX_BC_SAVE_IP();
         r = do_p_rest(ctxt, &rs, ox_values_item(ctxt, rs.regs, d0));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 2;
-        break;
-    }
-    case OX_BC_f_new: {
+        OX_BC_NEXT(2);
+    }
+    OX_BC_CASE(f_new) {
         uint16_t i0;
         uint8_t d1;
         i0 = bc[1] << 8 | bc[2];
         d1 = bc[3];
+        OX_BC_SAVE_IP();
         r = do_f_new(ctxt, &rs, i0, ox_values_item(ctxt, rs.regs, d1));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
-    }
-    case OX_BC_c_new: {
+        OX_BC_NEXT(4);
+    }
+    OX_BC_CASE(c_new) {
         uint8_t d0;
         uint8_t d1;
         d0 = bc[1];
         d1 = bc[2];
+        OX_BC_SAVE_IP();
         r = do_c_new(ctxt, &rs, ox_values_item(ctxt, rs.regs, d0), ox_values_item(ctxt, rs.regs, d1));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 3;
-        break;
+        OX_BC_NEXT(3);
     }
-    case OX_BC_c_parent: {
+    OX_BC_CASE(c_parent) {
         uint8_t s0;
         uint8_t s1;
         s0 = bc[1];
         s1 = bc[2];
+        OX_BC_SAVE_IP();
         r = do_c_parent(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 3;
-        break;
+        OX_BC_NEXT(3);
     }
-    case OX_BC_c_const: {
+    OX_BC_CASE(c_const) {
         uint8_t s0;
         uint8_t s1;
         uint8_t s2;
         s0 = bc[1];
         s1 = bc[2];
         s2 = bc[3];
+        OX_BC_SAVE_IP();
         r = do_c_const(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, s2));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
+        OX_BC_NEXT(4);
     }
-    case OX_BC_c_var: {
+    OX_BC_CASE(c_var) {
         uint8_t s0;
         uint8_t s1;
         uint8_t s2;
         s0 = bc[1];
         s1 = bc[2];
         s2 = bc[3];
+        OX_BC_SAVE_IP();
         r = do_c_var(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, s2));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
+        OX_BC_NEXT(4);
     }
-    case OX_BC_c_acce: {
+    OX_BC_CASE(c_acce) {
         uint8_t s0;
         uint8_t s1;
         uint8_t s2;
@@ -1374,197 +1237,132 @@
         s1 = bc[2];
         s2 = bc[3];
         s3 = bc[4];
+        OX_BC_SAVE_IP();
         r = do_c_acce(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, s2), ox_values_item(ctxt, rs.regs, s3));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 5;
-        break;
+        OX_BC_NEXT(5);
     }
-    case OX_BC_c_ro_acce: {
+    OX_BC_CASE(c_ro_acce) {
         uint8_t s0;
         uint8_t s1;
         uint8_t s2;
         s0 = bc[1];
         s1 = bc[2];
         s2 = bc[3];
+        OX_BC_SAVE_IP();
         r = do_c_ro_acce(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1), ox_values_item(ctxt, rs.regs, s2));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
+        OX_BC_NEXT(4);
     }
-    case OX_BC_e_start: {
+    OX_BC_CASE(e_start) {
         uint8_t s0;
         s0 = bc[1];
+        OX_BC_SAVE_IP();
         r = do_e_start(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 2;
-        break;
-    }
-    case OX_BC_e_start_n: {
+        OX_BC_NEXT(2);
+    }
+    OX_BC_CASE(e_start_n) {
         uint16_t c0;
         uint8_t s1;
         c0 = bc[1] << 8 | bc[2];
         s1 = bc[3];
+        OX_BC_SAVE_IP();
         r = do_e_start_n(ctxt, &rs, &rs.s->cvs[c0], ox_values_item(ctxt, rs.regs, s1));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
-    }
-    case OX_BC_e_item: {
+        OX_BC_NEXT(4);
+    }
+    OX_BC_CASE(e_item) {
         uint16_t c0;
         c0 = bc[1] << 8 | bc[2];
+        OX_BC_SAVE_IP();
         r = do_e_item(ctxt, &rs, &rs.s->cvs[c0]);
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 3;
-        break;
+        OX_BC_NEXT(3);
     }
-    case OX_BC_b_start: {
+    OX_BC_CASE(b_start) {
         uint8_t s0;
         s0 = bc[1];
+        OX_BC_SAVE_IP();
         r = do_b_start(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 2;
-        break;
-    }
-    case OX_BC_b_start_n: {
+        OX_BC_NEXT(2);
+    }
+    OX_BC_CASE(b_start_n) {
         uint16_t c0;
         uint8_t s1;
         c0 = bc[1] << 8 | bc[2];
         s1 = bc[3];
+        OX_BC_SAVE_IP();
         r = do_b_start_n(ctxt, &rs, &rs.s->cvs[c0], ox_values_item(ctxt, rs.regs, s1));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
-    }
-    case OX_BC_b_item: {
+        OX_BC_NEXT(4);
+    }
+    OX_BC_CASE(b_item) {
         uint16_t c0;
         c0 = bc[1] << 8 | bc[2];
+        OX_BC_SAVE_IP();
         r = do_b_item(ctxt, &rs, &rs.s->cvs[c0]);
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 3;
-        break;
+        OX_BC_NEXT(3);
     }
-    case OX_BC_set_name: {
+    OX_BC_CASE(set_name) {
         uint8_t s0;
         uint8_t s1;
         s0 = bc[1];
         s1 = bc[2];
+        OX_BC_SAVE_IP();
         r = do_set_name(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 3;
-        break;
+        OX_BC_NEXT(3);
     }
-    case OX_BC_set_name_g: {
+    OX_BC_CASE(set_name_g) {
         uint8_t s0;
         uint8_t s1;
         s0 = bc[1];
         s1 = bc[2];
+        OX_BC_SAVE_IP();
         r = do_set_name_g(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 3;
-        break;
+        OX_BC_NEXT(3);
     }
-    case OX_BC_set_name_s: {
+    OX_BC_CASE(set_name_s) {
         uint8_t s0;
         uint8_t s1;
         s0 = bc[1];
         s1 = bc[2];
+        OX_BC_SAVE_IP();
         r = do_set_name_s(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 3;
-        break;
+        OX_BC_NEXT(3);
     }
-    case OX_BC_set_scope: {
+    OX_BC_CASE(set_scope) {
         uint8_t s0;
         uint8_t s1;
         s0 = bc[1];
         s1 = bc[2];
+        OX_BC_SAVE_IP();
         r = do_set_scope(ctxt, &rs, ox_values_item(ctxt, rs.regs, s0), ox_values_item(ctxt, rs.regs, s1));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 3;
-        break;
-    }
-    case OX_BC_name_nn: {
+        OX_BC_NEXT(3);
+    }
+    OX_BC_CASE(name_nn) {
         uint16_t c0;
         uint8_t s1;
         c0 = bc[1] << 8 | bc[2];
         s1 = bc[3];
+        OX_BC_SAVE_IP();
         r = do_name_nn(ctxt, &rs, &rs.s->cvs[c0], ox_values_item(ctxt, rs.regs, s1));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
-    }
-    case OX_BC_prop_nn: {
+        OX_BC_NEXT(4);
+    }
+    OX_BC_CASE(prop_nn) {
         uint16_t c0;
         uint8_t s1;
         c0 = bc[1] << 8 | bc[2];
         s1 = bc[3];
+        OX_BC_SAVE_IP();
         r = do_prop_nn(ctxt, &rs, &rs.s->cvs[c0], ox_values_item(ctxt, rs.regs, s1));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
-    }
-    case OX_BC_pprop_nn: {
+        OX_BC_NEXT(4);
+    }
+    OX_BC_CASE(pprop_nn) {
         uint16_t p0;
         uint8_t s1;
         p0 = bc[1] << 8 | bc[2];
         s1 = bc[3];
+        OX_BC_SAVE_IP();
         r = do_pprop_nn(ctxt, &rs, &rs.s->pps[p0], ox_values_item(ctxt, rs.regs, s1));
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 4;
-        break;
-    }
-    case OX_BC_nop: {
+        OX_BC_NEXT(4);
+    }
+    OX_BC_CASE(nop) {
         r = do_nop(ctxt, &rs);
-        if (r == OX_JUMP)
-            break;
-        if (r != OX_OK)
-            goto pop;
-        rs.frame->ip += 1;
-        break;
+        OX_BC_NEXT(1);
     }
 
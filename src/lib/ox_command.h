@@ -1,4 +1,4 @@
-static void
+static inline void
 cmd_model_sd (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int s0, int d1)
 {
     int cid = add_cmd(ctxt, c, ty);
@@ -7,7 +7,7 @@ cmd_model_sd (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int s0, int d1)
     cmd->sd.s0 = s0;
     cmd->sd.d1 = d1;
 }
-static void
+static inline void
 cmd_model_s (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int s0)
 {
     int cid = add_cmd(ctxt, c, ty);
@@ -15,7 +15,7 @@ cmd_model_s (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int s0)
 
     cmd->s.s0 = s0;
 }
-static void
+static inline void
 cmd_model_cs (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int c0, int s1)
 {
     int cid = add_cmd(ctxt, c, ty);
@@ -24,7 +24,7 @@ cmd_model_cs (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int c0, int s1)
     cmd->cs.c0 = c0;
     cmd->cs.s1 = s1;
 }
-static void
+static inline void
 cmd_model_d (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int d0)
 {
     int cid = add_cmd(ctxt, c, ty);
@@ -32,7 +32,7 @@ cmd_model_d (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int d0)
 
     cmd->d.d0 = d0;
 }
-static void
+static inline void
 cmd_model_ss (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int s0, int s1)
 {
     int cid = add_cmd(ctxt, c, ty);
@@ -41,7 +41,7 @@ cmd_model_ss (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int s0, int s1)
     cmd->ss.s0 = s0;
     cmd->ss.s1 = s1;
 }
-static void
+static inline void
 cmd_model_ssd (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int s0, int s1, int d2)
 {
     int cid = add_cmd(ctxt, c, ty);
@@ -51,7 +51,91 @@ cmd_model_ssd (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int s0, int s1,
     cmd->ssd.s1 = s1;
     cmd->ssd.d2 = d2;
 }
-static void
+static inline void
+cmd_model_icd (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int i0, int c1, int d2)
+{
+    int cid = add_cmd(ctxt, c, ty);
+    OX_Command *cmd = &ox_vector_item(&c->cmds, cid);
+
+    cmd->icd.i0 = i0;
+    cmd->icd.c1 = c1;
+    cmd->icd.d2 = d2;
+}
+static inline void
+cmd_model_scdC (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int s0, int c1, int d2, int C3)
+{
+    int cid = add_cmd(ctxt, c, ty);
+    OX_Command *cmd = &ox_vector_item(&c->cmds, cid);
+
+    cmd->scdC.s0 = s0;
+    cmd->scdC.c1 = c1;
+    cmd->scdC.d2 = d2;
+    cmd->scdC.C3 = C3;
+}
+static inline void
+cmd_model_ssl (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int s0, int s1, int l2)
+{
+    int cid = add_cmd(ctxt, c, ty);
+    OX_Command *cmd = &ox_vector_item(&c->cmds, cid);
+
+    cmd->ssl.s0 = s0;
+    cmd->ssl.s1 = s1;
+    cmd->ssl.l2 = l2;
+}
+static inline void
+cmd_model_sssd (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int s0, int s1, int s2, int d3)
+{
+    int cid = add_cmd(ctxt, c, ty);
+    OX_Command *cmd = &ox_vector_item(&c->cmds, cid);
+
+    cmd->sssd.s0 = s0;
+    cmd->sssd.s1 = s1;
+    cmd->sssd.s2 = s2;
+    cmd->sssd.d3 = d3;
+}
+static inline void
+cmd_model_ssssd (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int s0, int s1, int s2, int s3, int d4)
+{
+    int cid = add_cmd(ctxt, c, ty);
+    OX_Command *cmd = &ox_vector_item(&c->cmds, cid);
+
+    cmd->ssssd.s0 = s0;
+    cmd->ssssd.s1 = s1;
+    cmd->ssssd.s2 = s2;
+    cmd->ssssd.s3 = s3;
+    cmd->ssssd.d4 = d4;
+}
+static inline void
+cmd_model_sssssd (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int s0, int s1, int s2, int s3, int s4, int d5)
+{
+    int cid = add_cmd(ctxt, c, ty);
+    OX_Command *cmd = &ox_vector_item(&c->cmds, cid);
+
+    cmd->sssssd.s0 = s0;
+    cmd->sssssd.s1 = s1;
+    cmd->sssssd.s2 = s2;
+    cmd->sssssd.s3 = s3;
+    cmd->sssssd.s4 = s4;
+    cmd->sssssd.d5 = d5;
+}
+static inline void
+cmd_model_i (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int i0)
+{
+    int cid = add_cmd(ctxt, c, ty);
+    OX_Command *cmd = &ox_vector_item(&c->cmds, cid);
+
+    cmd->i.i0 = i0;
+}
+static inline void
+cmd_model_ii (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int i0, int i1)
+{
+    int cid = add_cmd(ctxt, c, ty);
+    OX_Command *cmd = &ox_vector_item(&c->cmds, cid);
+
+    cmd->ii.i0 = i0;
+    cmd->ii.i1 = i1;
+}
+static inline void
 cmd_model_od (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int o0, int d1)
 {
     int cid = add_cmd(ctxt, c, ty);
@@ -60,7 +144,7 @@ cmd_model_od (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int o0, int d1)
     cmd->od.o0 = o0;
     cmd->od.d1 = d1;
 }
-static void
+static inline void
 cmd_model_cd (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int c0, int d1)
 {
     int cid = add_cmd(ctxt, c, ty);
@@ -69,7 +153,7 @@ cmd_model_cd (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int c0, int d1)
     cmd->cd.c0 = c0;
     cmd->cd.d1 = d1;
 }
-static void
+static inline void
 cmd_model_pd (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int p0, int d1)
 {
     int cid = add_cmd(ctxt, c, ty);
@@ -78,7 +162,7 @@ cmd_model_pd (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int p0, int d1)
     cmd->pd.p0 = p0;
     cmd->pd.d1 = d1;
 }
-static void
+static inline void
 cmd_model_td (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int t0, int d1)
 {
     int cid = add_cmd(ctxt, c, ty);
@@ -87,7 +171,7 @@ cmd_model_td (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int t0, int d1)
     cmd->td.t0 = t0;
     cmd->td.d1 = d1;
 }
-static void
+static inline void
 cmd_model_Td (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int T0, int d1)
 {
     int cid = add_cmd(ctxt, c, ty);
@@ -96,7 +180,7 @@ cmd_model_Td (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int T0, int d1)
     cmd->Td.T0 = T0;
     cmd->Td.d1 = d1;
 }
-static void
+static inline void
 cmd_model_id (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int i0, int d1)
 {
     int cid = add_cmd(ctxt, c, ty);
@@ -105,7 +189,7 @@ cmd_model_id (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int i0, int d1)
     cmd->id.i0 = i0;
     cmd->id.d1 = d1;
 }
-static void
+static inline void
 cmd_model_is (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int i0, int s1)
 {
     int cid = add_cmd(ctxt, c, ty);
@@ -114,7 +198,7 @@ cmd_model_is (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int i0, int s1)
     cmd->is.i0 = i0;
     cmd->is.s1 = s1;
 }
-static void
+static inline void
 cmd_model_oid (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int o0, int i1, int d2)
 {
     int cid = add_cmd(ctxt, c, ty);
@@ -124,7 +208,7 @@ cmd_model_oid (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int o0, int i1,
     cmd->oid.i1 = i1;
     cmd->oid.d2 = d2;
 }
-static void
+static inline void
 cmd_model_ois (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int o0, int i1, int s2)
 {
     int cid = add_cmd(ctxt, c, ty);
@@ -134,17 +218,39 @@ cmd_model_ois (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int o0, int i1,
     cmd->ois.i1 = i1;
     cmd->ois.s2 = s2;
 }
-static void
-cmd_model_sss (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int s0, int s1, int s2)
+static inline void
+cmd_model_cdC (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int c0, int d1, int C2)
 {
     int cid = add_cmd(ctxt, c, ty);
     OX_Command *cmd = &ox_vector_item(&c->cmds, cid);
 
-    cmd->sss.s0 = s0;
-    cmd->sss.s1 = s1;
-    cmd->sss.s2 = s2;
+    cmd->cdC.c0 = c0;
+    cmd->cdC.d1 = d1;
+    cmd->cdC.C2 = C2;
 }
-static void
+static inline void
+cmd_model_ssdC (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int s0, int s1, int d2, int C3)
+{
+    int cid = add_cmd(ctxt, c, ty);
+    OX_Command *cmd = &ox_vector_item(&c->cmds, cid);
+
+    cmd->ssdC.s0 = s0;
+    cmd->ssdC.s1 = s1;
+    cmd->ssdC.d2 = d2;
+    cmd->ssdC.C3 = C3;
+}
+static inline void
+cmd_model_sssC (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int s0, int s1, int s2, int C3)
+{
+    int cid = add_cmd(ctxt, c, ty);
+    OX_Command *cmd = &ox_vector_item(&c->cmds, cid);
+
+    cmd->sssC.s0 = s0;
+    cmd->sssC.s1 = s1;
+    cmd->sssC.s2 = s2;
+    cmd->sssC.C3 = C3;
+}
+static inline void
 cmd_model_l (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int l0)
 {
     int cid = add_cmd(ctxt, c, ty);
@@ -152,7 +258,7 @@ cmd_model_l (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int l0)
 
     cmd->l.l0 = l0;
 }
-static void
+static inline void
 cmd_model_ol (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int o0, int l1)
 {
     int cid = add_cmd(ctxt, c, ty);
@@ -161,7 +267,7 @@ cmd_model_ol (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int o0, int l1)
     cmd->ol.o0 = o0;
     cmd->ol.l1 = l1;
 }
-static void
+static inline void
 cmd_model_sl (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int s0, int l1)
 {
     int cid = add_cmd(ctxt, c, ty);
@@ -170,21 +276,12 @@ cmd_model_sl (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int s0, int l1)
     cmd->sl.s0 = s0;
     cmd->sl.l1 = l1;
 }
-static void
-cmd_model_ll (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int l0, int l1)
-{
-    int cid = add_cmd(ctxt, c, ty);
-    OX_Command *cmd = &ox_vector_item(&c->cmds, cid);
-
-    cmd->ll.l0 = l0;
-    cmd->ll.l1 = l1;
-}
-static void
+static inline void
 cmd_model_noarg (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty)
 {
     add_cmd(ctxt, c, ty);
 }
-static void
+static inline void
 cmd_model_dl (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int d0, int l1)
 {
     int cid = add_cmd(ctxt, c, ty);
@@ -193,7 +290,7 @@ cmd_model_dl (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int d0, int l1)
     cmd->dl.d0 = d0;
     cmd->dl.l1 = l1;
 }
-static void
+static inline void
 cmd_model_dd (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int d0, int d1)
 {
     int cid = add_cmd(ctxt, c, ty);
@@ -202,7 +299,17 @@ cmd_model_dd (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int d0, int d1)
     cmd->dd.d0 = d0;
     cmd->dd.d1 = d1;
 }
-static void
+static inline void
+cmd_model_sss (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int s0, int s1, int s2)
+{
+    int cid = add_cmd(ctxt, c, ty);
+    OX_Command *cmd = &ox_vector_item(&c->cmds, cid);
+
+    cmd->sss.s0 = s0;
+    cmd->sss.s1 = s1;
+    cmd->sss.s2 = s2;
+}
+static inline void
 cmd_model_ssss (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int s0, int s1, int s2, int s3)
 {
     int cid = add_cmd(ctxt, c, ty);
@@ -213,7 +320,7 @@ cmd_model_ssss (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int s0, int s1
     cmd->ssss.s2 = s2;
     cmd->ssss.s3 = s3;
 }
-static void
+static inline void
 cmd_model_c (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int c0)
 {
     int cid = add_cmd(ctxt, c, ty);
@@ -221,7 +328,7 @@ cmd_model_c (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int c0)
 
     cmd->c.c0 = c0;
 }
-static void
+static inline void
 cmd_model_ps (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int p0, int s1)
 {
     int cid = add_cmd(ctxt, c, ty);
@@ -363,6 +470,98 @@ cmd_model_ps (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int p0, int s1)
     OX_STMT_BEGIN\
         cmd_model_ssd(ctxt, c, OX_BC_or, s0, s1, d2);\
     OX_STMT_END
+#define cmd_add_n(ctxt, c, s0, s1, d2)\
+    OX_STMT_BEGIN\
+        cmd_model_ssd(ctxt, c, OX_BC_add_n, s0, s1, d2);\
+    OX_STMT_END
+#define cmd_sub_n(ctxt, c, s0, s1, d2)\
+    OX_STMT_BEGIN\
+        cmd_model_ssd(ctxt, c, OX_BC_sub_n, s0, s1, d2);\
+    OX_STMT_END
+#define cmd_mul_n(ctxt, c, s0, s1, d2)\
+    OX_STMT_BEGIN\
+        cmd_model_ssd(ctxt, c, OX_BC_mul_n, s0, s1, d2);\
+    OX_STMT_END
+#define cmd_lt_n(ctxt, c, s0, s1, d2)\
+    OX_STMT_BEGIN\
+        cmd_model_ssd(ctxt, c, OX_BC_lt_n, s0, s1, d2);\
+    OX_STMT_END
+#define cmd_gt_n(ctxt, c, s0, s1, d2)\
+    OX_STMT_BEGIN\
+        cmd_model_ssd(ctxt, c, OX_BC_gt_n, s0, s1, d2);\
+    OX_STMT_END
+#define cmd_le_n(ctxt, c, s0, s1, d2)\
+    OX_STMT_BEGIN\
+        cmd_model_ssd(ctxt, c, OX_BC_le_n, s0, s1, d2);\
+    OX_STMT_END
+#define cmd_ge_n(ctxt, c, s0, s1, d2)\
+    OX_STMT_BEGIN\
+        cmd_model_ssd(ctxt, c, OX_BC_ge_n, s0, s1, d2);\
+    OX_STMT_END
+#define cmd_eq_n(ctxt, c, s0, s1, d2)\
+    OX_STMT_BEGIN\
+        cmd_model_ssd(ctxt, c, OX_BC_eq_n, s0, s1, d2);\
+    OX_STMT_END
+#define cmd_ne_n(ctxt, c, s0, s1, d2)\
+    OX_STMT_BEGIN\
+        cmd_model_ssd(ctxt, c, OX_BC_ne_n, s0, s1, d2);\
+    OX_STMT_END
+#define cmd_get_t_nn(ctxt, c, i0, c1, d2)\
+    OX_STMT_BEGIN\
+        cmd_model_icd(ctxt, c, OX_BC_get_t_nn, i0, c1, d2);\
+    OX_STMT_END
+#define cmd_get_p_c(ctxt, c, s0, c1, d2)\
+    OX_STMT_BEGIN\
+        cmd_model_scdC(ctxt, c, OX_BC_get_p_c, s0, c1, d2, add_pc(ctxt, c));\
+    OX_STMT_END
+#define cmd_lt_jf(ctxt, c, s0, s1, l2)\
+    OX_STMT_BEGIN\
+        cmd_model_ssl(ctxt, c, OX_BC_lt_jf, s0, s1, l2);\
+    OX_STMT_END
+#define cmd_gt_jf(ctxt, c, s0, s1, l2)\
+    OX_STMT_BEGIN\
+        cmd_model_ssl(ctxt, c, OX_BC_gt_jf, s0, s1, l2);\
+    OX_STMT_END
+#define cmd_le_jf(ctxt, c, s0, s1, l2)\
+    OX_STMT_BEGIN\
+        cmd_model_ssl(ctxt, c, OX_BC_le_jf, s0, s1, l2);\
+    OX_STMT_END
+#define cmd_ge_jf(ctxt, c, s0, s1, l2)\
+    OX_STMT_BEGIN\
+        cmd_model_ssl(ctxt, c, OX_BC_ge_jf, s0, s1, l2);\
+    OX_STMT_END
+#define cmd_eq_jf(ctxt, c, s0, s1, l2)\
+    OX_STMT_BEGIN\
+        cmd_model_ssl(ctxt, c, OX_BC_eq_jf, s0, s1, l2);\
+    OX_STMT_END
+#define cmd_ne_jf(ctxt, c, s0, s1, l2)\
+    OX_STMT_BEGIN\
+        cmd_model_ssl(ctxt, c, OX_BC_ne_jf, s0, s1, l2);\
+    OX_STMT_END
+#define cmd_call0(ctxt, c, s0, s1, d2)\
+    OX_STMT_BEGIN\
+        cmd_model_ssd(ctxt, c, OX_BC_call0, s0, s1, d2);\
+    OX_STMT_END
+#define cmd_call1(ctxt, c, s0, s1, s2, d3)\
+    OX_STMT_BEGIN\
+        cmd_model_sssd(ctxt, c, OX_BC_call1, s0, s1, s2, d3);\
+    OX_STMT_END
+#define cmd_call2(ctxt, c, s0, s1, s2, s3, d4)\
+    OX_STMT_BEGIN\
+        cmd_model_ssssd(ctxt, c, OX_BC_call2, s0, s1, s2, s3, d4);\
+    OX_STMT_END
+#define cmd_call3(ctxt, c, s0, s1, s2, s3, s4, d5)\
+    OX_STMT_BEGIN\
+        cmd_model_sssssd(ctxt, c, OX_BC_call3, s0, s1, s2, s3, s4, d5);\
+    OX_STMT_END
+#define cmd_p_get_t(ctxt, c, i0)\
+    OX_STMT_BEGIN\
+        cmd_model_i(ctxt, c, OX_BC_p_get_t, i0);\
+    OX_STMT_END
+#define cmd_get_a_t(ctxt, c, i0, i1)\
+    OX_STMT_BEGIN\
+        cmd_model_ii(ctxt, c, OX_BC_get_a_t, i0, i1);\
+    OX_STMT_END
 #define cmd_load_null(ctxt, c, d0)\
     OX_STMT_BEGIN\
         cmd_model_d(ctxt, c, OX_BC_load_null, d0);\
@@ -427,13 +626,41 @@ cmd_model_ps (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int p0, int s1)
     OX_STMT_BEGIN\
         cmd_model_ois(ctxt, c, OX_BC_set_t_b_ac, o0, i1, s2);\
     OX_STMT_END
+#define cmd_cell_t(ctxt, c, i0)\
+    OX_STMT_BEGIN\
+        cmd_model_i(ctxt, c, OX_BC_cell_t, i0);\
+    OX_STMT_END
+#define cmd_get_t_c(ctxt, c, i0, d1)\
+    OX_STMT_BEGIN\
+        cmd_model_id(ctxt, c, OX_BC_get_t_c, i0, d1);\
+    OX_STMT_END
+#define cmd_set_t_c(ctxt, c, i0, s1)\
+    OX_STMT_BEGIN\
+        cmd_model_is(ctxt, c, OX_BC_set_t_c, i0, s1);\
+    OX_STMT_END
+#define cmd_set_t_c_ac(ctxt, c, i0, s1)\
+    OX_STMT_BEGIN\
+        cmd_model_is(ctxt, c, OX_BC_set_t_c_ac, i0, s1);\
+    OX_STMT_END
+#define cmd_get_cap(ctxt, c, i0, d1)\
+    OX_STMT_BEGIN\
+        cmd_model_id(ctxt, c, OX_BC_get_cap, i0, d1);\
+    OX_STMT_END
+#define cmd_set_cap(ctxt, c, i0, s1)\
+    OX_STMT_BEGIN\
+        cmd_model_is(ctxt, c, OX_BC_set_cap, i0, s1);\
+    OX_STMT_END
+#define cmd_set_cap_ac(ctxt, c, i0, s1)\
+    OX_STMT_BEGIN\
+        cmd_model_is(ctxt, c, OX_BC_set_cap_ac, i0, s1);\
+    OX_STMT_END
 #define cmd_get_n(ctxt, c, c0, d1)\
     OX_STMT_BEGIN\
-        cmd_model_cd(ctxt, c, OX_BC_get_n, c0, d1);\
+        cmd_model_cdC(ctxt, c, OX_BC_get_n, c0, d1, add_pc(ctxt, c));\
     OX_STMT_END
 #define cmd_get_g(ctxt, c, c0, d1)\
     OX_STMT_BEGIN\
-        cmd_model_cd(ctxt, c, OX_BC_get_g, c0, d1);\
+        cmd_model_cdC(ctxt, c, OX_BC_get_g, c0, d1, add_pc(ctxt, c));\
     OX_STMT_END
 #define cmd_get_r(ctxt, c, i0, d1)\
     OX_STMT_BEGIN\
@@ -441,15 +668,15 @@ cmd_model_ps (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int p0, int s1)
     OX_STMT_END
 #define cmd_get_p(ctxt, c, s0, s1, d2)\
     OX_STMT_BEGIN\
-        cmd_model_ssd(ctxt, c, OX_BC_get_p, s0, s1, d2);\
+        cmd_model_ssdC(ctxt, c, OX_BC_get_p, s0, s1, d2, add_pc(ctxt, c));\
     OX_STMT_END
 #define cmd_lookup_p(ctxt, c, s0, s1, d2)\
     OX_STMT_BEGIN\
-        cmd_model_ssd(ctxt, c, OX_BC_lookup_p, s0, s1, d2);\
+        cmd_model_ssdC(ctxt, c, OX_BC_lookup_p, s0, s1, d2, add_pc(ctxt, c));\
     OX_STMT_END
 #define cmd_set_p(ctxt, c, s0, s1, s2)\
     OX_STMT_BEGIN\
-        cmd_model_sss(ctxt, c, OX_BC_set_p, s0, s1, s2);\
+        cmd_model_sssC(ctxt, c, OX_BC_set_p, s0, s1, s2, add_pc(ctxt, c));\
     OX_STMT_END
 #define cmd_get_a(ctxt, c, i0, d1)\
     OX_STMT_BEGIN\
@@ -529,23 +756,15 @@ cmd_model_ps (OX_Context *ctxt, OX_Compiler *c, OX_ByteCode ty, int p0, int s1)
         cmd_model_d(ctxt, c, OX_BC_call_end_tail, d0);\
         c->stack_level --;\
     OX_STMT_END
-#define cmd_try_start(ctxt, c, l0, l1)\
+#define cmd_try_end(ctxt, c, l0)\
     OX_STMT_BEGIN\
-        cmd_model_ll(ctxt, c, OX_BC_try_start, l0, l1);\
+        cmd_model_l(ctxt, c, OX_BC_try_end, l0);\
         c->stack_level ++;\
     OX_STMT_END
-#define cmd_try_end(ctxt, c)\
-    OX_STMT_BEGIN\
-        cmd_model_noarg(ctxt, c, OX_BC_try_end);\
-    OX_STMT_END
 #define cmd_catch(ctxt, c, d0)\
     OX_STMT_BEGIN\
         cmd_model_d(ctxt, c, OX_BC_catch, d0);\
     OX_STMT_END
-#define cmd_catch_end(ctxt, c)\
-    OX_STMT_BEGIN\
-        cmd_model_noarg(ctxt, c, OX_BC_catch_end);\
-    OX_STMT_END
 #define cmd_finally(ctxt, c)\
     OX_STMT_BEGIN\
         cmd_model_noarg(ctxt, c, OX_BC_finally);\
@@ -794,6 +1013,29 @@ bytecode_names[] = {
     "and",
     "xor",
     "or",
+    "add_n",
+    "sub_n",
+    "mul_n",
+    "lt_n",
+    "gt_n",
+    "le_n",
+    "ge_n",
+    "eq_n",
+    "ne_n",
+    "get_t_nn",
+    "get_p_c",
+    "lt_jf",
+    "gt_jf",
+    "le_jf",
+    "ge_jf",
+    "eq_jf",
+    "ne_jf",
+    "call0",
+    "call1",
+    "call2",
+    "call3",
+    "p_get_t",
+    "get_a_t",
     "load_null",
     "load_true",
     "load_false",
@@ -810,6 +1052,13 @@ bytecode_names[] = {
     "get_t_b",
     "set_t_b",
     "set_t_b_ac",
+    "cell_t",
+    "get_t_c",
+    "set_t_c",
+    "set_t_c_ac",
+    "get_cap",
+    "set_cap",
+    "set_cap_ac",
     "get_n",
     "get_g",
     "get_r",
@@ -834,10 +1083,8 @@ bytecode_names[] = {
     "arg_spread",
     "call_end",
     "call_end_tail",
-    "try_start",
     "try_end",
     "catch",
-    "catch_end",
     "finally",
     "sched",
     "sched_start",
@@ -925,6 +1172,29 @@ bytecode_models[] = {
     OX_BC_MODEL_ssd,
     OX_BC_MODEL_ssd,
     OX_BC_MODEL_ssd,
+    OX_BC_MODEL_ssd,
+    OX_BC_MODEL_ssd,
+    OX_BC_MODEL_ssd,
+    OX_BC_MODEL_ssd,
+    OX_BC_MODEL_ssd,
+    OX_BC_MODEL_ssd,
+    OX_BC_MODEL_ssd,
+    OX_BC_MODEL_ssd,
+    OX_BC_MODEL_ssd,
+    OX_BC_MODEL_icd,
+    OX_BC_MODEL_scdC,
+    OX_BC_MODEL_ssl,
+    OX_BC_MODEL_ssl,
+    OX_BC_MODEL_ssl,
+    OX_BC_MODEL_ssl,
+    OX_BC_MODEL_ssl,
+    OX_BC_MODEL_ssl,
+    OX_BC_MODEL_ssd,
+    OX_BC_MODEL_sssd,
+    OX_BC_MODEL_ssssd,
+    OX_BC_MODEL_sssssd,
+    OX_BC_MODEL_i,
+    OX_BC_MODEL_ii,
     OX_BC_MODEL_d,
     OX_BC_MODEL_d,
     OX_BC_MODEL_d,
@@ -941,12 +1211,19 @@ bytecode_models[] = {
     OX_BC_MODEL_oid,
     OX_BC_MODEL_ois,
     OX_BC_MODEL_ois,
-    OX_BC_MODEL_cd,
-    OX_BC_MODEL_cd,
+    OX_BC_MODEL_i,
     OX_BC_MODEL_id,
-    OX_BC_MODEL_ssd,
-    OX_BC_MODEL_ssd,
-    OX_BC_MODEL_sss,
+    OX_BC_MODEL_is,
+    OX_BC_MODEL_is,
+    OX_BC_MODEL_id,
+    OX_BC_MODEL_is,
+    OX_BC_MODEL_is,
+    OX_BC_MODEL_cdC,
+    OX_BC_MODEL_cdC,
+    OX_BC_MODEL_id,
+    OX_BC_MODEL_ssdC,
+    OX_BC_MODEL_ssdC,
+    OX_BC_MODEL_sssC,
     OX_BC_MODEL_id,
     OX_BC_MODEL_s,
     OX_BC_MODEL_s,
@@ -965,13 +1242,11 @@ bytecode_models[] = {
     OX_BC_MODEL_s,
     OX_BC_MODEL_d,
     OX_BC_MODEL_d,
-    OX_BC_MODEL_ll,
-    OX_BC_MODEL_noarg,
+    OX_BC_MODEL_l,
     OX_BC_MODEL_d,
     OX_BC_MODEL_noarg,
     OX_BC_MODEL_noarg,
     OX_BC_MODEL_noarg,
-    OX_BC_MODEL_noarg,
     OX_BC_MODEL_sd,
     OX_BC_MODEL_noarg,
     OX_BC_MODEL_s,
@@ -1029,6 +1304,14 @@ bytecode_len_table[] = {
     2,
     3,
     4,
+    6,
+    7,
+    5,
+    5,
+    6,
+    7,
+    3,
+    5,
     3,
     4,
     4,
@@ -1038,14 +1321,16 @@ bytecode_len_table[] = {
     4,
     5,
     5,
-    4,
+    6,
+    6,
+    6,
     3,
     4,
     4,
-    5,
     1,
     4,
     3,
+    4,
     5,
     3,
     4
@@ -1091,6 +1376,62 @@ bytecode_mark_regs (OX_Context *ctxt, OX_Compiler *c, int off, OX_Command *cmd)
         reg = &ox_vector_item(&c->regs, cmd->ssd.d2);
         reg->off = off;
         break;
+    case OX_BC_MODEL_icd:
+        reg = &ox_vector_item(&c->regs, cmd->icd.d2);
+        reg->off = off;
+        break;
+    case OX_BC_MODEL_scdC:
+        reg = &ox_vector_item(&c->regs, cmd->scdC.s0);
+        reg->off = off;
+        reg = &ox_vector_item(&c->regs, cmd->scdC.d2);
+        reg->off = off;
+        break;
+    case OX_BC_MODEL_ssl:
+        reg = &ox_vector_item(&c->regs, cmd->ssl.s0);
+        reg->off = off;
+        reg = &ox_vector_item(&c->regs, cmd->ssl.s1);
+        reg->off = off;
+        break;
+    case OX_BC_MODEL_sssd:
+        reg = &ox_vector_item(&c->regs, cmd->sssd.s0);
+        reg->off = off;
+        reg = &ox_vector_item(&c->regs, cmd->sssd.s1);
+        reg->off = off;
+        reg = &ox_vector_item(&c->regs, cmd->sssd.s2);
+        reg->off = off;
+        reg = &ox_vector_item(&c->regs, cmd->sssd.d3);
+        reg->off = off;
+        break;
+    case OX_BC_MODEL_ssssd:
+        reg = &ox_vector_item(&c->regs, cmd->ssssd.s0);
+        reg->off = off;
+        reg = &ox_vector_item(&c->regs, cmd->ssssd.s1);
+        reg->off = off;
+        reg = &ox_vector_item(&c->regs, cmd->ssssd.s2);
+        reg->off = off;
+        reg = &ox_vector_item(&c->regs, cmd->ssssd.s3);
+        reg->off = off;
+        reg = &ox_vector_item(&c->regs, cmd->ssssd.d4);
+        reg->off = off;
+        break;
+    case OX_BC_MODEL_sssssd:
+        reg = &ox_vector_item(&c->regs, cmd->sssssd.s0);
+        reg->off = off;
+        reg = &ox_vector_item(&c->regs, cmd->sssssd.s1);
+        reg->off = off;
+        reg = &ox_vector_item(&c->regs, cmd->sssssd.s2);
+        reg->off = off;
+        reg = &ox_vector_item(&c->regs, cmd->sssssd.s3);
+        reg->off = off;
+        reg = &ox_vector_item(&c->regs, cmd->sssssd.s4);
+        reg->off = off;
+        reg = &ox_vector_item(&c->regs, cmd->sssssd.d5);
+        reg->off = off;
+        break;
+    case OX_BC_MODEL_i:
+        break;
+    case OX_BC_MODEL_ii:
+        break;
     case OX_BC_MODEL_od:
         reg = &ox_vector_item(&c->regs, cmd->od.d1);
         reg->off = off;
@@ -1127,12 +1468,24 @@ bytecode_mark_regs (OX_Context *ctxt, OX_Compiler *c, int off, OX_Command *cmd)
         reg = &ox_vector_item(&c->regs, cmd->ois.s2);
         reg->off = off;
         break;
-    case OX_BC_MODEL_sss:
-        reg = &ox_vector_item(&c->regs, cmd->sss.s0);
+    case OX_BC_MODEL_cdC:
+        reg = &ox_vector_item(&c->regs, cmd->cdC.d1);
         reg->off = off;
-        reg = &ox_vector_item(&c->regs, cmd->sss.s1);
+        break;
+    case OX_BC_MODEL_ssdC:
+        reg = &ox_vector_item(&c->regs, cmd->ssdC.s0);
         reg->off = off;
-        reg = &ox_vector_item(&c->regs, cmd->sss.s2);
+        reg = &ox_vector_item(&c->regs, cmd->ssdC.s1);
+        reg->off = off;
+        reg = &ox_vector_item(&c->regs, cmd->ssdC.d2);
+        reg->off = off;
+        break;
+    case OX_BC_MODEL_sssC:
+        reg = &ox_vector_item(&c->regs, cmd->sssC.s0);
+        reg->off = off;
+        reg = &ox_vector_item(&c->regs, cmd->sssC.s1);
+        reg->off = off;
+        reg = &ox_vector_item(&c->regs, cmd->sssC.s2);
         reg->off = off;
         break;
     case OX_BC_MODEL_l:
@@ -1143,8 +1496,6 @@ bytecode_mark_regs (OX_Context *ctxt, OX_Compiler *c, int off, OX_Command *cmd)
         reg = &ox_vector_item(&c->regs, cmd->sl.s0);
         reg->off = off;
         break;
-    case OX_BC_MODEL_ll:
-        break;
     case OX_BC_MODEL_noarg:
         break;
     case OX_BC_MODEL_dl:
@@ -1157,6 +1508,14 @@ bytecode_mark_regs (OX_Context *ctxt, OX_Compiler *c, int off, OX_Command *cmd)
         reg = &ox_vector_item(&c->regs, cmd->dd.d1);
         reg->off = off;
         break;
+    case OX_BC_MODEL_sss:
+        reg = &ox_vector_item(&c->regs, cmd->sss.s0);
+        reg->off = off;
+        reg = &ox_vector_item(&c->regs, cmd->sss.s1);
+        reg->off = off;
+        reg = &ox_vector_item(&c->regs, cmd->sss.s2);
+        reg->off = off;
+        break;
     case OX_BC_MODEL_ssss:
         reg = &ox_vector_item(&c->regs, cmd->ssss.s0);
         reg->off = off;
@@ -1248,57 +1607,173 @@ bytecode_alloc_regs (OX_Context *ctxt, OX_Compiler *c, int off, OX_Command *cmd)
                 return OX_ERR;
         }
         break;
-    case OX_BC_MODEL_od:
-        reg = &ox_vector_item(&c->regs, cmd->od.d1);
+    case OX_BC_MODEL_icd:
+        reg = &ox_vector_item(&c->regs, cmd->icd.d2);
         if (reg->id == -1) {
             if ((reg->id = alloc_reg(ctxt, c, off, reg->off)) == -1)
                 return OX_ERR;
         }
         break;
-    case OX_BC_MODEL_cd:
-        reg = &ox_vector_item(&c->regs, cmd->cd.d1);
+    case OX_BC_MODEL_scdC:
+        reg = &ox_vector_item(&c->regs, cmd->scdC.s0);
         if (reg->id == -1) {
             if ((reg->id = alloc_reg(ctxt, c, off, reg->off)) == -1)
                 return OX_ERR;
         }
-        break;
-    case OX_BC_MODEL_pd:
-        reg = &ox_vector_item(&c->regs, cmd->pd.d1);
+        reg = &ox_vector_item(&c->regs, cmd->scdC.d2);
         if (reg->id == -1) {
             if ((reg->id = alloc_reg(ctxt, c, off, reg->off)) == -1)
                 return OX_ERR;
         }
         break;
-    case OX_BC_MODEL_td:
-        reg = &ox_vector_item(&c->regs, cmd->td.d1);
+    case OX_BC_MODEL_ssl:
+        reg = &ox_vector_item(&c->regs, cmd->ssl.s0);
         if (reg->id == -1) {
             if ((reg->id = alloc_reg(ctxt, c, off, reg->off)) == -1)
                 return OX_ERR;
         }
-        break;
-    case OX_BC_MODEL_Td:
-        reg = &ox_vector_item(&c->regs, cmd->Td.d1);
+        reg = &ox_vector_item(&c->regs, cmd->ssl.s1);
         if (reg->id == -1) {
             if ((reg->id = alloc_reg(ctxt, c, off, reg->off)) == -1)
                 return OX_ERR;
         }
         break;
-    case OX_BC_MODEL_id:
-        reg = &ox_vector_item(&c->regs, cmd->id.d1);
+    case OX_BC_MODEL_sssd:
+        reg = &ox_vector_item(&c->regs, cmd->sssd.s0);
         if (reg->id == -1) {
             if ((reg->id = alloc_reg(ctxt, c, off, reg->off)) == -1)
                 return OX_ERR;
         }
-        break;
-    case OX_BC_MODEL_is:
-        reg = &ox_vector_item(&c->regs, cmd->is.s1);
+        reg = &ox_vector_item(&c->regs, cmd->sssd.s1);
         if (reg->id == -1) {
             if ((reg->id = alloc_reg(ctxt, c, off, reg->off)) == -1)
                 return OX_ERR;
         }
-        break;
-    case OX_BC_MODEL_oid:
-        reg = &ox_vector_item(&c->regs, cmd->oid.d2);
+        reg = &ox_vector_item(&c->regs, cmd->sssd.s2);
+        if (reg->id == -1) {
+            if ((reg->id = alloc_reg(ctxt, c, off, reg->off)) == -1)
+                return OX_ERR;
+        }
+        reg = &ox_vector_item(&c->regs, cmd->sssd.d3);
+        if (reg->id == -1) {
+            if ((reg->id = alloc_reg(ctxt, c, off, reg->off)) == -1)
+                return OX_ERR;
+        }
+        break;
+    case OX_BC_MODEL_ssssd:
+        reg = &ox_vector_item(&c->regs, cmd->ssssd.s0);
+        if (reg->id == -1) {
+            if ((reg->id = alloc_reg(ctxt, c, off, reg->off)) == -1)
+                return OX_ERR;
+        }
+        reg = &ox_vector_item(&c->regs, cmd->ssssd.s1);
+        if (reg->id == -1) {
+            if ((reg->id = alloc_reg(ctxt, c, off, reg->off)) == -1)
+                return OX_ERR;
+        }
+        reg = &ox_vector_item(&c->regs, cmd->ssssd.s2);
+        if (reg->id == -1) {
+            if ((reg->id = alloc_reg(ctxt, c, off, reg->off)) == -1)
+                return OX_ERR;
+        }
+        reg = &ox_vector_item(&c->regs, cmd->ssssd.s3);
+        if (reg->id == -1) {
+            if ((reg->id = alloc_reg(ctxt, c, off, reg->off)) == -1)
+                return OX_ERR;
+        }
+        reg = &ox_vector_item(&c->regs, cmd->ssssd.d4);
+        if (reg->id == -1) {
+            if ((reg->id = alloc_reg(ctxt, c, off, reg->off)) == -1)
+                return OX_ERR;
+        }
+        break;
+    case OX_BC_MODEL_sssssd:
+        reg = &ox_vector_item(&c->regs, cmd->sssssd.s0);
+        if (reg->id == -1) {
+            if ((reg->id = alloc_reg(ctxt, c, off, reg->off)) == -1)
+                return OX_ERR;
+        }
+        reg = &ox_vector_item(&c->regs, cmd->sssssd.s1);
+        if (reg->id == -1) {
+            if ((reg->id = alloc_reg(ctxt, c, off, reg->off)) == -1)
+                return OX_ERR;
+        }
+        reg = &ox_vector_item(&c->regs, cmd->sssssd.s2);
+        if (reg->id == -1) {
+            if ((reg->id = alloc_reg(ctxt, c, off, reg->off)) == -1)
+                return OX_ERR;
+        }
+        reg = &ox_vector_item(&c->regs, cmd->sssssd.s3);
+        if (reg->id == -1) {
+            if ((reg->id = alloc_reg(ctxt, c, off, reg->off)) == -1)
+                return OX_ERR;
+        }
+        reg = &ox_vector_item(&c->regs, cmd->sssssd.s4);
+        if (reg->id == -1) {
+            if ((reg->id = alloc_reg(ctxt, c, off, reg->off)) == -1)
+                return OX_ERR;
+        }
+        reg = &ox_vector_item(&c->regs, cmd->sssssd.d5);
+        if (reg->id == -1) {
+            if ((reg->id = alloc_reg(ctxt, c, off, reg->off)) == -1)
+                return OX_ERR;
+        }
+        break;
+    case OX_BC_MODEL_i:
+        break;
+    case OX_BC_MODEL_ii:
+        break;
+    case OX_BC_MODEL_od:
+        reg = &ox_vector_item(&c->regs, cmd->od.d1);
+        if (reg->id == -1) {
+            if ((reg->id = alloc_reg(ctxt, c, off, reg->off)) == -1)
+                return OX_ERR;
+        }
+        break;
+    case OX_BC_MODEL_cd:
+        reg = &ox_vector_item(&c->regs, cmd->cd.d1);
+        if (reg->id == -1) {
+            if ((reg->id = alloc_reg(ctxt, c, off, reg->off)) == -1)
+                return OX_ERR;
+        }
+        break;
+    case OX_BC_MODEL_pd:
+        reg = &ox_vector_item(&c->regs, cmd->pd.d1);
+        if (reg->id == -1) {
+            if ((reg->id = alloc_reg(ctxt, c, off, reg->off)) == -1)
+                return OX_ERR;
+        }
+        break;
+    case OX_BC_MODEL_td:
+        reg = &ox_vector_item(&c->regs, cmd->td.d1);
+        if (reg->id == -1) {
+            if ((reg->id = alloc_reg(ctxt, c, off, reg->off)) == -1)
+                return OX_ERR;
+        }
+        break;
+    case OX_BC_MODEL_Td:
+        reg = &ox_vector_item(&c->regs, cmd->Td.d1);
+        if (reg->id == -1) {
+            if ((reg->id = alloc_reg(ctxt, c, off, reg->off)) == -1)
+                return OX_ERR;
+        }
+        break;
+    case OX_BC_MODEL_id:
+        reg = &ox_vector_item(&c->regs, cmd->id.d1);
+        if (reg->id == -1) {
+            if ((reg->id = alloc_reg(ctxt, c, off, reg->off)) == -1)
+                return OX_ERR;
+        }
+        break;
+    case OX_BC_MODEL_is:
+        reg = &ox_vector_item(&c->regs, cmd->is.s1);
+        if (reg->id == -1) {
+            if ((reg->id = alloc_reg(ctxt, c, off, reg->off)) == -1)
+                return OX_ERR;
+        }
+        break;
+    case OX_BC_MODEL_oid:
+        reg = &ox_vector_item(&c->regs, cmd->oid.d2);
         if (reg->id == -1) {
             if ((reg->id = alloc_reg(ctxt, c, off, reg->off)) == -1)
                 return OX_ERR;
@@ -1311,18 +1786,42 @@ bytecode_alloc_regs (OX_Context *ctxt, OX_Compiler *c, int off, OX_Command *cmd)
                 return OX_ERR;
         }
         break;
-    case OX_BC_MODEL_sss:
-        reg = &ox_vector_item(&c->regs, cmd->sss.s0);
+    case OX_BC_MODEL_cdC:
+        reg = &ox_vector_item(&c->regs, cmd->cdC.d1);
         if (reg->id == -1) {
             if ((reg->id = alloc_reg(ctxt, c, off, reg->off)) == -1)
                 return OX_ERR;
         }
-        reg = &ox_vector_item(&c->regs, cmd->sss.s1);
+        break;
+    case OX_BC_MODEL_ssdC:
+        reg = &ox_vector_item(&c->regs, cmd->ssdC.s0);
         if (reg->id == -1) {
             if ((reg->id = alloc_reg(ctxt, c, off, reg->off)) == -1)
                 return OX_ERR;
         }
-        reg = &ox_vector_item(&c->regs, cmd->sss.s2);
+        reg = &ox_vector_item(&c->regs, cmd->ssdC.s1);
+        if (reg->id == -1) {
+            if ((reg->id = alloc_reg(ctxt, c, off, reg->off)) == -1)
+                return OX_ERR;
+        }
+        reg = &ox_vector_item(&c->regs, cmd->ssdC.d2);
+        if (reg->id == -1) {
+            if ((reg->id = alloc_reg(ctxt, c, off, reg->off)) == -1)
+                return OX_ERR;
+        }
+        break;
+    case OX_BC_MODEL_sssC:
+        reg = &ox_vector_item(&c->regs, cmd->sssC.s0);
+        if (reg->id == -1) {
+            if ((reg->id = alloc_reg(ctxt, c, off, reg->off)) == -1)
+                return OX_ERR;
+        }
+        reg = &ox_vector_item(&c->regs, cmd->sssC.s1);
+        if (reg->id == -1) {
+            if ((reg->id = alloc_reg(ctxt, c, off, reg->off)) == -1)
+                return OX_ERR;
+        }
+        reg = &ox_vector_item(&c->regs, cmd->sssC.s2);
         if (reg->id == -1) {
             if ((reg->id = alloc_reg(ctxt, c, off, reg->off)) == -1)
                 return OX_ERR;
@@ -1339,8 +1838,6 @@ bytecode_alloc_regs (OX_Context *ctxt, OX_Compiler *c, int off, OX_Command *cmd)
                 return OX_ERR;
         }
         break;
-    case OX_BC_MODEL_ll:
-        break;
     case OX_BC_MODEL_noarg:
         break;
     case OX_BC_MODEL_dl:
@@ -1362,6 +1859,23 @@ bytecode_alloc_regs (OX_Context *ctxt, OX_Compiler *c, int off, OX_Command *cmd)
                 return OX_ERR;
         }
         break;
+    case OX_BC_MODEL_sss:
+        reg = &ox_vector_item(&c->regs, cmd->sss.s0);
+        if (reg->id == -1) {
+            if ((reg->id = alloc_reg(ctxt, c, off, reg->off)) == -1)
+                return OX_ERR;
+        }
+        reg = &ox_vector_item(&c->regs, cmd->sss.s1);
+        if (reg->id == -1) {
+            if ((reg->id = alloc_reg(ctxt, c, off, reg->off)) == -1)
+                return OX_ERR;
+        }
+        reg = &ox_vector_item(&c->regs, cmd->sss.s2);
+        if (reg->id == -1) {
+            if ((reg->id = alloc_reg(ctxt, c, off, reg->off)) == -1)
+                return OX_ERR;
+        }
+        break;
     case OX_BC_MODEL_ssss:
         reg = &ox_vector_item(&c->regs, cmd->ssss.s0);
         if (reg->id == -1) {
@@ -1399,6 +1913,197 @@ bytecode_alloc_regs (OX_Context *ctxt, OX_Compiler *c, int off, OX_Command *cmd)
     return r;
 }
 
+/*Get the registers used by the command.*/
+static int
+bytecode_regs (OX_Command *cmd, int **regs, char *types)
+{
+    OX_BcModel m = bytecode_models[cmd->bc];
+
+    switch (m) {
+    case OX_BC_MODEL_sd:
+        regs[0] = &cmd->sd.s0;
+        types[0] = 's';
+        regs[1] = &cmd->sd.d1;
+        types[1] = 'd';
+        return 2;
+    case OX_BC_MODEL_s:
+        regs[0] = &cmd->s.s0;
+        types[0] = 's';
+        return 1;
+    case OX_BC_MODEL_cs:
+        regs[0] = &cmd->cs.s1;
+        types[0] = 's';
+        return 1;
+    case OX_BC_MODEL_d:
+        regs[0] = &cmd->d.d0;
+        types[0] = 'd';
+        return 1;
+    case OX_BC_MODEL_ss:
+        regs[0] = &cmd->ss.s0;
+        types[0] = 's';
+        regs[1] = &cmd->ss.s1;
+        types[1] = 's';
+        return 2;
+    case OX_BC_MODEL_ssd:
+        regs[0] = &cmd->ssd.s0;
+        types[0] = 's';
+        regs[1] = &cmd->ssd.s1;
+        types[1] = 's';
+        regs[2] = &cmd->ssd.d2;
+        types[2] = 'd';
+        return 3;
+    case OX_BC_MODEL_icd:
+        regs[0] = &cmd->icd.d2;
+        types[0] = 'd';
+        return 1;
+    case OX_BC_MODEL_scdC:
+        regs[0] = &cmd->scdC.s0;
+        types[0] = 's';
+        regs[1] = &cmd->scdC.d2;
+        types[1] = 'd';
+        return 2;
+    case OX_BC_MODEL_ssl:
+        regs[0] = &cmd->ssl.s0;
+        types[0] = 's';
+        regs[1] = &cmd->ssl.s1;
+        types[1] = 's';
+        return 2;
+    case OX_BC_MODEL_sssd:
+        regs[0] = &cmd->sssd.s0;
+        types[0] = 's';
+        regs[1] = &cmd->sssd.s1;
+        types[1] = 's';
+        regs[2] = &cmd->sssd.s2;
+        types[2] = 's';
+        regs[3] = &cmd->sssd.d3;
+        types[3] = 'd';
+        return 4;
+    case OX_BC_MODEL_ssssd:
+        regs[0] = &cmd->ssssd.s0;
+        types[0] = 's';
+        regs[1] = &cmd->ssssd.s1;
+        types[1] = 's';
+        regs[2] = &cmd->ssssd.s2;
+        types[2] = 's';
+        regs[3] = &cmd->ssssd.s3;
+        types[3] = 's';
+        regs[4] = &cmd->ssssd.d4;
+        types[4] = 'd';
+        return 5;
+    case OX_BC_MODEL_sssssd:
+        regs[0] = &cmd->sssssd.s0;
+        types[0] = 's';
+        regs[1] = &cmd->sssssd.s1;
+        types[1] = 's';
+        regs[2] = &cmd->sssssd.s2;
+        types[2] = 's';
+        regs[3] = &cmd->sssssd.s3;
+        types[3] = 's';
+        regs[4] = &cmd->sssssd.s4;
+        types[4] = 's';
+        regs[5] = &cmd->sssssd.d5;
+        types[5] = 'd';
+        return 6;
+    case OX_BC_MODEL_od:
+        regs[0] = &cmd->od.d1;
+        types[0] = 'd';
+        return 1;
+    case OX_BC_MODEL_cd:
+        regs[0] = &cmd->cd.d1;
+        types[0] = 'd';
+        return 1;
+    case OX_BC_MODEL_pd:
+        regs[0] = &cmd->pd.d1;
+        types[0] = 'd';
+        return 1;
+    case OX_BC_MODEL_td:
+        regs[0] = &cmd->td.d1;
+        types[0] = 'd';
+        return 1;
+    case OX_BC_MODEL_Td:
+        regs[0] = &cmd->Td.d1;
+        types[0] = 'd';
+        return 1;
+    case OX_BC_MODEL_id:
+        regs[0] = &cmd->id.d1;
+        types[0] = 'd';
+        return 1;
+    case OX_BC_MODEL_is:
+        regs[0] = &cmd->is.s1;
+        types[0] = 's';
+        return 1;
+    case OX_BC_MODEL_oid:
+        regs[0] = &cmd->oid.d2;
+        types[0] = 'd';
+        return 1;
+    case OX_BC_MODEL_ois:
+        regs[0] = &cmd->ois.s2;
+        types[0] = 's';
+        return 1;
+    case OX_BC_MODEL_cdC:
+        regs[0] = &cmd->cdC.d1;
+        types[0] = 'd';
+        return 1;
+    case OX_BC_MODEL_ssdC:
+        regs[0] = &cmd->ssdC.s0;
+        types[0] = 's';
+        regs[1] = &cmd->ssdC.s1;
+        types[1] = 's';
+        regs[2] = &cmd->ssdC.d2;
+        types[2] = 'd';
+        return 3;
+    case OX_BC_MODEL_sssC:
+        regs[0] = &cmd->sssC.s0;
+        types[0] = 's';
+        regs[1] = &cmd->sssC.s1;
+        types[1] = 's';
+        regs[2] = &cmd->sssC.s2;
+        types[2] = 's';
+        return 3;
+    case OX_BC_MODEL_sl:
+        regs[0] = &cmd->sl.s0;
+        types[0] = 's';
+        return 1;
+    case OX_BC_MODEL_dl:
+        regs[0] = &cmd->dl.d0;
+        types[0] = 'd';
+        return 1;
+    case OX_BC_MODEL_dd:
+        regs[0] = &cmd->dd.d0;
+        types[0] = 'd';
+        regs[1] = &cmd->dd.d1;
+        types[1] = 'd';
+        return 2;
+    case OX_BC_MODEL_sss:
+        regs[0] = &cmd->sss.s0;
+        types[0] = 's';
+        regs[1] = &cmd->sss.s1;
+        types[1] = 's';
+        regs[2] = &cmd->sss.s2;
+        types[2] = 's';
+        return 3;
+    case OX_BC_MODEL_ssss:
+        regs[0] = &cmd->ssss.s0;
+        types[0] = 's';
+        regs[1] = &cmd->ssss.s1;
+        types[1] = 's';
+        regs[2] = &cmd->ssss.s2;
+        types[2] = 's';
+        regs[3] = &cmd->ssss.s3;
+        types[3] = 's';
+        return 4;
+    case OX_BC_MODEL_ps:
+        regs[0] = &cmd->ps.s1;
+        types[0] = 's';
+        return 1;
+
+    default:
+        break;
+    }
+
+    return 0;
+}
+
 /*Store the bytecode to buffer.*/
 static void
 bytecode_store (OX_Context *ctxt, OX_Compiler *c, OX_Command *cmd, uint8_t *bc)
@@ -1461,6 +2166,122 @@ bytecode_store (OX_Context *ctxt, OX_Compiler *c, OX_Command *cmd, uint8_t *bc)
         u8 = c->regs.items[id].id;
         *bc ++ = u8;
         break;
+    case OX_BC_MODEL_icd:
+        *bc ++ = cmd->bc;
+        id = cmd->icd.i0;
+        u16 = id;
+        *bc ++ = u16 >> 8;
+        *bc ++ = u16 & 0xff;
+        id = cmd->icd.c1;
+        u16 = id;
+        *bc ++ = u16 >> 8;
+        *bc ++ = u16 & 0xff;
+        id = cmd->icd.d2;
+        u8 = c->regs.items[id].id;
+        *bc ++ = u8;
+        break;
+    case OX_BC_MODEL_scdC:
+        *bc ++ = cmd->bc;
+        id = cmd->scdC.s0;
+        u8 = c->regs.items[id].id;
+        *bc ++ = u8;
+        id = cmd->scdC.c1;
+        u16 = id;
+        *bc ++ = u16 >> 8;
+        *bc ++ = u16 & 0xff;
+        id = cmd->scdC.d2;
+        u8 = c->regs.items[id].id;
+        *bc ++ = u8;
+        id = cmd->scdC.C3;
+        u16 = id;
+        *bc ++ = u16 >> 8;
+        *bc ++ = u16 & 0xff;
+        break;
+    case OX_BC_MODEL_ssl:
+        *bc ++ = cmd->bc;
+        id = cmd->ssl.s0;
+        u8 = c->regs.items[id].id;
+        *bc ++ = u8;
+        id = cmd->ssl.s1;
+        u8 = c->regs.items[id].id;
+        *bc ++ = u8;
+        id = cmd->ssl.l2;
+        u16 = c->labels.items[id].off;
+        *bc ++ = u16 >> 8;
+        *bc ++ = u16 & 0xff;
+        break;
+    case OX_BC_MODEL_sssd:
+        *bc ++ = cmd->bc;
+        id = cmd->sssd.s0;
+        u8 = c->regs.items[id].id;
+        *bc ++ = u8;
+        id = cmd->sssd.s1;
+        u8 = c->regs.items[id].id;
+        *bc ++ = u8;
+        id = cmd->sssd.s2;
+        u8 = c->regs.items[id].id;
+        *bc ++ = u8;
+        id = cmd->sssd.d3;
+        u8 = c->regs.items[id].id;
+        *bc ++ = u8;
+        break;
+    case OX_BC_MODEL_ssssd:
+        *bc ++ = cmd->bc;
+        id = cmd->ssssd.s0;
+        u8 = c->regs.items[id].id;
+        *bc ++ = u8;
+        id = cmd->ssssd.s1;
+        u8 = c->regs.items[id].id;
+        *bc ++ = u8;
+        id = cmd->ssssd.s2;
+        u8 = c->regs.items[id].id;
+        *bc ++ = u8;
+        id = cmd->ssssd.s3;
+        u8 = c->regs.items[id].id;
+        *bc ++ = u8;
+        id = cmd->ssssd.d4;
+        u8 = c->regs.items[id].id;
+        *bc ++ = u8;
+        break;
+    case OX_BC_MODEL_sssssd:
+        *bc ++ = cmd->bc;
+        id = cmd->sssssd.s0;
+        u8 = c->regs.items[id].id;
+        *bc ++ = u8;
+        id = cmd->sssssd.s1;
+        u8 = c->regs.items[id].id;
+        *bc ++ = u8;
+        id = cmd->sssssd.s2;
+        u8 = c->regs.items[id].id;
+        *bc ++ = u8;
+        id = cmd->sssssd.s3;
+        u8 = c->regs.items[id].id;
+        *bc ++ = u8;
+        id = cmd->sssssd.s4;
+        u8 = c->regs.items[id].id;
+        *bc ++ = u8;
+        id = cmd->sssssd.d5;
+        u8 = c->regs.items[id].id;
+        *bc ++ = u8;
+        break;
+    case OX_BC_MODEL_i:
+        *bc ++ = cmd->bc;
+        id = cmd->i.i0;
+        u16 = id;
+        *bc ++ = u16 >> 8;
+        *bc ++ = u16 & 0xff;
+        break;
+    case OX_BC_MODEL_ii:
+        *bc ++ = cmd->bc;
+        id = cmd->ii.i0;
+        u16 = id;
+        *bc ++ = u16 >> 8;
+        *bc ++ = u16 & 0xff;
+        id = cmd->ii.i1;
+        u16 = id;
+        *bc ++ = u16 >> 8;
+        *bc ++ = u16 & 0xff;
+        break;
     case OX_BC_MODEL_od:
         *bc ++ = cmd->bc;
         id = cmd->od.o0;
@@ -1556,17 +2377,51 @@ bytecode_store (OX_Context *ctxt, OX_Compiler *c, OX_Command *cmd, uint8_t *bc)
         u8 = c->regs.items[id].id;
         *bc ++ = u8;
         break;
-    case OX_BC_MODEL_sss:
+    case OX_BC_MODEL_cdC:
         *bc ++ = cmd->bc;
-        id = cmd->sss.s0;
+        id = cmd->cdC.c0;
+        u16 = id;
+        *bc ++ = u16 >> 8;
+        *bc ++ = u16 & 0xff;
+        id = cmd->cdC.d1;
         u8 = c->regs.items[id].id;
         *bc ++ = u8;
-        id = cmd->sss.s1;
+        id = cmd->cdC.C2;
+        u16 = id;
+        *bc ++ = u16 >> 8;
+        *bc ++ = u16 & 0xff;
+        break;
+    case OX_BC_MODEL_ssdC:
+        *bc ++ = cmd->bc;
+        id = cmd->ssdC.s0;
         u8 = c->regs.items[id].id;
         *bc ++ = u8;
-        id = cmd->sss.s2;
+        id = cmd->ssdC.s1;
+        u8 = c->regs.items[id].id;
+        *bc ++ = u8;
+        id = cmd->ssdC.d2;
+        u8 = c->regs.items[id].id;
+        *bc ++ = u8;
+        id = cmd->ssdC.C3;
+        u16 = id;
+        *bc ++ = u16 >> 8;
+        *bc ++ = u16 & 0xff;
+        break;
+    case OX_BC_MODEL_sssC:
+        *bc ++ = cmd->bc;
+        id = cmd->sssC.s0;
+        u8 = c->regs.items[id].id;
+        *bc ++ = u8;
+        id = cmd->sssC.s1;
         u8 = c->regs.items[id].id;
         *bc ++ = u8;
+        id = cmd->sssC.s2;
+        u8 = c->regs.items[id].id;
+        *bc ++ = u8;
+        id = cmd->sssC.C3;
+        u16 = id;
+        *bc ++ = u16 >> 8;
+        *bc ++ = u16 & 0xff;
         break;
     case OX_BC_MODEL_l:
         *bc ++ = cmd->bc;
@@ -1595,17 +2450,6 @@ bytecode_store (OX_Context *ctxt, OX_Compiler *c, OX_Command *cmd, uint8_t *bc)
         *bc ++ = u16 >> 8;
         *bc ++ = u16 & 0xff;
         break;
-    case OX_BC_MODEL_ll:
-        *bc ++ = cmd->bc;
-        id = cmd->ll.l0;
-        u16 = c->labels.items[id].off;
-        *bc ++ = u16 >> 8;
-        *bc ++ = u16 & 0xff;
-        id = cmd->ll.l1;
-        u16 = c->labels.items[id].off;
-        *bc ++ = u16 >> 8;
-        *bc ++ = u16 & 0xff;
-        break;
     case OX_BC_MODEL_noarg:
         *bc ++ = cmd->bc;
         break;
@@ -1628,6 +2472,18 @@ bytecode_store (OX_Context *ctxt, OX_Compiler *c, OX_Command *cmd, uint8_t *bc)
         u8 = c->regs.items[id].id;
         *bc ++ = u8;
         break;
+    case OX_BC_MODEL_sss:
+        *bc ++ = cmd->bc;
+        id = cmd->sss.s0;
+        u8 = c->regs.items[id].id;
+        *bc ++ = u8;
+        id = cmd->sss.s1;
+        u8 = c->regs.items[id].id;
+        *bc ++ = u8;
+        id = cmd->sss.s2;
+        u8 = c->regs.items[id].id;
+        *bc ++ = u8;
+        break;
     case OX_BC_MODEL_ssss:
         *bc ++ = cmd->bc;
         id = cmd->ssss.s0;
@@ -1713,6 +2569,90 @@ bytecode_decompile (OX_Context *ctxt, OX_BcScript *s, uint8_t *bc, FILE *fp)
         u8 = *bc ++;
         fprintf(fp, "r%d ", u8);
         break;
+    case OX_BC_MODEL_icd:
+        u16 = (bc[0] << 8) | bc[1];
+        bc += 2;
+        fprintf(fp, "%d ", u16);
+        u16 = (bc[0] << 8) | bc[1];
+        bc += 2;
+        fprintf(fp, "c%d(", u16);
+        dump_const(ctxt, s, u16, fp);
+        fprintf(fp, ") ");
+        u8 = *bc ++;
+        fprintf(fp, "r%d ", u8);
+        break;
+    case OX_BC_MODEL_scdC:
+        u8 = *bc ++;
+        fprintf(fp, "r%d ", u8);
+        u16 = (bc[0] << 8) | bc[1];
+        bc += 2;
+        fprintf(fp, "c%d(", u16);
+        dump_const(ctxt, s, u16, fp);
+        fprintf(fp, ") ");
+        u8 = *bc ++;
+        fprintf(fp, "r%d ", u8);
+        u16 = (bc[0] << 8) | bc[1];
+        bc += 2;
+        fprintf(fp, "C%d ", u16);
+        break;
+    case OX_BC_MODEL_ssl:
+        u8 = *bc ++;
+        fprintf(fp, "r%d ", u8);
+        u8 = *bc ++;
+        fprintf(fp, "r%d ", u8);
+        u16 = (bc[0] << 8) | bc[1];
+        bc += 2;
+        fprintf(fp, "%d ", u16);
+        break;
+    case OX_BC_MODEL_sssd:
+        u8 = *bc ++;
+        fprintf(fp, "r%d ", u8);
+        u8 = *bc ++;
+        fprintf(fp, "r%d ", u8);
+        u8 = *bc ++;
+        fprintf(fp, "r%d ", u8);
+        u8 = *bc ++;
+        fprintf(fp, "r%d ", u8);
+        break;
+    case OX_BC_MODEL_ssssd:
+        u8 = *bc ++;
+        fprintf(fp, "r%d ", u8);
+        u8 = *bc ++;
+        fprintf(fp, "r%d ", u8);
+        u8 = *bc ++;
+        fprintf(fp, "r%d ", u8);
+        u8 = *bc ++;
+        fprintf(fp, "r%d ", u8);
+        u8 = *bc ++;
+        fprintf(fp, "r%d ", u8);
+        break;
+    case OX_BC_MODEL_sssssd:
+        u8 = *bc ++;
+        fprintf(fp, "r%d ", u8);
+        u8 = *bc ++;
+        fprintf(fp, "r%d ", u8);
+        u8 = *bc ++;
+        fprintf(fp, "r%d ", u8);
+        u8 = *bc ++;
+        fprintf(fp, "r%d ", u8);
+        u8 = *bc ++;
+        fprintf(fp, "r%d ", u8);
+        u8 = *bc ++;
+        fprintf(fp, "r%d ", u8);
+        break;
+    case OX_BC_MODEL_i:
+        u16 = (bc[0] << 8) | bc[1];
+        bc += 2;
+        fprintf(fp, "%d ", u16);
+        break;
+    case OX_BC_MODEL_ii:
+        u16 = (bc[0] << 8) | bc[1];
+        bc += 2;
+        fprintf(fp, "%d ", u16);
+        u16 = (bc[0] << 8) | bc[1];
+        bc += 2;
+        fprintf(fp, "%d ", u16);
+        break;
     case OX_BC_MODEL_od:
         u8 = *bc ++;
         fprintf(fp, "%d ", u8);
@@ -1787,13 +2727,39 @@ bytecode_decompile (OX_Context *ctxt, OX_BcScript *s, uint8_t *bc, FILE *fp)
         u8 = *bc ++;
         fprintf(fp, "r%d ", u8);
         break;
-    case OX_BC_MODEL_sss:
+    case OX_BC_MODEL_cdC:
+        u16 = (bc[0] << 8) | bc[1];
+        bc += 2;
+        fprintf(fp, "c%d(", u16);
+        dump_const(ctxt, s, u16, fp);
+        fprintf(fp, ") ");
+        u8 = *bc ++;
+        fprintf(fp, "r%d ", u8);
+        u16 = (bc[0] << 8) | bc[1];
+        bc += 2;
+        fprintf(fp, "C%d ", u16);
+        break;
+    case OX_BC_MODEL_ssdC:
         u8 = *bc ++;
         fprintf(fp, "r%d ", u8);
         u8 = *bc ++;
         fprintf(fp, "r%d ", u8);
         u8 = *bc ++;
         fprintf(fp, "r%d ", u8);
+        u16 = (bc[0] << 8) | bc[1];
+        bc += 2;
+        fprintf(fp, "C%d ", u16);
+        break;
+    case OX_BC_MODEL_sssC:
+        u8 = *bc ++;
+        fprintf(fp, "r%d ", u8);
+        u8 = *bc ++;
+        fprintf(fp, "r%d ", u8);
+        u8 = *bc ++;
+        fprintf(fp, "r%d ", u8);
+        u16 = (bc[0] << 8) | bc[1];
+        bc += 2;
+        fprintf(fp, "C%d ", u16);
         break;
     case OX_BC_MODEL_l:
         u16 = (bc[0] << 8) | bc[1];
@@ -1814,14 +2780,6 @@ bytecode_decompile (OX_Context *ctxt, OX_BcScript *s, uint8_t *bc, FILE *fp)
         bc += 2;
         fprintf(fp, "%d ", u16);
         break;
-    case OX_BC_MODEL_ll:
-        u16 = (bc[0] << 8) | bc[1];
-        bc += 2;
-        fprintf(fp, "%d ", u16);
-        u16 = (bc[0] << 8) | bc[1];
-        bc += 2;
-        fprintf(fp, "%d ", u16);
-        break;
     case OX_BC_MODEL_noarg:
         break;
     case OX_BC_MODEL_dl:
@@ -1837,6 +2795,14 @@ bytecode_decompile (OX_Context *ctxt, OX_BcScript *s, uint8_t *bc, FILE *fp)
         u8 = *bc ++;
         fprintf(fp, "r%d ", u8);
         break;
+    case OX_BC_MODEL_sss:
+        u8 = *bc ++;
+        fprintf(fp, "r%d ", u8);
+        u8 = *bc ++;
+        fprintf(fp, "r%d ", u8);
+        u8 = *bc ++;
+        fprintf(fp, "r%d ", u8);
+        break;
     case OX_BC_MODEL_ssss:
         u8 = *bc ++;
         fprintf(fp, "r%d ", u8);
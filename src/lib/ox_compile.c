@@ -46,12 +46,24 @@ typedef struct {
 typedef struct {
     int off;         /**< Offset of the label.*/
     int stack_level; /**< The stack level of the label.*/
+    int finally_level; /**< Number of the try blocks with finally block contain the label.*/
 } OX_CompLabel;
 
+/** Compiler try statement.*/
+typedef struct {
+    int start_label;   /**< Start label of the try block.*/
+    int catch_label;   /**< Catch block label.*/
+    int finally_label; /**< Finally block label.*/
+    int stack_level;   /**< The stack level of the try statement.*/
+    int flags;         /**< Flags.*/
+} OX_CompTry;
+
 /** Compiler register.*/
 typedef struct {
     int id;  /**< Register.*/
     int off; /**< The offset where reference this register.*/
+    int def_cnt; /**< Number of commands writing this register.*/
+    int use_cnt; /**< Number of commands reading this register.*/
 } OX_CompRegister;
 
 /** Compiler data.*/
@@ -69,6 +81,8 @@ typedef struct {
     OX_VECTOR_TYPE_DECL(OX_CompRegister) regs;   /**< Registers array.*/
     OX_VECTOR_TYPE_DECL(uint8_t)         bc;     /**< Byte code buffer.*/
     OX_VECTOR_TYPE_DECL(OX_ScriptLoc)    ltab;   /**< Location table.*/
+    OX_VECTOR_TYPE_DECL(OX_CompTry)      tries;  /**< Try statements of the current function.*/
+    OX_VECTOR_TYPE_DECL(OX_ScriptTry)    ttab;   /**< Exception handling table.*/
     int            break_label;    /**< Break label.*/
     int            continue_label; /**< Continue label.*/
     int            ques_label;     /**< Question null check label.*/
@@ -79,6 +93,9 @@ typedef struct {
     int            this_r;  /**< This register.*/
     int            owned_num;      /**< Number of owned objects.*/
     int            stack_level;    /**< The current stack level.*/
+    int            finally_level;  /**< Number of the try blocks with finally block contain the current command.*/
+    int            pc_num;  /**< Number of property caches.*/
+    OX_Value      *folded;  /**< Values generated by constant folding.*/
     OX_Location    loc;     /**< The current location.*/
 } OX_Compiler;
 
@@ -89,6 +106,13 @@ typedef enum {
     OX_DECL_SCOPE_TEMP    /**< Temporary declaration.*/
 } OX_DeclScope;
 
+/** Declaration access mode.*/
+typedef enum {
+    OX_DECL_ACC_LOCAL,   /**< Local declaration in the current frame.*/
+    OX_DECL_ACC_CAPTURE, /**< Value captured by the current function.*/
+    OX_DECL_ACC_FRAME    /**< Declaration in a referenced script frame.*/
+} OX_DeclAccess;
+
 /** Assignment left expression type.*/
 typedef enum {
     OX_ASSI_LEFT_GLOBAL, /**< Global declaration.*/
@@ -107,7 +131,8 @@ typedef struct {
     int             br_id; /**< Base value register's index.*/
     int             pr_id; /**< Property key register's index.*/
     OX_ScriptDecl  *decl;  /**< The declaration.*/
-    int             depth; /**< Declaration depth.*/
+    OX_DeclAccess   acc;   /**< Declaration access mode.*/
+    int             acc_id;/**< Captured value's index or referenced frame's offset.*/
     OX_Location     loc;   /**< Location.*/
 } OX_AssiLeft;
 
@@ -154,6 +179,8 @@ compiler_init (OX_Context *ctxt, OX_Compiler *c, OX_Input *input, int flags)
     c->bot_frame_num = 0;
     c->this_r = -1;
     c->owned_num = 0;
+    c->pc_num = 0;
+    c->folded = NULL;
 
     ox_value_hash_init(&c->cv_hash);
     ox_value_hash_init(&c->pp_hash);
@@ -164,6 +191,8 @@ compiler_init (OX_Context *ctxt, OX_Compiler *c, OX_Input *input, int flags)
     ox_vector_init(&c->regs);
     ox_vector_init(&c->bc);
     ox_vector_init(&c->ltab);
+    ox_vector_init(&c->tries);
+    ox_vector_init(&c->ttab);
 
     if (flags & OX_COMPILE_FL_CURR) {
         OX_Frame *fr = ox_frame_get(ctxt);
@@ -208,6 +237,8 @@ compiler_deinit (OX_Context *ctxt, OX_Compiler *c)
     ox_vector_deinit(ctxt, &c->regs);
     ox_vector_deinit(ctxt, &c->bc);
     ox_vector_deinit(ctxt, &c->ltab);
+    ox_vector_deinit(ctxt, &c->tries);
+    ox_vector_deinit(ctxt, &c->ttab);
 }
 
 /*Output error prompt message.*/
@@ -336,6 +367,17 @@ add_cv (OX_Context *ctxt, OX_Compiler *c, OX_Value *v)
     return ent->id;
 }
 
+/*Add a property cache.*/
+static int
+add_pc (OX_Context *ctxt, OX_Compiler *c)
+{
+    /*Too many property accessing instructions share the last cache.*/
+    if (c->pc_num > 0xffff)
+        return 0xffff;
+
+    return c->pc_num ++;
+}
+
 /*Add a private property name.*/
 static int
 add_pp (OX_Context *ctxt, OX_Compiler *c, OX_Value *v)
@@ -413,6 +455,7 @@ add_label_l (OX_Context *ctxt, OX_Compiler *c, int sl)
     l = &ox_vector_item(&c->labels, id);
     l->off = -1;
     l->stack_level = c->stack_level + sl;
+    l->finally_level = c->finally_level;
 
     return id;
 }
@@ -716,13 +759,119 @@ curr_object_to_cmds (OX_Context *ctxt, OX_Compiler *c, OX_Value *e, int er)
     cmd_curr(ctxt, c, er);
 }
 
+/*Get the outer function of the function.*/
+static OX_Bool
+outer_func (OX_Context *ctxt, OX_Value *f, OX_Value *outer)
+{
+    OX_VS_PUSH(ctxt, id)
+    OX_Bool r = OX_FALSE;
+
+    AST_GET(f, outer, outer);
+
+    while (!ox_value_is_null(ctxt, outer)) {
+        AST_GET(outer, id, id);
+        if (!ox_value_is_null(ctxt, id)) {
+            r = OX_TRUE;
+            break;
+        }
+
+        AST_GET(outer, outer, outer);
+    }
+
+    OX_VS_POP(ctxt, id)
+    return r;
+}
+
+/*Get the script function of the function AST.*/
+static OX_ScriptFunc*
+func_sfunc (OX_Context *ctxt, OX_Compiler *c, OX_Value *f)
+{
+    size_t fid = AST_GET_N(f, id);
+
+    return &c->s->sfuncs[fid];
+}
+
+/*Add a captured value to the script function.*/
+static int
+add_capture (OX_Context *ctxt, OX_ScriptFunc *sf, OX_ScriptDecl *decl, OX_ScriptCapType type, int id)
+{
+    OX_ScriptCapture *cap;
+    int i;
+
+    for (i = 0; i < sf->cap_num; i ++) {
+        cap = &sf->caps[i];
+
+        if ((cap->type == type) && (cap->id == id))
+            return i;
+    }
+
+    assert(sf->cap_num < 0xffff);
+
+    cap = OX_RENEW(ctxt, sf->caps, sf->cap_num, sf->cap_num + 1);
+    ox_not_null(cap);
+
+    sf->caps = cap;
+    cap += sf->cap_num;
+    cap->decl = decl;
+    cap->type = type;
+    cap->id = id;
+
+    return sf->cap_num ++;
+}
+
+/*Capture the value into the function.
+ *The value is the source of the function at the outer level "depth",
+ *the functions between them capture the value too.*/
+static int
+capture (OX_Context *ctxt, OX_Compiler *c, OX_Value *f, int depth,
+        OX_ScriptDecl *decl, OX_ScriptCapType type, int id)
+{
+    OX_VS_PUSH(ctxt, outer)
+    int cid;
+
+    if (depth > 1) {
+        ox_not_error(outer_func(ctxt, f, outer));
+
+        id = capture(ctxt, c, outer, depth - 1, decl, type, id);
+        type = OX_SCRIPT_CAP_OUTER;
+    }
+
+    cid = add_capture(ctxt, func_sfunc(ctxt, c, f), decl, type, id);
+
+    OX_VS_POP(ctxt, outer)
+    return cid;
+}
+
+/*Lookup the captured value in the function by its declaration's name.
+ *If s is NULL, lookup the captured this argument.*/
+static int
+capture_lookup (OX_ScriptFunc *sf, OX_String *s)
+{
+    int i;
+
+    for (i = 0; i < sf->cap_num; i ++) {
+        OX_ScriptCapture *cap = &sf->caps[i];
+
+        if (s) {
+            if (cap->decl && (cap->decl->he.key == s))
+                return i;
+        } else if (!cap->decl) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
 /*this argument to commands.*/
 static void
 this_to_cmds (OX_Context *ctxt, OX_Compiler *c, OX_Value *e, int er)
 {
-    OX_VS_PUSH_3(ctxt, f, bot, id)
+    OX_VS_PUSH_2(ctxt, f, bot)
     int depth = 0;
     OX_Bool found = OX_FALSE;
+    OX_Bool is_entry = OX_FALSE;
+    int cid = -1, off = -1;
     OX_Location loc;
 
     if (c->this_r != -1) {
@@ -733,64 +882,69 @@ this_to_cmds (OX_Context *ctxt, OX_Compiler *c, OX_Value *e, int er)
     ox_value_copy(ctxt, f, c->f);
 
     while (1) {
-        AST_GET(f, id, id);
-
-        if (!ox_value_is_null(ctxt, id)) {
-            if (AST_GET_B(f, this)) {
-                found = OX_TRUE;
-                break;
-            }
+        is_entry = !outer_func(ctxt, f, bot);
 
-            depth ++;
+        if (AST_GET_B(f, this)) {
+            found = OX_TRUE;
+            break;
         }
 
-        AST_GET(f, outer, bot);
+        depth ++;
 
-        if (ox_value_is_null(ctxt, bot))
+        if (is_entry)
             break;
 
         ox_value_copy(ctxt, f, bot);
     }
 
-    if (!found && (c->flags & OX_COMPILE_FL_CURR)) {
+    if (found) {
+        if (depth && is_entry) {
+            /*The this argument of the script's entry function is in its frame.*/
+            off = 0;
+        } else if (depth) {
+            cid = capture(ctxt, c, c->f, depth, NULL, OX_SCRIPT_CAP_THIS, 0);
+        }
+    } else if (c->flags & OX_COMPILE_FL_CURR) {
         /*Lookup in the running function.*/
         OX_Frame *frame = ox_frame_get(ctxt);
         OX_Function *bf;
 
         if (frame) {
-            depth ++;
+            int base = (depth > 1) ? 1 : 0;
 
             bf = ox_value_get_gco(ctxt, &frame->func);
-            if (bf->sfunc->flags & OX_SCRIPT_FUNC_FL_THIS)
+            if (bf->sfunc->flags & OX_SCRIPT_FUNC_FL_THIS) {
+                off = base;
+                found = OX_TRUE;
+            } else if ((cid = capture_lookup(bf->sfunc, NULL)) != -1) {
+                cid = capture(ctxt, c, c->f, depth, NULL, OX_SCRIPT_CAP_OUTER, cid);
                 found = OX_TRUE;
+            } else {
+                int i;
 
-            if (!found) {
-                OX_Frame **cf = bf->frames;
-                OX_Frame **ef = cf + bf->sfunc->frame_num;
+                for (i = 0; i < bf->sfunc->frame_num; i ++) {
+                    OX_Function *ff = ox_value_get_gco(ctxt, &bf->frames[i]->func);
 
-                while (cf < ef) {
-                    frame = *cf;
-                    depth ++;
-                    
-                    bf = ox_value_get_gco(ctxt, &frame->func);
-                    if (bf->sfunc->flags & OX_SCRIPT_FUNC_FL_THIS) {
+                    if (ff->sfunc->flags & OX_SCRIPT_FUNC_FL_THIS) {
+                        off = base + 1 + i;
                         found = OX_TRUE;
                         break;
                     }
-
-                    cf ++;
                 }
             }
         }
     }
-    
+
     GET_LOC(e, &loc);
 
     if (!found) {
         error(ctxt, c, &loc, OX_TEXT("the function has not this argument"));
-    } else if (depth) {
+    } else if (off != -1) {
         set_loc(c, &loc);
-        cmd_this_b(ctxt, c, depth - 1, er);
+        cmd_this_b(ctxt, c, off, er);
+    } else if (cid != -1) {
+        set_loc(c, &loc);
+        cmd_get_cap(ctxt, c, cid, er);
     } else {
         set_loc(c, &loc);
         cmd_this(ctxt, c, er);
@@ -1100,15 +1254,21 @@ value_to_cmds (OX_Context *ctxt, OX_Compiler *c, OX_Value *e, int er)
     OX_VS_POP(ctxt, v)
 }
 
-/*Lookup the declaration*/
+/*Lookup the declaration.
+ *The declarations of the script's entry function are accessed through its frame,
+ *the declarations of the other outer functions are captured.
+ *If "write" is true, the declaration captured is stored in a cell.*/
 static OX_ScriptDecl*
-decl_lookup (OX_Context *ctxt, OX_Compiler *c, OX_Value *k, int *pdepth)
+decl_lookup (OX_Context *ctxt, OX_Compiler *c, OX_Value *k, OX_Bool write,
+        OX_DeclAccess *pacc, int *pid)
 {
-    OX_VS_PUSH_3(ctxt, func, bot, id)
+    OX_VS_PUSH_2(ctxt, func, bot)
     OX_ScriptFunc *sf = c->sf;
-    OX_ScriptDecl *sd;
+    OX_ScriptDecl *sd = NULL;
+    OX_DeclAccess acc = OX_DECL_ACC_LOCAL;
     int depth = 0;
-    size_t fid;
+    int id = -1;
+    OX_Bool is_entry;
     OX_String *s;
 
     ox_not_error(ox_string_singleton(ctxt, k));
@@ -1116,49 +1276,70 @@ decl_lookup (OX_Context *ctxt, OX_Compiler *c, OX_Value *k, int *pdepth)
     ox_value_copy(ctxt, func, c->f);
 
     while (1) {
-        AST_GET(func, id, id);
-        if (!ox_value_is_null(ctxt, id)) {
-            sd = ox_hash_lookup_c(ctxt, &sf->decl_hash, s, NULL, OX_ScriptDecl, he);
-            if (sd)
-                break;
+        is_entry = !outer_func(ctxt, func, bot);
 
-            depth ++;
-        }
+        sf = func_sfunc(ctxt, c, func);
+        sd = ox_hash_lookup_c(ctxt, &sf->decl_hash, s, NULL, OX_ScriptDecl, he);
+        if (sd)
+            break;
+
+        depth ++;
 
-        AST_GET(func, outer, bot);
-        if (ox_value_is_null(ctxt, bot))
+        if (is_entry)
             break;
 
         ox_value_copy(ctxt, func, bot);
-        fid = AST_GET_N(func, id);
-        sf = &c->s->sfuncs[fid];
     }
 
-    if (!sd && (c->flags & OX_COMPILE_FL_CURR)) {
+    if (sd) {
+        if (depth && is_entry) {
+            acc = OX_DECL_ACC_FRAME;
+            id = 0;
+        } else if (depth) {
+            /*The declaration is referenced by an inner function.*/
+            sd->type |= OX_DECL_CAPTURED;
+            if (write)
+                sd->type |= OX_DECL_BOXED;
+
+            acc = OX_DECL_ACC_CAPTURE;
+            id = capture(ctxt, c, c->f, depth, sd, OX_SCRIPT_CAP_LOCAL, sd->id);
+        }
+    } else if (c->flags & OX_COMPILE_FL_CURR) {
         /*Lookup in the running function.*/
         OX_Frame *frame = ox_frame_get(ctxt);
         OX_Function *bf;
 
         if (frame) {
+            int base = (depth > 1) ? 1 : 0;
+
             bf = ox_value_get_gco(ctxt, &frame->func);
             sf = bf->sfunc;
             sd = ox_hash_lookup_c(ctxt, &sf->decl_hash, s, NULL, OX_ScriptDecl, he);
 
-            if (!sd) {
-                OX_Frame **cf = bf->frames;
-                OX_Frame **ef = cf + sf->frame_num;
+            if (sd) {
+                if (sd->type & OX_DECL_BOXED) {
+                    acc = OX_DECL_ACC_CAPTURE;
+                    id = capture(ctxt, c, c->f, depth, sd, OX_SCRIPT_CAP_LOCAL, sd->id);
+                } else {
+                    acc = OX_DECL_ACC_FRAME;
+                    id = base;
+                }
+            } else if ((id = capture_lookup(sf, s)) != -1) {
+                sd = sf->caps[id].decl;
+                acc = OX_DECL_ACC_CAPTURE;
+                id = capture(ctxt, c, c->f, depth, sd, OX_SCRIPT_CAP_OUTER, id);
+            } else {
+                int i;
 
-                while (cf < ef) {
-                    frame = *cf;
-                    depth ++;
+                for (i = 0; i < sf->frame_num; i ++) {
+                    OX_Function *ff = ox_value_get_gco(ctxt, &bf->frames[i]->func);
 
-                    bf = ox_value_get_gco(ctxt, &frame->func);
-                    sf = bf->sfunc;
-                    sd = ox_hash_lookup_c(ctxt, &sf->decl_hash, s, NULL, OX_ScriptDecl, he);
-                    if (sd)
+                    sd = ox_hash_lookup_c(ctxt, &ff->sfunc->decl_hash, s, NULL, OX_ScriptDecl, he);
+                    if (sd) {
+                        acc = OX_DECL_ACC_FRAME;
+                        id = base + 1 + i;
                         break;
-
-                    cf ++;
+                    }
                 }
             }
         }
@@ -1166,8 +1347,10 @@ decl_lookup (OX_Context *ctxt, OX_Compiler *c, OX_Value *k, int *pdepth)
 
     OX_VS_POP(ctxt, func)
 
-    if (pdepth)
-        *pdepth = depth;
+    if (pacc)
+        *pacc = acc;
+    if (pid)
+        *pid = id;
 
     return sd;
 }
@@ -1178,7 +1361,8 @@ id_to_cmds (OX_Context *ctxt, OX_Compiler *c, OX_Value *e, int er)
 {
     OX_VS_PUSH(ctxt, id)
     OX_ScriptDecl *sd;
-    int depth = 0;
+    OX_DeclAccess acc;
+    int acc_id;
     OX_Location loc;
 
     AST_GET(e, value, id);
@@ -1186,13 +1370,22 @@ id_to_cmds (OX_Context *ctxt, OX_Compiler *c, OX_Value *e, int er)
     GET_LOC(e, &loc);
     set_loc(c, &loc);
 
-    sd = decl_lookup(ctxt, c, id, &depth);
+    sd = decl_lookup(ctxt, c, id, OX_FALSE, &acc, &acc_id);
 
     if (sd) {
-        if (depth) {
-            cmd_get_t_b(ctxt, c, depth - 1, sd->id, er);
-        } else {
-            cmd_get_t(ctxt, c, sd->id, er);
+        switch (acc) {
+        case OX_DECL_ACC_FRAME:
+            cmd_get_t_b(ctxt, c, acc_id, sd->id, er);
+            break;
+        case OX_DECL_ACC_CAPTURE:
+            cmd_get_cap(ctxt, c, acc_id, er);
+            break;
+        default:
+            if (sd->type & OX_DECL_CAPTURED)
+                cmd_get_t_c(ctxt, c, sd->id, er);
+            else
+                cmd_get_t(ctxt, c, sd->id, er);
+            break;
         }
     } else {
         int cid = add_cv(ctxt, c, id);
@@ -1873,7 +2066,13 @@ binary_expr_to_cmds (OX_Context *ctxt, OX_Compiler *c, OX_Value *e, int er)
         }
 
         set_loc(c, &loc);
-        cmd_model_ssd(ctxt, c, bc, r1, r2, er);
+
+        if (bc == OX_BC_get_p)
+            cmd_get_p(ctxt, c, r1, r2, er);
+        else if (bc == OX_BC_lookup_p)
+            cmd_lookup_p(ctxt, c, r1, r2, er);
+        else
+            cmd_model_ssd(ctxt, c, bc, r1, r2, er);
 
         ques_dest_end(ctxt, c, &qd);
     }
@@ -1887,7 +2086,6 @@ expr_to_assi_left (OX_Context *ctxt, OX_Compiler *c, OX_Value *e, OX_AssiLeft *a
 {
     OX_VS_PUSH_6(ctxt, ce, te, k, base, prop, op)
     OX_ScriptDecl *sd;
-    int depth;
     OX_AstType aty;
 
     ox_value_copy(ctxt, ce, e);
@@ -1911,11 +2109,10 @@ expr_to_assi_left (OX_Context *ctxt, OX_Compiler *c, OX_Value *e, OX_AssiLeft *a
         break;
     case OX_AST_id:
         AST_GET(ce, value, k);
-        sd = decl_lookup(ctxt, c, k, &depth);
+        sd = decl_lookup(ctxt, c, k, OX_TRUE, &al->acc, &al->acc_id);
         if (sd) {
             al->type = OX_ASSI_LEFT_DECL;
             al->decl = sd;
-            al->depth = depth;
         } else {
             al->type = OX_ASSI_LEFT_GLOBAL;
             al->cv_id = add_cv(ctxt, c, k);
@@ -1968,10 +2165,20 @@ assi_left_value (OX_Context *ctxt, OX_Compiler *c, OX_AssiLeft *al, int rr)
 
     switch (al->type) {
     case OX_ASSI_LEFT_DECL:
-        if (al->depth)
-            cmd_get_t_b(ctxt, c, al->depth - 1, al->decl->id, rr);
-        else
-            cmd_get_t(ctxt, c, al->decl->id, rr);
+        switch (al->acc) {
+        case OX_DECL_ACC_FRAME:
+            cmd_get_t_b(ctxt, c, al->acc_id, al->decl->id, rr);
+            break;
+        case OX_DECL_ACC_CAPTURE:
+            cmd_get_cap(ctxt, c, al->acc_id, rr);
+            break;
+        default:
+            if (al->decl->type & OX_DECL_CAPTURED)
+                cmd_get_t_c(ctxt, c, al->decl->id, rr);
+            else
+                cmd_get_t(ctxt, c, al->decl->id, rr);
+            break;
+        }
         break;
     case OX_ASSI_LEFT_GLOBAL:
         cmd_get_n(ctxt, c, al->cv_id, rr);
@@ -2136,26 +2343,46 @@ assi_left_assi (OX_Context *ctxt, OX_Compiler *c, OX_AssiLeft *al, int rr, OX_Lo
     case OX_ASSI_LEFT_OBJECT:
         object_pattern_assi(ctxt, c, al->ast, rr);
         break;
-    case OX_ASSI_LEFT_DECL:
-        if (al->depth && ((al->decl->type == OX_DECL_CONST) || (al->decl->type == OX_DECL_REF))) {
+    case OX_ASSI_LEFT_DECL: {
+        OX_Bool ac = (al->decl->type & OX_DECL_AUTO_CLOSE) ? OX_TRUE : OX_FALSE;
+
+        if ((al->acc != OX_DECL_ACC_LOCAL)
+                && (((al->decl->type & OX_DECL_TYPE_MASK) == OX_DECL_CONST)
+                || ((al->decl->type & OX_DECL_TYPE_MASK) == OX_DECL_REF))) {
             error(ctxt, c, &al->loc, OX_TEXT("constant cannot be reset"));
         } else {
             set_loc(c, loc);
 
-            if (al->decl->type & OX_DECL_AUTO_CLOSE) {
-                if (al->depth) {
-                    cmd_set_t_b_ac(ctxt, c, al->depth - 1, al->decl->id, rr);
+            switch (al->acc) {
+            case OX_DECL_ACC_FRAME:
+                if (ac)
+                    cmd_set_t_b_ac(ctxt, c, al->acc_id, al->decl->id, rr);
+                else
+                    cmd_set_t_b(ctxt, c, al->acc_id, al->decl->id, rr);
+                break;
+            case OX_DECL_ACC_CAPTURE:
+                if (ac)
+                    cmd_set_cap_ac(ctxt, c, al->acc_id, rr);
+                else
+                    cmd_set_cap(ctxt, c, al->acc_id, rr);
+                break;
+            default:
+                if (al->decl->type & OX_DECL_CAPTURED) {
+                    if (ac)
+                        cmd_set_t_c_ac(ctxt, c, al->decl->id, rr);
+                    else
+                        cmd_set_t_c(ctxt, c, al->decl->id, rr);
                 } else {
-                    cmd_set_t_ac(ctxt, c, al->decl->id, rr);
+                    if (ac)
+                        cmd_set_t_ac(ctxt, c, al->decl->id, rr);
+                    else
+                        cmd_set_t(ctxt, c, al->decl->id, rr);
                 }
-            } else {
-                if (al->depth)
-                    cmd_set_t_b(ctxt, c, al->depth - 1, al->decl->id, rr);
-                else
-                    cmd_set_t(ctxt, c, al->decl->id, rr);
+                break;
             }
         }
         break;
+    }
     case OX_ASSI_LEFT_GLOBAL: {
         OX_Location loc;
         OX_VS_PUSH(ctxt, n)
@@ -2913,27 +3140,58 @@ sched_to_cmds (OX_Context *ctxt, OX_Compiler *c, OX_Value *s)
 static void
 try_to_cmds (OX_Context *ctxt, OX_Compiler *c, OX_Value *s)
 {
-    OX_VS_PUSH_3(ctxt, blk, cb, left)
-    int cl, fl;
+    OX_VS_PUSH_4(ctxt, blk, cb, fb, left)
+    OX_CompTry *t;
+    int sl, cl, fl, el;
+    int flags = 0;
     OX_Location loc;
 
+    AST_GET(s, catch, cb);
+    AST_GET(s, finally, fb);
+
+    if (!ox_value_is_null(ctxt, cb))
+        flags |= OX_SCRIPT_TRY_FL_CATCH;
+    if (!ox_value_is_null(ctxt, fb))
+        flags |= OX_SCRIPT_TRY_FL_FINALLY;
+
+    sl = add_label(ctxt, c);
     cl = add_label_l(ctxt, c, 1);
     fl = add_label_l(ctxt, c, 1);
+    el = add_label(ctxt, c);
+
+    /*The try block pushes nothing, the status entry is pushed only when
+     *the catch or the finally block is reached.*/
+    ox_not_error(ox_vector_expand(ctxt, &c->tries, c->tries.len + 1));
+    t = &ox_vector_item(&c->tries, c->tries.len - 1);
+    t->start_label = sl;
+    t->catch_label = cl;
+    t->finally_label = fl;
+    t->stack_level = c->stack_level;
+    t->flags = flags;
 
-    GET_LOC(s, &loc);
-    set_start_loc(c, &loc, 3);
-    cmd_try_start(ctxt, c, cl, fl);
+    cmd_stub(ctxt, c, sl);
+
+    if (flags & OX_SCRIPT_TRY_FL_FINALLY)
+        c->finally_level ++;
 
     AST_GET(s, block, blk);
     block_to_cmds(ctxt, c, blk, -1, OX_BLOCK_CONTENT_STMT, -1);
 
+    if (flags & OX_SCRIPT_TRY_FL_FINALLY)
+        c->finally_level --;
+
     GET_LOC(blk, &loc);
     set_end_loc(c, &loc, 1);
-    cmd_try_end(ctxt, c);
+
+    if (flags & OX_SCRIPT_TRY_FL_FINALLY) {
+        cmd_try_end(ctxt, c, fl);
+    } else {
+        cmd_jmp(ctxt, c, el);
+        c->stack_level ++;
+    }
 
     cmd_stub(ctxt, c, cl);
-    AST_GET(s, catch, cb);
-    if (!ox_value_is_null(ctxt, cb)) {
+    if (flags & OX_SCRIPT_TRY_FL_CATCH) {
         int er = add_reg(ctxt, c);
 
         GET_LOC(cb, &loc);
@@ -2943,18 +3201,16 @@ try_to_cmds (OX_Context *ctxt, OX_Compiler *c, OX_Value *s)
         left_ast_assi(ctxt, c, left, er, &loc);
         AST_GET(cb, block, blk);
         block_to_cmds(ctxt, c, blk, -1, OX_BLOCK_CONTENT_STMT, -1);
-
-        GET_LOC(blk, &loc);
-        set_end_loc(c, &loc, 1);
-        cmd_catch_end(ctxt, c);
     }
 
     cmd_stub(ctxt, c, fl);
-    AST_GET(s, finally, blk);
-    if (!ox_value_is_null(ctxt, blk)) {
-        block_to_cmds(ctxt, c, blk, -1, OX_BLOCK_CONTENT_STMT, -1);
-    }
+    if (flags & OX_SCRIPT_TRY_FL_FINALLY)
+        block_to_cmds(ctxt, c, fb, -1, OX_BLOCK_CONTENT_STMT, -1);
+
+    GET_LOC(s, &loc);
+    set_end_loc(c, &loc, 1);
     cmd_finally(ctxt, c);
+    cmd_stub(ctxt, c, el);
 
     OX_VS_POP(ctxt, blk)
 }
@@ -3017,7 +3273,7 @@ break_to_cmds (OX_Context *ctxt, OX_Compiler *c, OX_Value *s)
 
     l = &ox_vector_item(&c->labels, c->break_label);
 
-    if (l->stack_level == c->stack_level) {
+    if ((l->stack_level == c->stack_level) && (l->finally_level == c->finally_level)) {
         cmd_jmp(ctxt, c, c->break_label);
     } else {
         cmd_deep_jmp(ctxt, c, c->stack_level - l->stack_level, c->break_label);
@@ -3038,7 +3294,7 @@ continue_to_cmds (OX_Context *ctxt, OX_Compiler *c, OX_Value *s)
 
     l = &ox_vector_item(&c->labels, c->continue_label);
 
-    if (l->stack_level == c->stack_level) {
+    if ((l->stack_level == c->stack_level) && (l->finally_level == c->finally_level)) {
         cmd_jmp(ctxt, c, c->continue_label);
     } else {
         cmd_deep_jmp(ctxt, c, c->stack_level - l->stack_level, c->continue_label);
@@ -3156,10 +3412,21 @@ params_to_cmds (OX_Context *ctxt, OX_Compiler *c, OX_Value *params)
 
         len = ox_array_length(ctxt, items);
         if (len) {
+            OX_Bool has_rest = OX_FALSE;
+
+            /*Without rest parameter, the parameters are loaded from
+             *the arguments directly and the parameter entry is not needed.*/
+            for (i = 0; i < len; i ++) {
+                ox_not_error(ox_array_get_item(ctxt, items, i, p));
+                if (ox_ast_get_type(ctxt, p) == OX_AST_rest)
+                    has_rest = OX_TRUE;
+            }
+
             GET_LOC(params, &loc);
             set_start_loc(c, &loc, 1);
 
-            cmd_p_start(ctxt, c);
+            if (has_rest)
+                cmd_p_start(ctxt, c);
 
             for (i = 0; i < len; i ++) {
                 OX_AstType aty;
@@ -3184,7 +3451,11 @@ params_to_cmds (OX_Context *ctxt, OX_Compiler *c, OX_Value *params)
 
                     GET_LOC(p, &ploc);
                     set_loc(c, &ploc);
-                    cmd_p_get(ctxt, c, pr);
+
+                    if (has_rest)
+                        cmd_p_get(ctxt, c, pr);
+                    else
+                        cmd_get_a(ctxt, c, i, pr);
 
                     if (!ox_value_is_null(ctxt, defv)) {
                         OX_Location vloc;
@@ -3212,8 +3483,10 @@ params_to_cmds (OX_Context *ctxt, OX_Compiler *c, OX_Value *params)
 
             }
 
-            set_end_loc(c, &loc, 1);
-            cmd_s_pop(ctxt, c);
+            if (has_rest) {
+                set_end_loc(c, &loc, 1);
+                cmd_s_pop(ctxt, c);
+            }
         }
     }
 
@@ -3260,97 +3533,914 @@ bytecode_len (OX_ByteCode bc)
     return bytecode_len_table[m];
 }
 
-/*Initialize the functions.*/
+/*Maximum number of registers used by a command.*/
+#define OX_CMD_REG_MAX 8
+
+/*Check if the command cannot fall through to the next command.*/
+static OX_Bool
+is_terminal_cmd (OX_Command *cmd)
+{
+    switch (cmd->bc) {
+    case OX_BC_jmp:
+    case OX_BC_deep_jmp:
+    case OX_BC_ret:
+    case OX_BC_throw:
+        return OX_TRUE;
+    default:
+        return OX_FALSE;
+    }
+}
+
+/*Check if the command only writes its destination register without side effect.*/
+static OX_Bool
+is_pure_cmd (OX_Command *cmd)
+{
+    switch (cmd->bc) {
+    case OX_BC_dup:
+    case OX_BC_not:
+    case OX_BC_load_null:
+    case OX_BC_load_true:
+    case OX_BC_load_false:
+    case OX_BC_this:
+    case OX_BC_get_cv:
+    case OX_BC_get_pp:
+    case OX_BC_get_t:
+    case OX_BC_get_t_c:
+    case OX_BC_get_cap:
+    case OX_BC_get_r:
+    case OX_BC_get_a:
+        return OX_TRUE;
+    default:
+        return OX_FALSE;
+    }
+}
+
+/*Get the previous command which is not "nop".*/
+static OX_Command*
+prev_cmd (OX_Compiler *c, int i)
+{
+    while (-- i >= 0) {
+        OX_Command *cmd = &ox_vector_item(&c->cmds, i);
+
+        if (cmd->bc != OX_BC_nop)
+            return cmd;
+    }
+
+    return NULL;
+}
+
+/*Count the definitions and usages of the registers.*/
 static void
-init_func (OX_Context *ctxt, OX_Compiler *c)
+count_regs (OX_Compiler *c)
 {
-    OX_VS_PUSH_2(ctxt, bot, id)
+    int *regs[OX_CMD_REG_MAX];
+    char types[OX_CMD_REG_MAX];
+    size_t i;
+    int j, n;
 
-    /*Initialize the script function.*/
-    c->sf->script = c->s;
-    ox_size_hash_init(&c->sf->decl_hash);
-    ox_list_init(&c->sf->decl_list);
-    c->sf->frame_num = c->bot_frame_num;
-    c->sf->reg_num = 0;
-    c->sf->flags = 0;
+    for (i = 0; i < c->regs.len; i ++) {
+        OX_CompRegister *reg = &ox_vector_item(&c->regs, i);
 
-    /*Get this argument flag.*/
-    if (AST_GET_B(c->f, this))
-        c->sf->flags |= OX_SCRIPT_FUNC_FL_THIS;
+        reg->def_cnt = 0;
+        reg->use_cnt = 0;
+    }
 
-    /*Get the bottom frames' number.*/
-    AST_GET(c->f, outer, bot);
-    while (!ox_value_is_null(ctxt, bot)) {
-        AST_GET(bot, id, id);
-        if (!ox_value_is_null(ctxt, id))
-            c->sf->frame_num ++;
+    for (i = 0; i < c->cmds.len; i ++) {
+        OX_Command *cmd = &ox_vector_item(&c->cmds, i);
 
-        AST_GET(bot, outer, bot);
+        n = bytecode_regs(cmd, regs, types);
+        for (j = 0; j < n; j ++) {
+            OX_CompRegister *reg = &ox_vector_item(&c->regs, *regs[j]);
+
+            if (types[j] == 's')
+                reg->use_cnt ++;
+            else
+                reg->def_cnt ++;
+        }
     }
+}
 
-    OX_VS_POP(ctxt, bot)
+/*Check if the register is only written by one command and read by one command.*/
+static OX_Bool
+is_temp_reg (OX_Compiler *c, int r)
+{
+    OX_CompRegister *reg = &ox_vector_item(&c->regs, r);
+
+    return (reg->def_cnt == 1) && (reg->use_cnt == 1);
 }
 
-/*Initialize the functions.*/
+/*Remove a command loading a temporary register.*/
 static void
-func_add_decls (OX_Context *ctxt, OX_Compiler *c)
+remove_load_cmd (OX_Compiler *c, OX_Command *cmd, int r)
 {
-    /*Generate the declarations.*/
-    add_decls(ctxt, c);
+    OX_CompRegister *reg = &ox_vector_item(&c->regs, r);
+
+    cmd->bc = OX_BC_nop;
+    reg->def_cnt = 0;
+    reg->use_cnt = 0;
 }
 
-/*Compile the function.*/
-static OX_Result
-compile_func (OX_Context *ctxt, OX_Compiler *c, int rr)
+/*Get the constant value loaded by the command.*/
+static OX_Value*
+cmd_const (OX_Compiler *c, OX_Command *cmd, int r)
 {
-    OX_VS_PUSH_2(ctxt, blk, params)
-    uint8_t *bc;
+    OX_CompValue *cv;
     size_t i;
-    size_t bc_len;
-    OX_Bool loop;
-    OX_Result r;
 
-    /*Index overflow check.*/
-    if (c->sf->decl_hash.e_num > 0xffff) {
-        r = ox_throw_range_error(ctxt, OX_TEXT("too many declarations in the function"));
-        goto end;
-    }
+    if (!cmd || (cmd->bc != OX_BC_get_cv) || (cmd->cd.d1 != r))
+        return NULL;
 
-    if (c->sf->frame_num > 0xff) {
-        r = ox_throw_range_error(ctxt, OX_TEXT("function stack is too deep"));
-        goto end;
+    ox_hash_foreach_c(&c->cv_hash, i, cv, OX_CompValue, he) {
+        if (cv->id == cmd->cd.c0)
+            return &cv->v;
     }
 
-    /*Clear the labels and commands buffer.*/
-    c->labels.len = 0;
-    c->cmds.len = 0;
-    c->break_label = -1;
-    c->continue_label = -1;
-    c->ques_label = -1;
-    c->ques_r = -1;
-    c->stack_level = 0;
+    return NULL;
+}
 
-    /*Compile AST to commands.*/
-    AST_GET(c->f, params, params);
-    params_to_cmds(ctxt, c, params);
+/*Fold the binary operation on constant values.*/
+static void
+fold_binary_cmd (OX_Context *ctxt, OX_Compiler *c, int i)
+{
+    OX_VS_PUSH_3(ctxt, s1, s2, rv)
+    OX_Command *cmd = &ox_vector_item(&c->cmds, i);
+    OX_Command *cmd1, *cmd2, *ccmd;
+    OX_Value *v1, *v2;
+    int r1 = cmd->ssd.s0;
+    int r2 = cmd->ssd.s1;
+    int d = cmd->ssd.d2;
+    OX_Bool folded = OX_FALSE;
+    OX_Number n;
 
-    AST_GET(c->f, block, blk);
-    block_to_cmds(ctxt, c, blk, rr, OX_BLOCK_CONTENT_STMT, -1);
+    if ((r1 == r2) || !is_temp_reg(c, r1) || !is_temp_reg(c, r2))
+        goto end;
 
-    if (rr != -1) {
-        OX_Location loc;
+    /*The operands must be loaded just before the operation.*/
+    if (!(cmd2 = prev_cmd(c, i)))
+        goto end;
+    if (!(cmd1 = prev_cmd(c, cmd2 - c->cmds.items)))
+        goto end;
 
-        GET_LOC(c->f, &loc);
-        set_loc(c, &loc);
-        cmd_ret(ctxt, c, rr);
+    if (!(v1 = cmd_const(c, cmd1, r1)) || !(v2 = cmd_const(c, cmd2, r2))) {
+        if (!(v1 = cmd_const(c, cmd2, r1)) || !(v2 = cmd_const(c, cmd1, r2)))
+            goto end;
     }
 
-    /*Calculate the bytecode buffer's length.*/
-    c->sf->bc_start = c->bc.len;
-    c->sf->loc_start = c->ltab.len;
+    if (ox_value_is_number(ctxt, v1) && ox_value_is_number(ctxt, v2)) {
+        OX_Number n1 = ox_value_get_number(ctxt, v1);
+        OX_Number n2 = ox_value_get_number(ctxt, v2);
 
-    do {
-        loop = OX_FALSE;
+        folded = OX_TRUE;
+
+        switch (cmd->bc) {
+        case OX_BC_add:
+            n = n1 + n2;
+            break;
+        case OX_BC_sub:
+            n = n1 - n2;
+            break;
+        case OX_BC_mul:
+            n = n1 * n2;
+            break;
+        case OX_BC_div:
+            n = n1 / n2;
+            break;
+        default:
+            folded = OX_FALSE;
+            break;
+        }
+
+        if (folded)
+            ox_value_set_number(ctxt, rv, n);
+    } else if ((cmd->bc == OX_BC_add)
+            && (ox_value_is_string(ctxt, v1) || ox_value_is_string(ctxt, v2))
+            && (ox_value_is_string(ctxt, v1) || ox_value_is_number(ctxt, v1))
+            && (ox_value_is_string(ctxt, v2) || ox_value_is_number(ctxt, v2))) {
+        /*String concatenation.*/
+        ox_not_error(ox_to_string(ctxt, v1, s1));
+        ox_not_error(ox_to_string(ctxt, v2, s2));
+        ox_not_error(ox_string_concat(ctxt, s1, s2, rv));
+        ox_not_error(ox_string_singleton(ctxt, rv));
+
+        /*Hold the new string until the script is created.*/
+        if (ox_value_is_null(ctxt, c->folded))
+            ox_not_error(ox_array_new(ctxt, c->folded, 0));
+        ox_not_error(ox_array_append(ctxt, c->folded, rv));
+
+        folded = OX_TRUE;
+    }
+
+    if (folded) {
+        int id = add_cv(ctxt, c, rv);
+
+        remove_load_cmd(c, cmd1, cmd1->cd.d1);
+        remove_load_cmd(c, cmd2, cmd2->cd.d1);
+
+        ccmd = &ox_vector_item(&c->cmds, i);
+        ccmd->bc = OX_BC_get_cv;
+        ccmd->cd.c0 = id;
+        ccmd->cd.d1 = d;
+    }
+end:
+    OX_VS_POP(ctxt, s1)
+}
+
+/*Fold the conditional jump on a constant boolean value.*/
+static void
+fold_branch_cmd (OX_Compiler *c, int i)
+{
+    OX_Command *cmd = &ox_vector_item(&c->cmds, i);
+    OX_Command *pcmd = prev_cmd(c, i);
+    int r = cmd->sl.s0;
+    int l = cmd->sl.l1;
+    OX_Bool b;
+
+    if (!pcmd || !is_temp_reg(c, r))
+        return;
+
+    if ((pcmd->bc == OX_BC_load_true) && (pcmd->d.d0 == r))
+        b = OX_TRUE;
+    else if ((pcmd->bc == OX_BC_load_false) && (pcmd->d.d0 == r))
+        b = OX_FALSE;
+    else
+        return;
+
+    remove_load_cmd(c, pcmd, r);
+
+    if ((cmd->bc == OX_BC_jt) ? b : !b) {
+        cmd->bc = OX_BC_jmp;
+        cmd->l.l0 = l;
+    } else {
+        cmd->bc = OX_BC_nop;
+    }
+}
+
+/*Write the result of the previous command to the destination of "dup" directly.*/
+static void
+merge_dup_cmd (OX_Compiler *c, int i)
+{
+    OX_Command *cmd = &ox_vector_item(&c->cmds, i);
+    OX_Command *pcmd;
+    int *regs[OX_CMD_REG_MAX];
+    char types[OX_CMD_REG_MAX];
+    int *pd = NULL;
+    int s = cmd->sd.s0;
+    int d = cmd->sd.d1;
+    int j, n;
+
+    if (s == d) {
+        cmd->bc = OX_BC_nop;
+        return;
+    }
+
+    if (!is_temp_reg(c, s) || !(pcmd = prev_cmd(c, i)))
+        return;
+
+    n = bytecode_regs(pcmd, regs, types);
+    for (j = 0; j < n; j ++) {
+        if (*regs[j] == d)
+            return;
+
+        if (*regs[j] == s) {
+            if (types[j] == 's')
+                return;
+
+            pd = regs[j];
+        }
+    }
+
+    if (!pd)
+        return;
+
+    *pd = d;
+    cmd->bc = OX_BC_nop;
+
+    ox_vector_item(&c->regs, s).def_cnt = 0;
+    ox_vector_item(&c->regs, s).use_cnt = 0;
+}
+
+/*Get the final target of the label by skipping the jump chain.*/
+static int
+jump_target (OX_Compiler *c, int *label_cmds, int l)
+{
+    size_t n = 0;
+
+    while (n ++ < c->labels.len) {
+        int i = label_cmds[l];
+        OX_Command *cmd;
+
+        if (i == -1)
+            break;
+
+        do {
+            cmd = &ox_vector_item(&c->cmds, i ++);
+        } while (((cmd->bc == OX_BC_stub) || (cmd->bc == OX_BC_nop)) && (i < c->cmds.len));
+
+        if ((cmd->bc != OX_BC_jmp) || (cmd->l.l0 == l))
+            break;
+
+        l = cmd->l.l0;
+    }
+
+    return l;
+}
+
+/*Optimize the commands of the function.*/
+static void
+optimize_cmds (OX_Context *ctxt, OX_Compiler *c)
+{
+    int *label_cmds;
+    size_t i, j;
+
+    count_regs(c);
+
+    /*Constant folding and redundant register move elimination.*/
+    for (i = 0; i < c->cmds.len; i ++) {
+        OX_Command *cmd = &ox_vector_item(&c->cmds, i);
+
+        switch (cmd->bc) {
+        case OX_BC_add:
+        case OX_BC_sub:
+        case OX_BC_mul:
+        case OX_BC_div:
+            fold_binary_cmd(ctxt, c, i);
+            break;
+        case OX_BC_jt:
+        case OX_BC_jf:
+            fold_branch_cmd(c, i);
+            break;
+        case OX_BC_dup:
+            merge_dup_cmd(c, i);
+            break;
+        default:
+            break;
+        }
+    }
+
+    /*Remove the commands writing unused registers.*/
+    for (i = c->cmds.len; i > 0; i --) {
+        OX_Command *cmd = &ox_vector_item(&c->cmds, i - 1);
+        int *regs[OX_CMD_REG_MAX];
+        char types[OX_CMD_REG_MAX];
+        int n;
+
+        if (!is_pure_cmd(cmd))
+            continue;
+
+        n = bytecode_regs(cmd, regs, types);
+        if (ox_vector_item(&c->regs, *regs[n - 1]).use_cnt == 0) {
+            if (types[0] == 's')
+                ox_vector_item(&c->regs, *regs[0]).use_cnt --;
+
+            cmd->bc = OX_BC_nop;
+        }
+    }
+
+    /*Remove the unreachable commands.*/
+    for (i = 0; i < c->cmds.len; i ++) {
+        OX_Command *cmd = &ox_vector_item(&c->cmds, i);
+
+        if (!is_terminal_cmd(cmd))
+            continue;
+
+        for (j = i + 1; j < c->cmds.len; j ++) {
+            OX_Command *ncmd = &ox_vector_item(&c->cmds, j);
+
+            if (ncmd->bc == OX_BC_stub)
+                break;
+
+            ncmd->bc = OX_BC_nop;
+        }
+
+        i = j - 1;
+    }
+
+    /*Jump to the final target directly.*/
+    if (c->labels.len) {
+        ox_not_null(OX_NEW_N(ctxt, label_cmds, c->labels.len));
+
+        for (i = 0; i < c->labels.len; i ++)
+            label_cmds[i] = -1;
+
+        for (i = 0; i < c->cmds.len; i ++) {
+            OX_Command *cmd = &ox_vector_item(&c->cmds, i);
+
+            if (cmd->bc == OX_BC_stub)
+                label_cmds[cmd->l.l0] = i;
+        }
+
+        for (i = 0; i < c->cmds.len; i ++) {
+            OX_Command *cmd = &ox_vector_item(&c->cmds, i);
+
+            switch (cmd->bc) {
+            case OX_BC_jmp:
+                cmd->l.l0 = jump_target(c, label_cmds, cmd->l.l0);
+                break;
+            case OX_BC_jt:
+            case OX_BC_jf:
+            case OX_BC_jnn:
+                cmd->sl.l1 = jump_target(c, label_cmds, cmd->sl.l1);
+                break;
+            default:
+                break;
+            }
+        }
+
+        OX_DEL_N(ctxt, label_cmds, c->labels.len);
+    }
+}
+
+/*Check if the result of the "call_end" command is returned directly.*/
+static OX_Bool
+is_tail_call (OX_Compiler *c, int i)
+{
+    OX_Command *cmd = &ox_vector_item(&c->cmds, i);
+    OX_Command *ncmd = NULL;
+    int j;
+
+    /*Get the next real command.*/
+    for (j = i + 1; j < c->cmds.len; j ++) {
+        ncmd = &ox_vector_item(&c->cmds, j);
+
+        if (bytecode_len(ncmd->bc)
+                && (bytecode_models[ncmd->bc] != OX_BC_MODEL_noarg))
+            break;
+    }
+
+    if (j >= c->cmds.len)
+        return OX_TRUE;
+
+    if (ncmd->bc == OX_BC_ret)
+        return ncmd->s.s0 == cmd->d.d0;
+
+    if ((ncmd->bc == OX_BC_load_null) && (j + 1 < c->cmds.len)) {
+        OX_Command *nncmd = &ox_vector_item(&c->cmds, j + 1);
+
+        if ((nncmd->bc == OX_BC_ret) && (nncmd->s.s0 == ncmd->d.d0))
+            return OX_TRUE;
+    }
+
+    return OX_FALSE;
+}
+
+/*Check if the instruction is in a try or catch block of the current function.*/
+static OX_Bool
+is_in_try (OX_Compiler *c, int ip)
+{
+    size_t i;
+
+    for (i = c->sf->try_start; i < c->sf->try_start + c->sf->try_len; i ++) {
+        OX_ScriptTry *st = &ox_vector_item(&c->ttab, i);
+
+        if ((ip >= st->start) && (ip < st->finally_ip))
+            return OX_TRUE;
+    }
+
+    return OX_FALSE;
+}
+
+/*Get the next command which is not "nop".*/
+static OX_Command*
+next_cmd (OX_Compiler *c, int i)
+{
+    while (++ i < c->cmds.len) {
+        OX_Command *cmd = &ox_vector_item(&c->cmds, i);
+
+        if (cmd->bc != OX_BC_nop)
+            return cmd;
+    }
+
+    return NULL;
+}
+
+/*Maximum number of arguments of the direct call commands.*/
+#define OX_DIRECT_CALL_ARG_MAX 3
+
+/*Fuse "call_start", "arg" and "call_end" to the direct call command "call0" ~ "call3".*/
+static void
+fuse_call_cmd (OX_Compiler *c, int i)
+{
+    OX_Command *cmd = &ox_vector_item(&c->cmds, i);
+    OX_Command *ecmd = NULL;
+    int acmds[OX_DIRECT_CALL_ARG_MAX];
+    int f = cmd->ss.s0;
+    int t = cmd->ss.s1;
+    int argc = 0;
+    int level = 0;
+    int j, d;
+
+    /*Lookup the arguments and the "call_end" command of this call.*/
+    for (j = i + 1; j < c->cmds.len; j ++) {
+        OX_Command *ncmd = &ox_vector_item(&c->cmds, j);
+
+        switch (ncmd->bc) {
+        case OX_BC_call_start:
+            level ++;
+            break;
+        case OX_BC_call_end:
+            if (level == 0)
+                ecmd = ncmd;
+            else
+                level --;
+            break;
+        case OX_BC_arg:
+            if (level == 0) {
+                if (argc == OX_DIRECT_CALL_ARG_MAX)
+                    return;
+
+                acmds[argc ++] = j;
+            }
+            break;
+        case OX_BC_arg_spread:
+            if (level == 0)
+                return;
+            break;
+        default:
+            break;
+        }
+
+        if (ecmd)
+            break;
+    }
+
+    if (!ecmd || is_tail_call(c, j))
+        return;
+
+    /*The arguments are stored in the registers until the call.*/
+    d = ecmd->d.d0;
+    cmd->bc = OX_BC_nop;
+
+    for (j = 0; j < argc; j ++)
+        ox_vector_item(&c->cmds, acmds[j]).bc = OX_BC_nop;
+
+    switch (argc) {
+    case 0:
+        ecmd->bc = OX_BC_call0;
+        ecmd->ssd.s0 = f;
+        ecmd->ssd.s1 = t;
+        ecmd->ssd.d2 = d;
+        break;
+    case 1:
+        ecmd->bc = OX_BC_call1;
+        ecmd->sssd.s0 = f;
+        ecmd->sssd.s1 = t;
+        ecmd->sssd.s2 = ox_vector_item(&c->cmds, acmds[0]).s.s0;
+        ecmd->sssd.d3 = d;
+        break;
+    case 2:
+        ecmd->bc = OX_BC_call2;
+        ecmd->ssssd.s0 = f;
+        ecmd->ssssd.s1 = t;
+        ecmd->ssssd.s2 = ox_vector_item(&c->cmds, acmds[0]).s.s0;
+        ecmd->ssssd.s3 = ox_vector_item(&c->cmds, acmds[1]).s.s0;
+        ecmd->ssssd.d4 = d;
+        break;
+    default:
+        ecmd->bc = OX_BC_call3;
+        ecmd->sssssd.s0 = f;
+        ecmd->sssssd.s1 = t;
+        ecmd->sssssd.s2 = ox_vector_item(&c->cmds, acmds[0]).s.s0;
+        ecmd->sssssd.s3 = ox_vector_item(&c->cmds, acmds[1]).s.s0;
+        ecmd->sssssd.s4 = ox_vector_item(&c->cmds, acmds[2]).s.s0;
+        ecmd->sssssd.d5 = d;
+        break;
+    }
+}
+
+/*Fuse the frequent command sequences to superinstructions.*/
+static void
+fuse_cmds (OX_Compiler *c)
+{
+    size_t i;
+
+    count_regs(c);
+
+    for (i = 0; i < c->cmds.len; i ++) {
+        OX_Command *cmd = &ox_vector_item(&c->cmds, i);
+        OX_Command *ncmd;
+        int id, cid, r, s0, s1;
+
+        if (cmd->bc == OX_BC_call_start) {
+            fuse_call_cmd(c, i);
+            continue;
+        }
+
+        if (!(ncmd = next_cmd(c, i)))
+            break;
+
+        switch (cmd->bc) {
+        case OX_BC_get_t:
+            /*"get_t" + "name_nn" => "get_t_nn".*/
+            r = cmd->id.d1;
+
+            if ((ncmd->bc == OX_BC_name_nn) && (ncmd->cs.s1 == r)) {
+                id = cmd->id.i0;
+                cid = ncmd->cs.c0;
+
+                cmd->bc = OX_BC_nop;
+
+                ncmd->bc = OX_BC_get_t_nn;
+                ncmd->icd.i0 = id;
+                ncmd->icd.c1 = cid;
+                ncmd->icd.d2 = r;
+            }
+            break;
+        case OX_BC_get_cv:
+            /*"get_cv" + "get_p" => "get_p_c".*/
+            r = cmd->cd.d1;
+
+            if ((ncmd->bc == OX_BC_get_p) && (ncmd->ssdC.s1 == r)
+                    && (ncmd->ssdC.s0 != r) && is_temp_reg(c, r)) {
+                cid = cmd->cd.c0;
+
+                cmd->bc = OX_BC_nop;
+
+                ncmd->bc = OX_BC_get_p_c;
+                ncmd->scdC.c1 = cid;
+            }
+            break;
+        case OX_BC_lt:
+        case OX_BC_gt:
+        case OX_BC_le:
+        case OX_BC_ge:
+        case OX_BC_eq:
+        case OX_BC_ne:
+            /*Compare + "jf" => compare and jump.*/
+            r = cmd->ssd.d2;
+
+            if ((ncmd->bc == OX_BC_jf) && (ncmd->sl.s0 == r) && is_temp_reg(c, r)) {
+                s0 = cmd->ssd.s0;
+                s1 = cmd->ssd.s1;
+
+                switch (cmd->bc) {
+                case OX_BC_lt:
+                    cmd->bc = OX_BC_lt_jf;
+                    break;
+                case OX_BC_gt:
+                    cmd->bc = OX_BC_gt_jf;
+                    break;
+                case OX_BC_le:
+                    cmd->bc = OX_BC_le_jf;
+                    break;
+                case OX_BC_ge:
+                    cmd->bc = OX_BC_ge_jf;
+                    break;
+                case OX_BC_eq:
+                    cmd->bc = OX_BC_eq_jf;
+                    break;
+                default:
+                    cmd->bc = OX_BC_ne_jf;
+                    break;
+                }
+
+                cmd->ssl.s0 = s0;
+                cmd->ssl.s1 = s1;
+                cmd->ssl.l2 = ncmd->sl.l1;
+
+                ncmd->bc = OX_BC_nop;
+            }
+            break;
+        case OX_BC_not:
+            /*"not" + "jf"/"jt" => "jt"/"jf".*/
+            r = cmd->sd.d1;
+
+            if (((ncmd->bc == OX_BC_jf) || (ncmd->bc == OX_BC_jt))
+                    && (ncmd->sl.s0 == r) && is_temp_reg(c, r)) {
+                ncmd->bc = (ncmd->bc == OX_BC_jf) ? OX_BC_jt : OX_BC_jf;
+                ncmd->sl.s0 = cmd->sd.s0;
+
+                cmd->bc = OX_BC_nop;
+            }
+            break;
+        case OX_BC_get_a:
+            /*"get_a" + "set_t" => "get_a_t".*/
+            r = cmd->id.d1;
+
+            if ((ncmd->bc == OX_BC_set_t) && (ncmd->is.s1 == r) && is_temp_reg(c, r)) {
+                cmd->bc = OX_BC_get_a_t;
+                cmd->ii.i1 = ncmd->is.i0;
+
+                ncmd->bc = OX_BC_nop;
+            }
+            break;
+        case OX_BC_p_get:
+            /*"p_get" + "set_t" => "p_get_t".*/
+            r = cmd->d.d0;
+
+            if ((ncmd->bc == OX_BC_set_t) && (ncmd->is.s1 == r) && is_temp_reg(c, r)) {
+                cmd->bc = OX_BC_p_get_t;
+                cmd->i.i0 = ncmd->is.i0;
+
+                ncmd->bc = OX_BC_nop;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+/*Initialize the functions.*/
+static void
+init_func (OX_Context *ctxt, OX_Compiler *c)
+{
+    OX_VS_PUSH_2(ctxt, bot, id)
+
+    /*Initialize the script function.*/
+    c->sf->script = c->s;
+    ox_size_hash_init(&c->sf->decl_hash);
+    ox_list_init(&c->sf->decl_list);
+    c->sf->frame_num = c->bot_frame_num;
+    c->sf->reg_num = 0;
+    c->sf->flags = 0;
+    c->sf->jit_cnt = 0;
+    c->sf->jit = NULL;
+    c->sf->try_start = 0;
+    c->sf->try_len = 0;
+
+    /*Get this argument flag.*/
+    if (AST_GET_B(c->f, this))
+        c->sf->flags |= OX_SCRIPT_FUNC_FL_THIS;
+
+    /*Get the bottom frames' number.
+     *Only the frame of the script's entry function is referenced by the inner functions.*/
+    AST_GET(c->f, outer, bot);
+    while (!ox_value_is_null(ctxt, bot)) {
+        AST_GET(bot, id, id);
+        if (!ox_value_is_null(ctxt, id)) {
+            c->sf->frame_num ++;
+            break;
+        }
+
+        AST_GET(bot, outer, bot);
+    }
+
+    OX_VS_POP(ctxt, bot)
+}
+
+/*Store the declarations captured by the inner functions to cells.*/
+static void
+cell_decls (OX_Context *ctxt, OX_Compiler *c)
+{
+    OX_ScriptDecl *decl;
+    OX_Location loc;
+
+    GET_LOC(c->f, &loc);
+    set_loc(c, &loc);
+
+    ox_list_foreach_c(&c->sf->decl_list, decl, OX_ScriptDecl, ln) {
+        if (!(decl->type & OX_DECL_CAPTURED))
+            continue;
+
+        /*Only the parameters may be captured by value.*/
+        if ((decl->type & OX_DECL_TYPE_MASK) != OX_DECL_PARAM)
+            decl->type |= OX_DECL_BOXED;
+
+        cmd_cell_t(ctxt, c, decl->id);
+    }
+}
+
+/*Capture the parameters by value if they are not changed after being set.
+ *p_end is the end of the parameters setting commands.*/
+static void
+unbox_params (OX_Compiler *c, size_t p_end)
+{
+    OX_ScriptDecl *decl;
+    OX_Bool closure = OX_FALSE;
+    size_t i;
+
+    /*The functions created by the parameters' default values may run before the parameters are set.*/
+    for (i = 0; i < p_end; i ++) {
+        if (ox_vector_item(&c->cmds, i).bc == OX_BC_f_new) {
+            closure = OX_TRUE;
+            break;
+        }
+    }
+
+    ox_list_foreach_c(&c->sf->decl_list, decl, OX_ScriptDecl, ln) {
+        if ((decl->type & (OX_DECL_CAPTURED|OX_DECL_BOXED)) != OX_DECL_CAPTURED)
+            continue;
+
+        if (closure) {
+            decl->type |= OX_DECL_BOXED;
+            continue;
+        }
+
+        for (i = p_end; i < c->cmds.len; i ++) {
+            OX_Command *cmd = &ox_vector_item(&c->cmds, i);
+
+            if (((cmd->bc == OX_BC_set_t_c) || (cmd->bc == OX_BC_set_t_c_ac))
+                    && (cmd->is.i0 == decl->id)) {
+                decl->type |= OX_DECL_BOXED;
+                break;
+            }
+        }
+
+        if (decl->type & OX_DECL_BOXED)
+            continue;
+
+        /*The inner functions copy the value, the cell is not needed.*/
+        for (i = 0; i < c->cmds.len; i ++) {
+            OX_Command *cmd = &ox_vector_item(&c->cmds, i);
+
+            switch (cmd->bc) {
+            case OX_BC_cell_t:
+                if (cmd->i.i0 == decl->id)
+                    cmd->bc = OX_BC_nop;
+                break;
+            case OX_BC_get_t_c:
+                if (cmd->id.i0 == decl->id)
+                    cmd->bc = OX_BC_get_t;
+                break;
+            case OX_BC_set_t_c:
+                if (cmd->is.i0 == decl->id)
+                    cmd->bc = OX_BC_set_t;
+                break;
+            case OX_BC_set_t_c_ac:
+                if (cmd->is.i0 == decl->id)
+                    cmd->bc = OX_BC_set_t_ac;
+                break;
+            default:
+                break;
+            }
+        }
+    }
+}
+
+/*Initialize the functions.*/
+static void
+func_add_decls (OX_Context *ctxt, OX_Compiler *c)
+{
+    /*Generate the declarations.*/
+    add_decls(ctxt, c);
+}
+
+/*Compile the function.*/
+static OX_Result
+compile_func (OX_Context *ctxt, OX_Compiler *c, int rr)
+{
+    OX_VS_PUSH_2(ctxt, blk, params)
+    uint8_t *bc;
+    size_t i, p_end;
+    size_t bc_len;
+    OX_Bool loop;
+    OX_Result r;
+
+    /*Index overflow check.*/
+    if (c->sf->decl_hash.e_num > 0xffff) {
+        r = ox_throw_range_error(ctxt, OX_TEXT("too many declarations in the function"));
+        goto end;
+    }
+
+    if (c->sf->frame_num > 0xff) {
+        r = ox_throw_range_error(ctxt, OX_TEXT("function stack is too deep"));
+        goto end;
+    }
+
+    /*Clear the labels and commands buffer.*/
+    c->labels.len = 0;
+    c->cmds.len = 0;
+    c->break_label = -1;
+    c->continue_label = -1;
+    c->ques_label = -1;
+    c->ques_r = -1;
+    c->stack_level = 0;
+    c->finally_level = 0;
+    c->tries.len = 0;
+
+    /*Compile AST to commands.*/
+    cell_decls(ctxt, c);
+
+    AST_GET(c->f, params, params);
+    params_to_cmds(ctxt, c, params);
+    p_end = c->cmds.len;
+
+    AST_GET(c->f, block, blk);
+    block_to_cmds(ctxt, c, blk, rr, OX_BLOCK_CONTENT_STMT, -1);
+
+    if (rr != -1) {
+        OX_Location loc;
+
+        GET_LOC(c->f, &loc);
+        set_loc(c, &loc);
+        cmd_ret(ctxt, c, rr);
+    }
+
+    unbox_params(c, p_end);
+
+    /*Optimize the commands.*/
+    if (ox_vm_get(ctxt)->opt_level > 0)
+        optimize_cmds(ctxt, c);
+
+    /*Generate the superinstructions.*/
+    fuse_cmds(c);
+
+    /*Calculate the bytecode buffer's length.*/
+    c->sf->bc_start = c->bc.len;
+    c->sf->loc_start = c->ltab.len;
+
+    do {
+        loop = OX_FALSE;
         bc_len = 0;
 
         for (i = 0; i < c->cmds.len; i ++) {
@@ -3402,6 +4492,23 @@ compile_func (OX_Context *ctxt, OX_Compiler *c, int rr)
 
     c->sf->bc_len = bc_len;
 
+    /*Generate the exception handling table.*/
+    c->sf->try_start = c->ttab.len;
+    c->sf->try_len = c->tries.len;
+
+    for (i = 0; i < c->tries.len; i ++) {
+        OX_CompTry *t = &ox_vector_item(&c->tries, i);
+        OX_ScriptTry st;
+
+        st.start = ox_vector_item(&c->labels, t->start_label).off;
+        st.catch_ip = ox_vector_item(&c->labels, t->catch_label).off;
+        st.finally_ip = ox_vector_item(&c->labels, t->finally_label).off;
+        st.level = t->stack_level;
+        st.flags = t->flags;
+
+        ox_not_error(ox_vector_append(ctxt, &c->ttab, st));
+    }
+
     /*Allocate registers.*/
     for (i = 0; i < c->cmds.len; i ++) {
         OX_Command *cmd = &ox_vector_item(&c->cmds, i);
@@ -3457,45 +4564,10 @@ compile_func (OX_Context *ctxt, OX_Compiler *c, int rr)
                         top_ip = l->off;
                     }
                     break;
-                case OX_BC_try_start:
-                    /*Store the top block's offset.*/
-                    if (top_ip == 0) {
-                        l = &ox_vector_item(&c->labels, cmd->ll.l1);
-                    }
-                    break;
                 case OX_BC_call_end:
                     /*Tail recursion check.*/
-                    if (top_ip == 0) {
-                        OX_Bool is_tail = OX_FALSE;
-                        OX_Command *ncmd = NULL;
-                        int j;
-
-                        /*Get the next real command.*/
-                        for (j = i + 1; j < c->cmds.len; j ++) {
-                            ncmd = &ox_vector_item(&c->cmds, j);
-
-                            if (bytecode_len(ncmd->bc)
-                                    && (bytecode_models[ncmd->bc] != OX_BC_MODEL_noarg))
-                                break;
-                        }
-
-                        if (j >= c->cmds.len) {
-                            is_tail = OX_TRUE;
-                        } else if (ncmd->bc == OX_BC_ret) {
-                            if (ncmd->s.s0 == cmd->d.d0)
-                                is_tail = OX_TRUE;
-                        } else if (ncmd->bc == OX_BC_load_null) {
-                            if (j + 1 < c->cmds.len) {
-                                OX_Command *nncmd = &ox_vector_item(&c->cmds, j + 1);
-
-                                if ((nncmd->bc == OX_BC_ret) && (nncmd->s.s0 == ncmd->d.d0))
-                                    is_tail = OX_TRUE;
-                            }
-                        }
-
-                        if (is_tail)
-                            cmd->bc = OX_BC_call_end_tail;
-                    }
+                    if ((top_ip == 0) && !is_in_try(c, ip) && is_tail_call(c, i))
+                        cmd->bc = OX_BC_call_end_tail;
                     break;
                 default:
                     break;
@@ -3564,6 +4636,8 @@ ox_compile (OX_Context *ctxt, OX_Value *input, OX_Value *ast, OX_Value *sv, int
 
     compiler_init(ctxt, &c, ip, flags);
 
+    c.folded = ox_value_stack_push(ctxt);
+
     if (!(s = ox_bc_script_new(ctxt, sv, ip,
             (flags & OX_COMPILE_FL_REGISTER) ? OX_TRUE : OX_FALSE))) {
         r = OX_ERR;
@@ -3579,10 +4653,18 @@ ox_compile (OX_Context *ctxt, OX_Value *input, OX_Value *ast, OX_Value *sv, int
         r = ox_throw_range_error(ctxt, OX_TEXT("too many functions defined"));
         goto end;
     }
+    /*The allocation may run the garbage collecter,
+     *so the functions are scanned only after their declaration lists are initialized.*/
+    ox_not_null(OX_NEW_N(ctxt, s->sfuncs, len));
+    for (i = 0; i < len; i ++) {
+        ox_size_hash_init(&s->sfuncs[i].decl_hash);
+        ox_list_init(&s->sfuncs[i].decl_list);
+        s->sfuncs[i].jit = NULL;
+        s->sfuncs[i].caps = NULL;
+        s->sfuncs[i].cap_num = 0;
+    }
     s->sfunc_num = len;
 
-    ox_not_null(OX_NEW_N(ctxt, s->sfuncs, s->sfunc_num));
-
     /*Initialize the functions.*/
     for (i = 0; i < s->sfunc_num; i ++) {
         ox_not_error(ox_array_get_item(ctxt, funcs, i, func));
@@ -3603,17 +4685,21 @@ ox_compile (OX_Context *ctxt, OX_Value *input, OX_Value *ast, OX_Value *sv, int
         func_add_decls(ctxt, &c);
     }
 
-    /*Store the functions.*/
-    for (i = 0; i < s->sfunc_num; i ++) {
+    /*Store the functions.
+     *The inner functions are compiled before the outer functions,
+     *so the captured declarations are marked before their owner is compiled.
+     *The functions' indexes are in post order except the script function 0.*/
+    for (i = 1; i <= s->sfunc_num; i ++) {
+        size_t fid = i % s->sfunc_num;
         int rr = -1;
 
-        ox_not_error(ox_array_get_item(ctxt, funcs, i, func));
+        ox_not_error(ox_array_get_item(ctxt, funcs, fid, func));
 
-        c.sf = &s->sfuncs[i];
+        c.sf = &s->sfuncs[fid];
         c.f = func;
         c.regs.len = 0;
 
-        if ((flags & OX_COMPILE_FL_EXPR) && (i == 0))
+        if ((flags & OX_COMPILE_FL_EXPR) && (fid == 0))
             rr = add_reg(ctxt, &c);
 
         if ((r = compile_func(ctxt, &c, rr)) == OX_ERR)
@@ -3634,6 +4720,13 @@ ox_compile (OX_Context *ctxt, OX_Value *input, OX_Value *ast, OX_Value *sv, int
         memcpy(s->loc_tab, c.ltab.items, s->loc_tab_len * sizeof(OX_ScriptLoc));
     }
 
+    /*Store exception handling table to script.*/
+    s->try_tab_len = c.ttab.len;
+    if (s->try_tab_len) {
+        ox_not_null(OX_NEW_N(ctxt, s->try_tab, s->try_tab_len));
+        memcpy(s->try_tab, c.ttab.items, s->try_tab_len * sizeof(OX_ScriptTry));
+    }
+
     /*Store the constant values.*/
     len = c.cv_hash.e_num;
     if (len) {
@@ -3649,6 +4742,12 @@ ox_compile (OX_Context *ctxt, OX_Value *input, OX_Value *ast, OX_Value *sv, int
         }
     }
 
+    /*Allocate the property caches.*/
+    if (c.pc_num) {
+        s->pc_num = c.pc_num;
+        ox_not_null(OX_NEW_N_0(ctxt, s->pcs, s->pc_num));
+    }
+
     /*Store the private property names.*/
     len = c.pp_hash.e_num;
     if (len) {
@@ -3675,6 +4774,7 @@ ox_compile (OX_Context *ctxt, OX_Value *input, OX_Value *ast, OX_Value *sv, int
 
         s->t_num = len;
         ox_not_null(OX_NEW_N(ctxt, s->ts, s->t_num));
+        ox_values_set_null(ctxt, s->ts, s->t_num);
         ox_not_null(OX_NEW_N(ctxt, s->lts, s->t_num));
         ox_values_set_null(ctxt, s->lts, s->t_num);
         ox_hash_foreach_c(&c.lt_hash, i, cv, OX_CompValue, he) {
@@ -3692,6 +4792,7 @@ ox_compile (OX_Context *ctxt, OX_Value *input, OX_Value *ast, OX_Value *sv, int
 
         s->tt_num = len;
         ox_not_null(OX_NEW_N(ctxt, s->tts, s->tt_num));
+        ox_values_set_null(ctxt, s->tts, s->tt_num);
         ox_not_null(OX_NEW_N(ctxt, s->ltts, s->tt_num));
         ox_values_set_null(ctxt, s->ltts, s->tt_num);
         ox_hash_foreach_c(&c.ltt_hash, i, cv, OX_CompValue, he) {
@@ -3869,6 +4970,24 @@ ox_decompile (OX_Context *ctxt, OX_Value *script, FILE *fp)
             fprintf(fp, "\n");
         }
 
+        /*Captured values.*/
+        if (sf->cap_num) {
+            static const char *cap_types[] = {"local", "this", "outer"};
+            size_t j;
+
+            fprintf(fp, "  captures:");
+
+            for (j = 0; j < sf->cap_num; j ++) {
+                OX_ScriptCapture *cap = &sf->caps[j];
+
+                fprintf(fp, "%s%"PRIdPTR": %s %d", j ? ", " : " ", j, cap_types[cap->type], cap->id);
+                if (cap->decl)
+                    fprintf(fp, " (%s)", ((OX_String*)cap->decl->he.key)->chars);
+            }
+
+            fprintf(fp, "\n");
+        }
+
         /*Bytecode.*/
         bc = s->bc + sf->bc_start;
         bc_end = bc + sf->bc_len;
@@ -3943,7 +5062,7 @@ auto_close_all (OX_Context *ctxt, OX_ScriptFunc *sf, OX_Frame *f)
         if (!(decl->type & OX_DECL_AUTO_CLOSE))
             break;
 
-        v = &f->v[decl->id];
+        v = ox_cell_value(ctxt, &f->v[decl->id]);
 
         if ((r = auto_close(ctxt, v)) == OX_ERR)
             return r;
@@ -3990,8 +5109,222 @@ run_status_from_rec (OX_Context *ctxt, OX_RunStatus *rs, OX_RunStatusRec *rsr)
     rs->argv = ox_values_item(ctxt, rs->regs, rs->sf->reg_num);
 }
 
+/*Lookup the try statement handling the result at the current instruction.*/
+static OX_ScriptTry*
+try_lookup (OX_RunStatus *rs, OX_Result r)
+{
+    OX_ScriptTry *bt = rs->s->try_tab + rs->sf->try_start;
+    OX_ScriptTry *t = bt + rs->sf->try_len;
+    int ip = rs->frame->ip;
+
+    /*The inner try statements are stored after the outer ones.*/
+    while (t > bt) {
+        int start, end;
+
+        t --;
+
+        if ((ip < t->start) || (ip >= t->finally_ip))
+            continue;
+
+        if (ip < t->catch_ip) {
+            /*In the try block.*/
+            if ((r == OX_ERR) && (t->flags & OX_SCRIPT_TRY_FL_CATCH))
+                return t;
+
+            if (!(t->flags & OX_SCRIPT_TRY_FL_FINALLY))
+                continue;
+
+            start = t->start;
+            end = t->catch_ip;
+        } else {
+            /*In the catch block.*/
+            start = t->catch_ip;
+            end = t->finally_ip;
+        }
+
+        /*Jump in the block need not run the finally block.*/
+        if ((r == OX_DEEP_JUMP) && (rs->jmp_ip >= (size_t)start) && (rs->jmp_ip < (size_t)end))
+            continue;
+
+        return t;
+    }
+
+    return NULL;
+}
+
 #include "ox_run.h"
 
+#if defined(__GNUC__) && !defined(OX_NO_THREADED_CODE)
+/*Use labels as values to dispatch the bytecodes.*/
+#define OX_THREADED_CODE 1
+#else
+#define OX_THREADED_CODE 0
+#endif
+
+#if defined(__GNUC__) && defined(__x86_64__) && defined(ARCH_LINUX) && !defined(OX_NO_JIT)
+/*Compile the hot functions to native code.*/
+#define OX_JIT 1
+#else
+#define OX_JIT 0
+#endif
+
+#include "ox_jit.h"
+
+/*Store the instruction pointer to the frame.*/
+#define OX_BC_SAVE_IP()\
+    OX_STMT_BEGIN\
+        rs.frame->ip = ip;\
+    OX_STMT_END
+
+/*Reload the running status after the frame's instruction pointer changed.*/
+#define OX_BC_RELOAD()\
+    OX_STMT_BEGIN\
+        ip = rs.frame->ip;\
+        bc_base = rs.s->bc + rs.sf->bc_start;\
+        bc_len = rs.sf->bc_len;\
+    OX_STMT_END
+
+#if OX_JIT
+/*Run the native code if the current function is compiled.*/
+#define OX_BC_JIT_CHECK()\
+    OX_STMT_BEGIN\
+        if (jit_ready(ctxt, &rs))\
+            goto jit;\
+    OX_STMT_END
+#else
+#define OX_BC_JIT_CHECK()
+#endif
+
+#ifdef OX_BC_STAT
+/*Number of the bytecodes.*/
+#define OX_BC_NUM (OX_BC_nop + 1)
+
+/*Bytecode pair counters.*/
+static uint64_t bc_pair_stat[OX_BC_NUM][OX_BC_NUM];
+
+/*Count the bytecode and the previous one.*/
+#define OX_BC_STAT_ADD(b)\
+    OX_STMT_BEGIN\
+        bc_pair_stat[prev_bc][b] ++;\
+        prev_bc = (b);\
+    OX_STMT_END
+
+/*Bytecode pair statistics entry.*/
+typedef struct {
+    uint8_t  bc[2]; /*The bytecodes.*/
+    uint64_t cnt;   /*The counter.*/
+} OX_BcPairStat;
+
+/*Compare the bytecode pairs' counters.*/
+static int
+bc_pair_stat_cmp (const void *p1, const void *p2)
+{
+    const OX_BcPairStat *s1 = p1;
+    const OX_BcPairStat *s2 = p2;
+
+    if (s1->cnt == s2->cnt)
+        return 0;
+
+    return (s1->cnt < s2->cnt) ? 1 : -1;
+}
+
+/**
+ * Dump the bytecode pair statistics.
+ * The result is written to the file specified by environment variable
+ * "OX_BC_STAT_FILE", or to the standard error output if it is not set.
+ */
+void
+ox_bc_stat_dump (void)
+{
+    OX_BcPairStat *stats;
+    const char *fn;
+    FILE *fp;
+    uint64_t total = 0;
+    size_t i, j, n = 0;
+
+    stats = malloc(sizeof(OX_BcPairStat) * OX_BC_NUM * OX_BC_NUM);
+    if (!stats)
+        return;
+
+    for (i = 0; i < OX_BC_NUM; i ++) {
+        for (j = 0; j < OX_BC_NUM; j ++) {
+            uint64_t cnt = bc_pair_stat[i][j];
+
+            if (cnt) {
+                stats[n].bc[0] = i;
+                stats[n].bc[1] = j;
+                stats[n].cnt = cnt;
+                total += cnt;
+                n ++;
+            }
+        }
+    }
+
+    qsort(stats, n, sizeof(OX_BcPairStat), bc_pair_stat_cmp);
+
+    if ((fn = getenv("OX_BC_STAT_FILE"))) {
+        if (!(fp = fopen(fn, "a")))
+            fp = stderr;
+    } else {
+        fp = stderr;
+    }
+
+    fprintf(fp, "bytecode pairs: %llu\n", (unsigned long long)total);
+
+    for (i = 0; i < n; i ++) {
+        fprintf(fp, "%16llu %6.2f%% %-12s %s\n",
+                (unsigned long long)stats[i].cnt,
+                (double)stats[i].cnt * 100 / total,
+                bytecode_names[stats[i].bc[0]],
+                bytecode_names[stats[i].bc[1]]);
+    }
+
+    if (fp != stderr)
+        fclose(fp);
+
+    free(stats);
+}
+#else /*!defined OX_BC_STAT*/
+#define OX_BC_STAT_ADD(b)
+#endif /*OX_BC_STAT*/
+
+#if OX_THREADED_CODE
+/*Bytecode entry.*/
+#define OX_BC_CASE(n)\
+    case OX_BC_##n:\
+    bc_label_##n:
+
+/*Jump to the next bytecode directly.*/
+#define OX_BC_DISPATCH()\
+    {\
+        if (ip >= bc_len)\
+            goto end;\
+        bc = bc_base + ip;\
+        OX_BC_STAT_ADD(bc[0]);\
+        goto *bc_labels[bc[0]];\
+    }
+#else
+/*Bytecode entry.*/
+#define OX_BC_CASE(n)\
+    case OX_BC_##n:
+
+/*Return to the switch loop.*/
+#define OX_BC_DISPATCH()\
+    break
+#endif
+
+/*Solve the bytecode's result and run the next bytecode.*/
+#define OX_BC_NEXT(n)\
+    if (r == OX_JUMP) {\
+        OX_BC_RELOAD();\
+        OX_BC_JIT_CHECK();\
+    } else if (r != OX_OK) {\
+        goto pop;\
+    } else {\
+        ip += (n);\
+    }\
+    OX_BC_DISPATCH()
+
 /**
  * Call the function.
  * @param ctxt The current running context.
@@ -4013,6 +5346,16 @@ ox_function_call (OX_Context *ctxt, OX_Value *f, OX_Value *thiz,
     OX_ValueBuffer *old_v_stack = NULL;
     size_t sp;
     OX_RunStatus rs;
+    uint8_t *bc_base, *bc;
+    int ip, bc_len;
+#ifdef OX_BC_STAT
+    int prev_bc = OX_BC_nop;
+#endif /*OX_BC_STAT*/
+#if OX_THREADED_CODE
+    static const void *bc_labels[] = {
+#include "ox_bytecode_label.h"
+    };
+#endif
     
     if (fiber) {
         assert((fiber->state != OX_FIBER_STATE_END)
@@ -4051,11 +5394,15 @@ ox_function_call (OX_Context *ctxt, OX_Value *f, OX_Value *thiz,
     rs.fiber = fiber;
 
 run:
-    while (rs.frame->ip < rs.sf->bc_len) {
-        uint8_t *bc = rs.s->bc + rs.sf->bc_start + rs.frame->ip;
+    OX_BC_RELOAD();
+    OX_BC_JIT_CHECK();
+
+    while (ip < bc_len) {
+        bc = bc_base + ip;
+        OX_BC_STAT_ADD(bc[0]);
 
 #if 0
-        fprintf(stderr, "  %05d: ", rs.frame->ip);
+        fprintf(stderr, "  %05d: ", ip);
             
         bytecode_decompile(ctxt, rs.s, bc, stderr);
 
@@ -4065,69 +5412,93 @@ run:
         switch (bc[0]) {
 #include "ox_bytecode_run.h"
         default:
+#if OX_THREADED_CODE
+        bc_label_invalid:
+#endif
             assert(0);
         }
     }
 
+#if OX_THREADED_CODE
+end:
+#endif
+    rs.frame->ip = ip;
     ox_value_set_null(ctxt, rs.rv);
     r = OX_RETURN;
+#if OX_JIT
+    goto pop;
+jit:
+    r = jit_run(ctxt, &rs);
+    if (r == OX_JUMP)
+        goto run;
+#endif
 pop:
     if (r != OX_YIELD) {
         /*Solve the stack.*/
         while (1) {
+            OX_ScriptTry *st = try_lookup(&rs, r);
+            size_t level = rs.sp;
             OX_Stack *se;
 
-            if (r == OX_DEEP_JUMP) {
-                if (rs.jmp_sp == ctxt->s_stack->len) {
+            if (st) {
+                level += st->level;
+
+                /*The catch block has the try entry.*/
+                if (rs.frame->ip >= st->catch_ip)
+                    level ++;
+            }
+
+            /*Popup the entries above the handler.*/
+            while (ctxt->s_stack->len > level) {
+                if ((r == OX_DEEP_JUMP) && (rs.jmp_sp == ctxt->s_stack->len)) {
                     rs.frame->ip = rs.jmp_ip;
                     goto run;
                 }
-            }
-
-            if (ctxt->s_stack->len == sp)
-                break;
 
-            se = &ox_vector_item(ctxt->s_stack, ctxt->s_stack->len - 1);
+                ox_stack_pop(ctxt);
+            }
 
-            if (se->type == OX_STACK_TRY) {
+            if (st) {
                 int ip;
 
-                if (se->s.t.state == OX_TRY_STATE_TRY) {
-                    if (r == OX_RETURN) {
-                        ip = se->s.t.finally_label;
-                        se->s.t.state = OX_TRY_STATE_FINALLY;
-                    } else if (r == OX_DEEP_JUMP) {
-                        ip = se->s.t.finally_label;
-                        se->s.t.state = OX_TRY_STATE_FINALLY;
-                        se->s.t.jmp_ip = rs.jmp_ip;
-                        se->s.t.jmp_sp = rs.jmp_sp;
-                    } else {
-                        ip = se->s.t.catch_label;
-                        se->s.t.state = OX_TRY_STATE_CATCH;
-                    }
+                if (rs.frame->ip < st->catch_ip) {
+                    se = ox_stack_push(ctxt, OX_STACK_TRY);
+                    se->s.t.jmp_ip = 0;
+                    se->s.t.jmp_sp = 0;
 
-                    se->s.t.r = r;
+                    if ((r == OX_ERR) && (st->flags & OX_SCRIPT_TRY_FL_CATCH))
+                        ip = st->catch_ip;
+                    else
+                        ip = st->finally_ip;
+                } else {
+                    se = ox_stack_top(ctxt);
+                    ip = st->finally_ip;
+                }
 
-                    if (ip < rs.sf->bc_len - 1) {
-                        rs.frame->ip = ip;
-                        goto run;
-                    }
-                } else if (se->s.t.state == OX_TRY_STATE_CATCH) {
-                    if (r == OX_DEEP_JUMP) {
-                        se->s.t.jmp_ip = rs.jmp_ip;
-                        se->s.t.jmp_sp = rs.jmp_sp;
-                    }
-                    
-                    ip = se->s.t.finally_label;
-                    se->s.t.state = OX_TRY_STATE_FINALLY;
-                    se->s.t.r = r;
-
-                    if (ip < rs.sf->bc_len - 1) {
-                        rs.frame->ip = ip;
-                        goto run;
-                    }
+                if (r == OX_DEEP_JUMP) {
+                    se->s.t.jmp_ip = rs.jmp_ip;
+                    se->s.t.jmp_sp = rs.jmp_sp;
                 }
-            } else if (se->type == OX_STACK_RETURN) {
+
+                se->s.t.r = r;
+                rs.frame->ip = ip;
+                goto run;
+            }
+
+            if ((r == OX_DEEP_JUMP) && (rs.jmp_sp == ctxt->s_stack->len)) {
+                rs.frame->ip = rs.jmp_ip;
+                goto run;
+            }
+
+            if (ctxt->s_stack->len == sp)
+                break;
+
+            /*Return to the caller.*/
+            se = &ox_vector_item(ctxt->s_stack, ctxt->s_stack->len - 1);
+            assert(se->type == OX_STACK_RETURN);
+
+            {
+                size_t ap = se->s.r.ap;
                 int cr;
 
                 cr = auto_close_all(ctxt, rs.sf, rs.frame);
@@ -4138,18 +5509,25 @@ pop:
                     ox_value_copy(ctxt, se->s.r.rv, rs.rv);
 
                 run_status_from_rec(ctxt, &rs, &se->s.r);
-                if (r != OX_ERR)
-                    rs.frame->ip += 2;
+                if (r != OX_ERR) {
+                    /*Skip the calling bytecode.*/
+                    OX_ByteCode cbc = rs.s->bc[rs.sf->bc_start + rs.frame->ip];
+
+                    rs.frame->ip += bytecode_len_table[bytecode_models[cbc]];
+                }
 
                 ox_stack_pop(ctxt);
 
-                if (r == OX_RETURN) {
+                if (ap != (size_t)-1) {
+                    /*Directly called function has no call entry.*/
+                    ox_value_stack_pop(ctxt, OX_VALUE_IDX2PTR(ap));
+                } else if (r == OX_RETURN) {
                     ox_stack_pop(ctxt);
-                    goto run;
                 }
-            }
 
-            ox_stack_pop(ctxt);
+                if (r == OX_RETURN)
+                    goto run;
+            }
         }
 
         if (r == OX_RETURN)
@@ -4165,6 +5543,7 @@ pop:
             fiber->state = OX_FIBER_STATE_ERROR;
             ox_value_copy(ctxt, &fiber->rv, &ctxt->error);
         } else if (r == OX_YIELD) {
+            ox_frame_escape(ctxt, ctxt->frames);
             run_status_to_rec(ctxt, &rs, &fiber->rsr);
             r = OX_OK;
         } else {
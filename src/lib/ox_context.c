@@ -162,6 +162,50 @@ ox_set_dump_throw (OX_Context *ctxt, OX_Bool b)
     return OX_OK;
 }
 
+/**
+ * Set the bytecode optimization level of the compiler.
+ * @param ctxt The current running context.
+ * @param level The optimization level.
+ * 0 means do not optimize the bytecode.
+ * @retval OX_OK On success.
+ * @retval OX_ERR On error.
+ */
+OX_Result
+ox_set_opt_level (OX_Context *ctxt, int level)
+{
+    OX_VM *vm;
+
+    assert(ctxt);
+
+    vm = ox_vm_get(ctxt);
+
+    vm->opt_level = level;
+
+    return OX_OK;
+}
+
+/**
+ * Enable or disable the JIT compiler.
+ * The JIT compiler is only available on x86-64 Linux.
+ * @param ctxt The current running context.
+ * @param b Enable the JIT compiler or not.
+ * @retval OX_OK On success.
+ * @retval OX_ERR On error.
+ */
+OX_Result
+ox_set_jit (OX_Context *ctxt, OX_Bool b)
+{
+    OX_VM *vm;
+
+    assert(ctxt);
+
+    vm = ox_vm_get(ctxt);
+
+    vm->jit = b;
+
+    return OX_OK;
+}
+
 /**
  * Dump the stack information.
  * @param ctxt The current running context.
@@ -172,19 +216,20 @@ ox_stack_dump (OX_Context *ctxt, FILE *fp)
 {
     assert(ctxt && fp);
 
-    if (ctxt->error_frames) {
+    if (ctxt->error_frames.len) {
         OX_VS_PUSH(ctxt, name)
-        OX_Frame *frame;
+        OX_ErrorFrame *frame;
         OX_Result r;
-        int i = 0;
+        size_t i;
 
         fprintf(fp, OX_TEXT("stack:\n"));
 
-        frame = ctxt->error_frames;
-        while (frame) {
+        for (i = 0; i < ctxt->error_frames.len; i ++) {
             OX_Bool need_lf = OX_TRUE;
 
-            fprintf(fp, "#%d: ", i);
+            frame = &ox_vector_item(&ctxt->error_frames, i);
+
+            fprintf(fp, "#%d: ", (int)i);
 
             if (ox_value_get_gco_type(ctxt, &frame->func) == OX_GCO_FUNCTION) {
                 /*Byte code function.*/
@@ -248,9 +293,6 @@ ox_stack_dump (OX_Context *ctxt, FILE *fp)
 
             if (need_lf)
                 fprintf(fp, "\n");
-
-            i ++;
-            frame = frame->bot;
         }
 
         OX_VS_POP(ctxt, name)
@@ -3157,6 +3157,69 @@ end:
     return r;
 }
 
+/*Fast iteration step of the C array.*/
+static OX_Result
+carray_iter_step (OX_Context *ctxt, OX_Value *a, size_t *pos, OX_Value *v)
+{
+    OX_CValue *cv = ox_value_get_gco(ctxt, a);
+    OX_CPtrType *pt = ox_value_get_gco(ctxt, &cv->cty);
+    OX_CType *it = ox_value_get_gco(ctxt, &pt->vty);
+    OX_CValueInfo cvi;
+    OX_Result r;
+
+    if (*pos >= (size_t)pt->len)
+        return OX_FALSE;
+
+    if (!cv->v.p)
+        return ox_throw_null_error(ctxt, OX_TEXT("the C array is freed"));
+
+    cvi.v.p = ((uint8_t*)cv->v.p) + *pos * it->size;
+    cvi.base = a;
+    cvi.own = OX_CPTR_NON_OWNER;
+
+    if ((r = ox_cptr_get_value(ctxt, &pt->vty, &cvi, v)) == OX_ERR)
+        return r;
+
+    (*pos) ++;
+    return OX_TRUE;
+}
+
+/**
+ * Get the fast iteration step function of the C array.
+ * @param ctxt The current running context.
+ * @param v The value to be iterated.
+ * @param cf The "$iter" method of the value.
+ * @return The step function.
+ * @retval NULL The value is not a C array with known length or cf is not the C pointer's "$iter" method.
+ */
+OX_IterStepFunc
+ox_carray_iter_step_get (OX_Context *ctxt, OX_Value *v, OX_CFunc cf)
+{
+    OX_CValue *cv;
+    OX_CType *t;
+    OX_CPtrType *pt;
+    OX_CType *it;
+
+    if ((cf != CPointer_inf_iter) || !ox_value_is_cvalue(ctxt, v))
+        return NULL;
+
+    cv = ox_value_get_gco(ctxt, v);
+    t = ox_value_get_gco(ctxt, &cv->cty);
+    if (t->kind != OX_CTYPE_PTR)
+        return NULL;
+
+    /*Let the iterator report the errors.*/
+    pt = (OX_CPtrType*)t;
+    if (pt->len == -1)
+        return NULL;
+
+    it = ox_value_get_gco(ctxt, &pt->vty);
+    if (it->size == -1)
+        return NULL;
+
+    return carray_iter_step;
+}
+
 /*CPointer.$inf.$to_json*/
 static OX_Result
 CPointer_inf_to_json (OX_Context *ctxt, OX_Value *f, OX_Value *thiz, OX_Value *args, size_t argc, OX_Value *rv)
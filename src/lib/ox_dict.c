@@ -126,6 +126,8 @@ dict_add_entry (OX_Context *ctxt, OX_Value *o, OX_Value *k, OX_Value *v)
 
     de = ox_hash_lookup_c(ctxt, &dict->e_hash, k, &pe, OX_DictEntry, he);
 
+    ox_gc_write_barrier(ctxt, dict);
+
     if (de) {
         ox_value_copy(ctxt, &de->v, v);
     } else {
@@ -67,6 +67,42 @@ throw_error_v (OX_Context *ctxt, OX_Value *c, const char *fmt, va_list ap)
     return OX_ERR;
 }
 
+/*Record the frames' functions and instruction pointers.
+ *The frames are reused after popped, so they cannot be referenced directly.
+ *The line numbers are looked up only when the stack is dumped.*/
+static void
+error_frames_record (OX_Context *ctxt)
+{
+    OX_Frame *f;
+    size_t n = 0;
+
+    for (f = ctxt->frames; f; f = f->bot)
+        n ++;
+
+    ctxt->error_frames.len = 0;
+
+    /*Throwing an error here would record the frames again,
+     *so the stack is just not recorded when the memory is exhausted.*/
+    if (ctxt->error_frames.cap < n) {
+        OX_ErrorFrame *items;
+        size_t cap = OX_MAX(ctxt->error_frames.cap * 2, n);
+
+        items = OX_RENEW(ctxt, ctxt->error_frames.items, ctxt->error_frames.cap, cap);
+        if (!items)
+            return;
+
+        ctxt->error_frames.items = items;
+        ctxt->error_frames.cap = cap;
+    }
+
+    for (f = ctxt->frames; f; f = f->bot) {
+        OX_ErrorFrame *ef = &ox_vector_item(&ctxt->error_frames, ctxt->error_frames.len ++);
+
+        ox_value_copy(ctxt, &ef->func, &f->func);
+        ef->ip = f->ip;
+    }
+}
+
 /**
  * Throw an error.
  * @param ctxt The current running context.
@@ -79,7 +115,7 @@ ox_throw (OX_Context *ctxt, OX_Value *e)
     OX_VM *vm = ox_vm_get(ctxt);
     OX_Result r;
 
-    ctxt->error_frames = ctxt->frames;
+    error_frames_record(ctxt);
 
     ox_value_copy(ctxt, &ctxt->error, e);
 
@@ -148,13 +184,19 @@ ox_throw_system_error (OX_Context *ctxt, const char *fmt, ...)
 OX_Result
 ox_throw_no_mem_error (OX_Context *ctxt)
 {
+    OX_VM *vm = ox_vm_get(ctxt);
     OX_VS_PUSH(ctxt, s)
     OX_Result r;
 
+    /*The error object is allocated even if the maximum heap size is exceeded.*/
+    vm->gc_busy ++;
+
     r = ox_string_from_const_char_star(ctxt, s, OX_TEXT("not enough memory"));
     if (r == OX_OK)
         throw_error_s(ctxt, OX_OBJECT(ctxt, NoMemoryError), s);
 
+    vm->gc_busy --;
+
     OX_VS_POP(ctxt, s)
 
     return OX_ERR;
@@ -40,7 +40,8 @@ frame_scan (OX_Context *ctxt, OX_GcObject *gco)
 
     ox_gc_scan_value(ctxt, &f->func);
 
-    if (f->bot)
+    /*The bottom frame may be still in the stack when the frame is escaping.*/
+    if (f->bot && f->bot->escaped)
         ox_gc_mark(ctxt, f->bot);
 
     if (f->v)
@@ -49,18 +50,27 @@ frame_scan (OX_Context *ctxt, OX_GcObject *gco)
     ox_gc_scan_value(ctxt, &f->thiz);
 }
 
-/*Free the value frame.*/
-static void
-frame_free (OX_Context *ctxt, OX_GcObject *gco)
+/**
+ * Free the value frame.
+ * @param ctxt The current running context.
+ * @param f The frame to be freed.
+ */
+void
+ox_frame_free (OX_Context *ctxt, OX_Frame *f)
 {
-    OX_Frame *f = (OX_Frame*)gco;
-
     if (f->v)
-        OX_DEL_N(ctxt, f->v, f->len);
+        OX_DEL_N(ctxt, f->v, f->cap);
 
     OX_DEL(ctxt, f);
 }
 
+/*Free the value frame.*/
+static void
+frame_free (OX_Context *ctxt, OX_GcObject *gco)
+{
+    ox_frame_free(ctxt, (OX_Frame*)gco);
+}
+
 /*Operation of the value frame.*/
 static const OX_GcObjectOps
 frame_ops = {
@@ -69,48 +79,217 @@ frame_ops = {
     frame_free
 };
 
-/**
- * Push a new frame to the stack.
- * @param ctxt The current running context.
- * @param func The function use this frame.
- * @param len Frame's value buffer length.
- * @return The new frame.
- */
-OX_Frame*
-ox_frame_push (OX_Context *ctxt, OX_Value *func, size_t len)
+/*Allocate a frame.*/
+static OX_Frame*
+frame_alloc (OX_Context *ctxt, OX_Value *func, size_t len)
 {
     OX_Frame *f;
 
-    assert(ctxt && func);
+    if ((f = ctxt->frame_cache)) {
+        ctxt->frame_cache = f->bot;
+        ctxt->frame_cache_num --;
+    } else {
+        if (!OX_NEW(ctxt, f)) {
+            ox_throw_no_mem_error(ctxt);
+            return NULL;
+        }
 
-    if (!OX_NEW(ctxt, f)) {
-        ox_throw_no_mem_error(ctxt);
-        return NULL;
+        f->v = NULL;
+        f->cap = 0;
     }
 
-    if (len) {
+    if (len > f->cap) {
+        if (f->v)
+            OX_DEL_N(ctxt, f->v, f->cap);
+
         if (!OX_NEW_N(ctxt, f->v, len)) {
+            f->cap = 0;
+            ox_frame_free(ctxt, f);
             ox_throw_no_mem_error(ctxt);
-            OX_DEL(ctxt, f);
             return NULL;
         }
 
-        ox_values_set_null(ctxt, f->v, len);
-    } else {
-        f->v = NULL;
+        f->cap = len;
     }
 
+    if (len)
+        ox_values_set_null(ctxt, f->v, len);
+
     f->gco.ops = &frame_ops;
+    f->escaped = OX_FALSE;
     f->ip = -1;
-    f->bot = ctxt->frames;
     f->len = len;
 
     ox_value_set_null(ctxt, &f->thiz);
     ox_value_copy(ctxt, &f->func, func);
 
+    return f;
+}
+
+/**
+ * Push a new frame to the stack.
+ * The frame is allocated from the context's frame cache and is not managed by GC,
+ * until it is escaped by "ox_frame_escape".
+ * @param ctxt The current running context.
+ * @param func The function use this frame.
+ * @param len Frame's value buffer length.
+ * @return The new frame.
+ */
+OX_Frame*
+ox_frame_push (OX_Context *ctxt, OX_Value *func, size_t len)
+{
+    OX_Frame *f;
+
+    assert(ctxt && func);
+
+    if (!(f = frame_alloc(ctxt, func, len)))
+        return NULL;
+
+    f->bot = ctxt->frames;
     ctxt->frames = f;
 
+    return f;
+}
+
+/**
+ * Create a new frame managed by GC.
+ * The frame is not pushed to the stack.
+ * @param ctxt The current running context.
+ * @param func The function use this frame.
+ * @param len Frame's value buffer length.
+ * @return The new frame.
+ */
+OX_Frame*
+ox_frame_new (OX_Context *ctxt, OX_Value *func, size_t len)
+{
+    OX_Frame *f;
+
+    assert(ctxt && func);
+
+    if (!(f = frame_alloc(ctxt, func, len)))
+        return NULL;
+
+    f->bot = NULL;
+    f->escaped = OX_TRUE;
+
     ox_gc_add(ctxt, f);
 
     return f;
 }
+
+/**
+ * Escape the frame and the frames under it.
+ * The escaped frames are managed by GC and will not be reused when popped.
+ * Frames must be escaped before they are referenced by a closure, a fiber or an error.
+ * @param ctxt The current running context.
+ * @param f The frame.
+ */
+void
+ox_frame_escape (OX_Context *ctxt, OX_Frame *f)
+{
+    /*The frames under an escaped frame are always escaped.*/
+    while (f && !f->escaped) {
+        f->escaped = OX_TRUE;
+
+        ox_gc_add(ctxt, f);
+
+        f = f->bot;
+    }
+}
+
+/**
+ * Scan the frames in the stack.
+ * @param ctxt The current running context.
+ * @param f The top frame of the stack.
+ */
+void
+ox_gc_scan_frames (OX_Context *ctxt, OX_Frame *f)
+{
+    while (f) {
+        if (f->escaped) {
+            ox_gc_mark(ctxt, f);
+        } else {
+            ox_gc_scan_value(ctxt, &f->func);
+
+            if (f->v)
+                ox_gc_scan_values(ctxt, f->v, f->len);
+
+            ox_gc_scan_value(ctxt, &f->thiz);
+        }
+
+        f = f->bot;
+    }
+}
+
+/**
+ * Release the frames in the context.
+ * @param ctxt The current running context.
+ */
+void
+ox_frame_cache_deinit (OX_Context *ctxt)
+{
+    OX_Frame *f, *nf;
+
+    for (f = ctxt->frame_cache; f; f = nf) {
+        nf = f->bot;
+        ox_frame_free(ctxt, f);
+    }
+
+    ctxt->frame_cache = NULL;
+    ctxt->frame_cache_num = 0;
+}
+
+/*Scan referenced objects in the cell.*/
+static void
+cell_scan (OX_Context *ctxt, OX_GcObject *gco)
+{
+    OX_Cell *c = (OX_Cell*)gco;
+
+    ox_gc_scan_value(ctxt, &c->v);
+}
+
+/*Free the cell.*/
+static void
+cell_free (OX_Context *ctxt, OX_GcObject *gco)
+{
+    OX_Cell *c = (OX_Cell*)gco;
+
+    OX_DEL(ctxt, c);
+}
+
+/*Operation of the cell.*/
+static const OX_GcObjectOps
+cell_ops = {
+    OX_GCO_CELL,
+    cell_scan,
+    cell_free
+};
+
+/**
+ * Create a new cell.
+ * The declarations captured by reference are stored in cells,
+ * the frame and the inner functions share the cell.
+ * @param ctxt The current running context.
+ * @param[out] c Return the new cell.
+ * @param v The initial value.
+ * @retval OX_OK On success.
+ * @retval OX_ERR On error.
+ */
+OX_Result
+ox_cell_new (OX_Context *ctxt, OX_Value *c, OX_Value *v)
+{
+    OX_Cell *cp;
+
+    assert(ctxt && c && v);
+
+    if (!OX_NEW(ctxt, cp))
+        return ox_throw_no_mem_error(ctxt);
+
+    cp->gco.ops = &cell_ops;
+    ox_value_copy(ctxt, &cp->v, v);
+
+    ox_value_set_gco(ctxt, c, cp);
+    ox_gc_add(ctxt, cp);
+
+    return OX_OK;
+}
@@ -54,6 +54,10 @@ function_scan (OX_Context *ctxt, OX_GcObject *gco)
                 ox_gc_mark(ctxt, ref);
         }
     }
+
+    /*Scan the captured values.*/
+    if (f->caps)
+        ox_gc_scan_values(ctxt, f->caps, f->sfunc->cap_num);
 }
 
 /*Free the function.*/
@@ -67,6 +71,9 @@ function_free (OX_Context *ctxt, OX_GcObject *gco)
     if (f->frames)
         OX_DEL_N(ctxt, f->frames, f->sfunc->frame_num);
 
+    if (f->caps)
+        OX_DEL_N(ctxt, f->caps, f->sfunc->cap_num);
+
     OX_DEL(ctxt, f);
 }
 
@@ -188,6 +195,7 @@ ox_native_func_new (OX_Context *ctxt, OX_Value *f, OX_CFunc cf)
     nf->o.gco.ops = (OX_GcObjectOps*)&native_func_ops;
     nf->cf = cf;
     nf->script = ctxt->curr_script;
+    nf->intrinsic = OX_INTRINSIC_NONE;
 
     ox_value_set_gco(ctxt, f, nf);
     ox_gc_add(ctxt, nf);
@@ -195,6 +203,26 @@ ox_native_func_new (OX_Context *ctxt, OX_Value *f, OX_CFunc cf)
     return OX_OK;
 }
 
+/**
+ * Set the intrinsic operation of the native function.
+ * The interpreter runs the operation inline when the function is called directly.
+ * @param ctxt The current running context.
+ * @param f The native function.
+ * @param id The intrinsic operation.
+ */
+void
+ox_native_func_set_intrinsic (OX_Context *ctxt, OX_Value *f, OX_Intrinsic id)
+{
+    OX_NativeFunc *nf;
+
+    assert(ctxt && f);
+    assert(ox_value_is_gco(ctxt, f, OX_GCO_NATIVE_FUNC));
+
+    nf = ox_value_get_gco(ctxt, f);
+
+    nf->intrinsic = id;
+}
+
 /**
  * Get the script contains the native function.
  * @param ctxt The current running context.
@@ -287,43 +315,73 @@ ox_named_native_func_new_s (OX_Context *ctxt, OX_Value *f, OX_CFunc cf,
 OX_Result
 ox_function_new (OX_Context *ctxt, OX_Value *f, OX_ScriptFunc *sfunc)
 {
-    OX_Function *fp;
+    OX_Function *fp, *bf = NULL;
+    OX_Frame *fr = NULL;
+    OX_Bool is_entry = (sfunc == sfunc->script->sfuncs);
 
     assert(ctxt && f && sfunc);
 
+    if (sfunc->frame_num || sfunc->cap_num) {
+        fr = ox_frame_get(ctxt);
+        assert(fr);
+        assert(ox_value_get_gco_type(ctxt, &fr->func) == OX_GCO_FUNCTION);
+
+        bf = ox_value_get_gco(ctxt, &fr->func);
+    }
+
     if (!OX_NEW(ctxt, fp))
         return ox_throw_no_mem_error(ctxt);
 
+    fp->frames = NULL;
+    fp->caps = NULL;
+
     if (sfunc->frame_num) {
-        OX_Frame **pf, *fr;
+        OX_Frame **pf;
+        size_t n = sfunc->frame_num;
 
-        if (!OX_NEW_N_0(ctxt, fp->frames, sfunc->frame_num)) {
-            OX_DEL(ctxt, fp);
-            return ox_throw_no_mem_error(ctxt);
-        }
-
-        /*Copy the frames.*/
-        fr = ox_frame_get(ctxt);
-        assert(fr);
+        if (!OX_NEW_N_0(ctxt, fp->frames, sfunc->frame_num))
+            goto error;
 
         pf = fp->frames;
 
-        *pf++ = fr;
-
-        if (sfunc->frame_num > 1) {
-            OX_Function *bf;
-            size_t n = sfunc->frame_num - 1;
+        /*Only the frames of the scripts' entry functions are referenced,
+         *the values of the other functions are captured.*/
+        if (is_entry || (bf->sfunc == bf->sfunc->script->sfuncs)) {
+            /*The frame is referenced by the function.*/
+            ox_frame_escape(ctxt, fr);
 
-            assert(ox_value_get_gco_type(ctxt, &fr->func) == OX_GCO_FUNCTION);
-
-            bf = ox_value_get_gco(ctxt, &fr->func);
+            *pf++ = fr;
+            n --;
+        }
 
+        if (n) {
             assert(bf->sfunc->frame_num >= n);
 
             memcpy(pf, bf->frames, sizeof(OX_Frame*) * n);
         }
-    } else {
-        fp->frames = NULL;
+    }
+
+    if (sfunc->cap_num) {
+        OX_ScriptCapture *cap;
+        OX_Value *v;
+
+        if (!OX_NEW_N(ctxt, fp->caps, sfunc->cap_num))
+            goto error;
+
+        /*Copy the captured values from the current frame and function.*/
+        for (cap = sfunc->caps, v = fp->caps; cap < sfunc->caps + sfunc->cap_num; cap ++, v ++) {
+            switch (cap->type) {
+            case OX_SCRIPT_CAP_LOCAL:
+                ox_value_copy(ctxt, v, &fr->v[cap->id]);
+                break;
+            case OX_SCRIPT_CAP_THIS:
+                ox_value_copy(ctxt, v, &fr->thiz);
+                break;
+            default:
+                ox_value_copy(ctxt, v, &bf->caps[cap->id]);
+                break;
+            }
+        }
     }
 
     ox_object_init(ctxt, &fp->o, OX_OBJECT(ctxt, Function_inf));
@@ -334,6 +392,11 @@ ox_function_new (OX_Context *ctxt, OX_Value *f, OX_ScriptFunc *sfunc)
     ox_gc_add(ctxt, fp);
 
     return OX_OK;
+error:
+    if (fp->frames)
+        OX_DEL_N(ctxt, fp->frames, sfunc->frame_num);
+    OX_DEL(ctxt, fp);
+    return ox_throw_no_mem_error(ctxt);
 }
 
 /**
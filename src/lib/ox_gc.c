@@ -33,7 +33,39 @@
 #include "ox_internal.h"
 
 /*GC object flags mask.*/
-#define OX_GC_FL_MASK (OX_GC_FL_MARKED|OX_GC_FL_SCANNED)
+#define OX_GC_FL_MASK (OX_GC_FL_MARKED|OX_GC_FL_SCANNED|OX_GC_FL_REMEMBERED)
+
+/*Default memory size start running garbage collecter.*/
+#define OX_GC_START_SIZE (64 * 1024)
+
+/*Default memory growth in percent of the last full collection to start the next one.*/
+#define OX_GC_GROWTH 133
+
+/*Memory size can be allocated before a minor collection.*/
+#define OX_GC_NURSERY_SIZE (4 * 1024 * 1024)
+
+/*Memory size can be allocated between 2 incremental marking slices.*/
+#define OX_GC_SLICE_SIZE (64 * 1024)
+
+/*Default number of objects scanned in an incremental marking slice.*/
+#define OX_GC_SLICE_WORK 2048
+
+/*Maximum number of the marking threads.*/
+#define OX_GC_THREAD_MAX 256
+
+/*Minimum capacity of the parallel marker's shared stack.*/
+#define OX_GC_MARKER_STACK_SIZE 4096
+
+/*Minimum number of objects swept in a sweeping slice.*/
+#define OX_GC_SWEEP_WORK 4096
+
+/*The old objects should be swept in this number of slices.*/
+#define OX_GC_SWEEP_SLICES 32
+
+/*A minor collection finished in the current pause.*/
+#define OX_GC_FINISHED_MINOR 1
+/*A full collection finished in the current pause.*/
+#define OX_GC_FINISHED_FULL  2
 
 /*Get the next object in the list.*/
 static inline OX_GcObject*
@@ -42,193 +74,1602 @@ gco_next (OX_GcObject *gco)
     return OX_SIZE2PTR(gco->next_flags & ~OX_GC_FL_MASK);
 }
 
-/*Scan the root objects.*/
+/*Get the monotonic time in nanoseconds.*/
+static uint64_t
+gc_time (void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/*The mutators are paused by the garbage collecter.
+ *The nested pauses are counted as one pause.*/
+static void
+gc_pause_begin (OX_Context *ctxt)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+
+    if (!vm->gc_pause_depth ++)
+        vm->gc_pause_start = gc_time();
+}
+
+/*The pause finished, update the pause time and invoke the callback.*/
+static void
+gc_pause_end (OX_Context *ctxt)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+    uint64_t t;
+
+    if (-- vm->gc_pause_depth)
+        return;
+
+    t = gc_time() - vm->gc_pause_start;
+
+    vm->gc_pause_total += t;
+    if (vm->gc_pause_max < t)
+        vm->gc_pause_max = t;
+
+    if (vm->gc_finished && vm->gc_cb) {
+        OX_GcStats stats;
+
+        ox_gc_get_stats(ctxt, &stats);
+
+        if (vm->gc_finished & OX_GC_FINISHED_MINOR)
+            vm->gc_cb(ctxt, OX_FALSE, &stats, vm->gc_cb_data);
+        if (vm->gc_finished & OX_GC_FINISHED_FULL)
+            vm->gc_cb(ctxt, OX_TRUE, &stats, vm->gc_cb_data);
+    }
+
+    vm->gc_finished = 0;
+}
+
+/*A collection finished.*/
+static void
+gc_finish (OX_Context *ctxt, OX_Bool full)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+
+    if (full) {
+        vm->gc_full_count ++;
+        vm->gc_finished |= OX_GC_FINISHED_FULL;
+    } else {
+        vm->gc_minor_count ++;
+        vm->gc_finished |= OX_GC_FINISHED_MINOR;
+    }
+}
+
+/*Check if all the references stored in the object are tracked by the write barrier.
+ *The other old objects are always in the remembered set.*/
+static OX_Bool
+gc_barriered (OX_GcObject *gco)
+{
+    switch (gco->ops->type) {
+    case OX_GCO_STRING:
+    case OX_GCO_SINGLETON_STRING:
+    case OX_GCO_CELL:
+        return OX_TRUE;
+    case OX_GCO_OBJECT:
+        /*Objects with their own operation functions may store references directly.*/
+        if (gco->ops->scan != ox_object_scan)
+            return OX_FALSE;
+        /*Fall through.*/
+    case OX_GCO_ARRAY:
+    case OX_GCO_FUNCTION:
+    case OX_GCO_NATIVE_FUNC:
+    case OX_GCO_CLASS:
+    case OX_GCO_DICT:
+        /*The references in the private data are not tracked.*/
+        return ((OX_Object*)gco)->priv ? OX_FALSE : OX_TRUE;
+    default:
+        return OX_FALSE;
+    }
+}
+
+/*Scan the root objects.*/
+static void
+gc_scan_root (OX_Context *ctxt)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+    OX_Context *c;
+    OX_GcObject *gco;
+    size_t i;
+    OX_GlobalRef *ref;
+
+    /*The object being added may be not referenced by any root yet.*/
+    if (vm->gco_adding)
+        ox_gc_mark(ctxt, vm->gco_adding);
+
+    /*Keep the objects added by the context reclaiming the memory.*/
+    for (gco = vm->gc_keep, i = 0; i < vm->gc_keep_num; i ++) {
+        OX_GcObject *next = OX_SIZE2PTR(gco->next_flags & ~OX_GC_FL_MASK);
+
+        ox_gc_mark(ctxt, gco);
+        gco = next;
+    }
+
+    /*Scan global reference hash table.*/
+    ox_hash_foreach_c(&vm->global_ref_hash, i, ref, OX_GlobalRef, he) {
+        ox_gc_mark(ctxt, ref->he.key);
+    }
+
+    ox_list_foreach_c(&vm->ctxt_list, c, OX_Context, ln) {
+        /*Scan the value stack.*/
+        ox_gc_scan_values(ctxt, c->bot_v_stack.items, c->bot_v_stack.len);
+
+        /*Scan the frame stack.*/
+        ox_gc_scan_frames(ctxt, c->frames);
+        ox_gc_scan_frames(ctxt, c->main_frames);
+
+        /*Scan the error frame stack.*/
+        for (i = 0; i < c->error_frames.len; i ++)
+            ox_gc_scan_value(ctxt, &ox_vector_item(&c->error_frames, i).func);
+
+        ox_gc_scan_value(ctxt, &c->error);
+
+        /*Scan the status stack.*/
+        ox_gc_scan_stack(ctxt, &c->bot_s_stack);
+    }
+
+    /*Scan strings.*/
+    ox_gc_scan_values(ctxt, vm->strings, OX_STR_ID_MAX);
+
+    /*Scan objects.*/
+    ox_gc_scan_values(ctxt, vm->objects, OX_OBJ_ID_MAX);
+
+    /*Scan the scripts.*/
+    ox_gc_scan_script_hash(ctxt);
+
+    /*Scan the packages.*/
+    ox_gc_scan_package(ctxt);
+}
+
+/*Scan the old objects in the remembered set.*/
+static void
+gc_scan_remembered (OX_Context *ctxt)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+    size_t i, n = 0;
+
+    for (i = 0; i < vm->gc_remembered.len; i ++) {
+        OX_GcObject *o = ox_vector_item(&vm->gc_remembered, i);
+
+        if (o->ops->scan)
+            o->ops->scan(ctxt, o);
+
+        /*All the young objects will be promoted, so the object can be removed from the set.*/
+        if (gc_barriered(o))
+            o->next_flags &= ~OX_GC_FL_REMEMBERED;
+        else
+            ox_vector_item(&vm->gc_remembered, n ++) = o;
+    }
+
+    vm->gc_remembered.len = n;
+}
+
+/*Scan the marked object.*/
+static void
+gc_scan_object (OX_Context *ctxt, OX_GcObject *o)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+
+    o->next_flags |= OX_GC_FL_SCANNED;
+
+    if (vm->gc_marking) {
+        /*The object without write barrier will be scanned again when the marking finished.*/
+        if (gc_barriered(o)) {
+            o->next_flags &= ~OX_GC_FL_REMEMBERED;
+        } else if (!(o->next_flags & OX_GC_FL_REMEMBERED)) {
+            o->next_flags |= OX_GC_FL_REMEMBERED;
+            ox_not_error(ox_vector_append(ctxt, &vm->gc_remembered, o));
+        }
+    }
+
+    if (o->ops->scan) {
+        o->ops->scan(ctxt, o);
+    }
+}
+
+/*Scan the marked objects in the list which are not scanned.*/
+static void
+gc_scan_list (OX_Context *ctxt, OX_GcObject *o)
+{
+    for (; o; o = gco_next(o)) {
+        if ((o->next_flags & (OX_GC_FL_MARKED|OX_GC_FL_SCANNED)) == OX_GC_FL_MARKED)
+            gc_scan_object(ctxt, o);
+    }
+}
+
+/*Scan the marked objects in the segments which are not scanned.*/
+static void
+gc_scan_segs (OX_Context *ctxt, OX_GcSegment *seg)
+{
+    size_t i;
+
+    for (; seg; seg = seg->next) {
+        for (i = 0; i < seg->len; i ++) {
+            OX_GcObject *o = seg->objs[i];
+
+            if ((o->next_flags & (OX_GC_FL_MARKED|OX_GC_FL_SCANNED)) == OX_GC_FL_MARKED)
+                gc_scan_object(ctxt, o);
+        }
+    }
+}
+
+/*Push an object to the marked stack.
+ *When the stack reaches its limit, the object is left unscanned,
+ *the overflow flag is set and the object will be found by rescanning the lists.*/
+static void
+gc_marked_push (OX_Context *ctxt, OX_GcObject *o)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+    OX_GcMarkStack *s = &vm->gc_marked_stack;
+
+    if (s->len == OX_GC_MARK_CHUNK_SIZE) {
+        OX_GcMarkChunk *c = s->spare;
+
+        if (c) {
+            s->spare = NULL;
+        } else {
+            if ((s->chunk_num + 1) * sizeof(OX_GcMarkChunk) <= s->max)
+                OX_NEW(ctxt, c);
+
+            if (!c) {
+                vm->gc_marked_full = OX_TRUE;
+                return;
+            }
+
+            s->chunk_num ++;
+        }
+
+        c->prev = s->top;
+        s->top = c;
+        s->len = 0;
+    }
+
+    s->top->objs[s->len ++] = o;
+    s->num ++;
+}
+
+/*Pop an object from the marked stack.
+ *Return NULL when the stack is empty.*/
+static OX_GcObject*
+gc_marked_pop (OX_Context *ctxt)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+    OX_GcMarkStack *s = &vm->gc_marked_stack;
+
+    if (!s->len) {
+        OX_GcMarkChunk *c = s->top;
+
+        if (!c->prev)
+            return NULL;
+
+        /*Keep one free chunk, so pushing and popping around the chunk boundary do not allocate.*/
+        if (s->spare) {
+            OX_DEL(ctxt, s->spare);
+            s->chunk_num --;
+        }
+
+        s->spare = c;
+        s->top = c->prev;
+        s->len = OX_GC_MARK_CHUNK_SIZE;
+    }
+
+    s->num --;
+    return s->top->objs[-- s->len];
+}
+
+/*Remove all the objects from the marked stack and free the unused chunks.*/
+static void
+gc_marked_clear (OX_Context *ctxt)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+    OX_GcMarkStack *s = &vm->gc_marked_stack;
+    OX_GcMarkChunk *c;
+
+    while ((c = s->top)->prev) {
+        s->top = c->prev;
+        OX_DEL(ctxt, c);
+        s->chunk_num --;
+    }
+
+    s->len = 0;
+    s->num = 0;
+}
+
+/*Scan the objects.
+ *At most "work" objects are scanned.
+ *Return OX_TRUE when all the marked objects are scanned.*/
+static OX_Bool
+gc_scan_objects (OX_Context *ctxt, OX_Bool full, size_t work)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+    OX_Context *c;
+
+    while (1) {
+        OX_GcObject *o;
+
+        while (vm->gc_marked_stack.num) {
+            if (!work)
+                return OX_FALSE;
+
+            o = gc_marked_pop(ctxt);
+
+            gc_scan_object(ctxt, o);
+            work --;
+        }
+
+        if (!vm->gc_marked_full)
+            break;
+
+        /*The stack overflowed, rescan the lists to find the marked objects not scanned.
+         *The objects not published are in the contexts' pending lists.
+         *Old objects are only marked in the full collection.*/
+        vm->gc_marked_full = OX_FALSE;
+
+        gc_scan_list(ctxt, vm->gco_young);
+
+        ox_list_foreach_c(&vm->ctxt_list, c, OX_Context, ln) {
+            gc_scan_list(ctxt, c->gco_pending);
+        }
+
+        if (full)
+            gc_scan_segs(ctxt, vm->gc_segs);
+    }
+
+    return OX_TRUE;
+}
+
+/*Move the oldest half objects in the local buffer to the shared stack,
+ *so the idle markers can steal them.*/
+static void
+gc_marker_share (OX_VM *vm, OX_GcMarker *m)
+{
+    size_t n = m->buf_len / 2;
+    size_t left;
+
+    ox_mutex_lock(&m->lock);
+
+    left = ox_vector_space(&m->stack);
+    if (left < n) {
+        /*The dropped objects keep the marked flag and will be found by rescanning the lists.*/
+        __atomic_store_n(&vm->gc_marked_full, OX_TRUE, __ATOMIC_RELAXED);
+        memcpy(m->stack.items + m->stack.len, m->buf, left * sizeof(OX_GcObject*));
+        m->stack.len += left;
+    } else {
+        memcpy(m->stack.items + m->stack.len, m->buf, n * sizeof(OX_GcObject*));
+        m->stack.len += n;
+    }
+
+    ox_mutex_unlock(&m->lock);
+
+    memmove(m->buf, m->buf + n, (m->buf_len - n) * sizeof(OX_GcObject*));
+    m->buf_len -= n;
+
+    /*Wake up an idle marker.*/
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&vm->gc_idle_num, __ATOMIC_SEQ_CST)) {
+        ox_mutex_lock(&vm->gc_lock);
+        ox_cond_var_signal(&vm->gc_idle_cv);
+        ox_mutex_unlock(&vm->gc_lock);
+    }
+}
+
+/*Take objects from the shared stack of the marker "from" to the local buffer.
+ *The marker takes at most half of the buffer from its own stack,
+ *and steals half of the stack from the other markers.*/
+static OX_Bool
+gc_marker_take (OX_GcMarker *m, OX_GcMarker *from)
+{
+    size_t n;
+
+    if (!__atomic_load_n(&from->stack.len, __ATOMIC_RELAXED))
+        return OX_FALSE;
+
+    ox_mutex_lock(&from->lock);
+
+    n = from->stack.len;
+    if (from != m)
+        n = (n + 1) / 2;
+    if (n > OX_GC_MARKER_BUF_SIZE / 2)
+        n = OX_GC_MARKER_BUF_SIZE / 2;
+
+    from->stack.len -= n;
+    memcpy(m->buf, from->stack.items + from->stack.len, n * sizeof(OX_GcObject*));
+
+    ox_mutex_unlock(&from->lock);
+
+    m->buf_len = n;
+
+    return n ? OX_TRUE : OX_FALSE;
+}
+
+/*Get an object to be scanned by the marker.*/
+static OX_GcObject*
+gc_marker_pop (OX_VM *vm, OX_GcMarker *m)
+{
+    int id, i;
+
+    if (m->buf_len)
+        return m->buf[-- m->buf_len];
+
+    if (gc_marker_take(m, m))
+        return m->buf[-- m->buf_len];
+
+    id = m - vm->gc_markers;
+
+    for (i = 1; i < vm->gc_thread_num; i ++) {
+        OX_GcMarker *victim = &vm->gc_markers[(id + i) % vm->gc_thread_num];
+
+        if (gc_marker_take(m, victim))
+            return m->buf[-- m->buf_len];
+    }
+
+    return NULL;
+}
+
+/*Check if any marker has objects can be stolen.*/
+static OX_Bool
+gc_markers_busy (OX_VM *vm)
+{
+    int i;
+
+    for (i = 0; i < vm->gc_thread_num; i ++) {
+        if (__atomic_load_n(&vm->gc_markers[i].stack.len, __ATOMIC_SEQ_CST))
+            return OX_TRUE;
+    }
+
+    return OX_FALSE;
+}
+
+/*Scan the objects with the parallel marker until all the markers are idle.*/
+static void
+gc_marker_run (OX_Context *ctxt)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+    OX_GcMarker *m = ctxt->gc_marker;
+    OX_GcObject *o;
+
+    while (1) {
+        while ((o = gc_marker_pop(vm, m))) {
+            __atomic_fetch_or(&o->next_flags, OX_GC_FL_SCANNED, __ATOMIC_RELAXED);
+
+            if (o->ops->scan)
+                o->ops->scan(ctxt, o);
+
+            /*Share the objects when some markers are idle.*/
+            if ((m->buf_len > 1) && __atomic_load_n(&vm->gc_idle_num, __ATOMIC_RELAXED))
+                gc_marker_share(vm, m);
+        }
+
+        /*Wait until all the markers are idle or some objects can be stolen.*/
+        ox_mutex_lock(&vm->gc_lock);
+
+        __atomic_add_fetch(&vm->gc_idle_num, 1, __ATOMIC_SEQ_CST);
+
+        while (1) {
+            if (vm->gc_idle_num == vm->gc_thread_num) {
+                int i;
+
+                for (i = 1; i < vm->gc_thread_num; i ++)
+                    ox_cond_var_signal(&vm->gc_idle_cv);
+
+                ox_mutex_unlock(&vm->gc_lock);
+                return;
+            }
+
+            if (gc_markers_busy(vm)) {
+                __atomic_sub_fetch(&vm->gc_idle_num, 1, __ATOMIC_SEQ_CST);
+                break;
+            }
+
+            ox_cond_var_wait(&vm->gc_idle_cv, &vm->gc_lock, -1);
+        }
+
+        ox_mutex_unlock(&vm->gc_lock);
+    }
+}
+
+/*Marking thread's entry.*/
+static void*
+gc_marker_entry (void *arg)
+{
+    OX_GcMarker *m = arg;
+    OX_Context *ctxt = &m->ctxt;
+    OX_VM *vm = ox_vm_get(ctxt);
+
+    ox_mutex_lock(&vm->gc_lock);
+
+    while (1) {
+        while (!vm->gc_quit && (vm->gc_mark_seq == m->seq))
+            ox_cond_var_wait(&vm->gc_start_cv, &vm->gc_lock, -1);
+
+        if (vm->gc_quit)
+            break;
+
+        m->seq = vm->gc_mark_seq;
+
+        ox_mutex_unlock(&vm->gc_lock);
+        gc_marker_run(ctxt);
+        ox_mutex_lock(&vm->gc_lock);
+
+        vm->gc_running_num --;
+        if (!vm->gc_running_num)
+            ox_cond_var_signal(&vm->gc_end_cv);
+    }
+
+    ox_mutex_unlock(&vm->gc_lock);
+
+    return NULL;
+}
+
+/*Add the marked objects which are not scanned in the list to the marked stack.*/
+static void
+gc_collect_list (OX_Context *ctxt, OX_GcObject *o)
+{
+    for (; o; o = gco_next(o)) {
+        if ((o->next_flags & (OX_GC_FL_MARKED|OX_GC_FL_SCANNED)) == OX_GC_FL_MARKED)
+            gc_marked_push(ctxt, o);
+    }
+}
+
+/*Add the marked objects which are not scanned in the segments to the marked stack.*/
+static void
+gc_collect_segs (OX_Context *ctxt, OX_GcSegment *seg)
+{
+    size_t i;
+
+    for (; seg; seg = seg->next) {
+        for (i = 0; i < seg->len; i ++) {
+            OX_GcObject *o = seg->objs[i];
+
+            if ((o->next_flags & (OX_GC_FL_MARKED|OX_GC_FL_SCANNED)) == OX_GC_FL_MARKED)
+                gc_marked_push(ctxt, o);
+        }
+    }
+}
+
+/*Scan the marked objects with all the marking threads.*/
+static void
+gc_scan_parallel (OX_Context *ctxt, OX_Bool full)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+    size_t cap = ox_vector_capacity(&vm->gc_markers[0].stack);
+    OX_GcObject *o;
+    OX_Bool collect_more = OX_FALSE;
+    size_t i;
+
+    if (cap < OX_GC_MARKER_STACK_SIZE)
+        cap = OX_GC_MARKER_STACK_SIZE;
+
+    while (1) {
+        /*The stacks overflowed, collect the objects not scanned in the lists.*/
+        if (vm->gc_marked_full || collect_more) {
+            vm->gc_marked_full = OX_FALSE;
+            gc_marked_clear(ctxt);
+
+            gc_collect_list(ctxt, vm->gco_young);
+
+            if (full)
+                gc_collect_segs(ctxt, vm->gc_segs);
+
+            /*The marked stack overflowed again, collect the left objects in the next round.*/
+            collect_more = vm->gc_marked_full;
+            vm->gc_marked_full = OX_FALSE;
+        }
+
+        if (cap < vm->gc_marked_stack.num)
+            cap = vm->gc_marked_stack.num;
+
+        /*Distribute the marked objects to the markers.*/
+        for (i = 0; i < vm->gc_thread_num; i ++) {
+            OX_GcMarker *m = &vm->gc_markers[i];
+
+            ox_not_error(ox_vector_set_capacity(ctxt, &m->stack, cap));
+
+            m->buf_len = 0;
+            m->ctxt.base.v_stack = ctxt->base.v_stack;
+        }
+
+        i = 0;
+        while ((o = gc_marked_pop(ctxt))) {
+            OX_GcMarker *m = &vm->gc_markers[i ++ % vm->gc_thread_num];
+
+            ox_vector_item(&m->stack, m->stack.len ++) = o;
+        }
+
+        /*Wake up the marking threads.*/
+        ox_mutex_lock(&vm->gc_lock);
+
+        vm->gc_parallel = OX_TRUE;
+        vm->gc_idle_num = 0;
+        vm->gc_running_num = vm->gc_thread_num - 1;
+        vm->gc_mark_seq ++;
+
+        for (i = 1; i < vm->gc_thread_num; i ++)
+            ox_cond_var_signal(&vm->gc_start_cv);
+
+        ox_mutex_unlock(&vm->gc_lock);
+
+        /*The current thread works as the first marker.*/
+        ctxt->gc_marker = &vm->gc_markers[0];
+        gc_marker_run(ctxt);
+        ctxt->gc_marker = NULL;
+
+        ox_mutex_lock(&vm->gc_lock);
+
+        while (vm->gc_running_num)
+            ox_cond_var_wait(&vm->gc_end_cv, &vm->gc_lock, -1);
+
+        vm->gc_parallel = OX_FALSE;
+
+        ox_mutex_unlock(&vm->gc_lock);
+
+        if (!vm->gc_marked_full) {
+            if (!collect_more)
+                break;
+        } else {
+            /*The markers' stacks overflowed, enlarge them.*/
+            cap *= 2;
+
+            OX_LOG_D(ctxt, "expand GC marker's stack to %"PRIdPTR"B", cap);
+        }
+    }
+}
+
+/*Scan all the marked objects.*/
+static void
+gc_scan_all (OX_Context *ctxt, OX_Bool full)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+
+    if (vm->gc_thread_num > 1)
+        gc_scan_parallel(ctxt, full);
+    else
+        gc_scan_objects(ctxt, full, SIZE_MAX);
+}
+
+/*Move the pending objects of the context to the young objects' list,
+ *and fold the memory size counted by the context.*/
+static void
+gc_publish (OX_Context *ctxt, OX_Context *c)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+
+    ox_mem_flush(ctxt, c);
+
+    if (!c->gco_pending)
+        return;
+
+    c->gco_pending_last->next_flags |= OX_PTR2SIZE(vm->gco_young);
+    vm->gco_young = c->gco_pending;
+
+    c->gco_pending = NULL;
+    c->gco_pending_last = NULL;
+    c->gco_pending_num = 0;
+}
+
+/*Publish the pending objects of all the contexts.*/
+static void
+gc_publish_all (OX_Context *ctxt)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+    OX_Context *c;
+
+    gc_publish(ctxt, ctxt);
+
+    ox_list_foreach_c(&vm->ctxt_list, c, OX_Context, ln) {
+        gc_publish(ctxt, c);
+    }
+}
+
+/*Get the allocated memory size.
+ *The objects may be freed by the current context in the collection,
+ *so its counted size is folded first.*/
+static size_t
+gc_mem_size (OX_Context *ctxt)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+
+    ox_mem_flush(ctxt, ctxt);
+
+    return vm->mem_allocted;
+}
+
+/*Reset the flags of the surviving object.
+ *The old object without write barrier is always in the remembered set.*/
+static void
+gc_survive (OX_Context *ctxt, OX_GcObject *o)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+    size_t flags = OX_GC_FL_MARKED|OX_GC_FL_SCANNED|(o->next_flags & OX_GC_FL_REMEMBERED);
+
+    if (!(flags & OX_GC_FL_REMEMBERED) && !gc_barriered(o)) {
+        flags |= OX_GC_FL_REMEMBERED;
+        ox_not_error(ox_vector_append(ctxt, &vm->gc_remembered, o));
+    }
+
+    o->next_flags = flags;
+}
+
+/*Sweep the unused young objects.
+ *The survivors become old objects.
+ *The objects are kept from new to old in the segments,
+ *so an object is always freed before the objects it is created after.*/
+static void
+gc_sweep_young (OX_Context *ctxt)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+    OX_GcObject *o, *no;
+    OX_GcSegment *head = NULL, *tail = NULL, *seg;
+
+    for (o = vm->gco_young; o; o = no) {
+        no = gco_next(o);
+
+        if (o->next_flags & OX_GC_FL_MARKED) {
+            gc_survive(ctxt, o);
+
+            if (!tail || (tail->len == OX_GC_SEGMENT_SIZE)) {
+                ox_not_null(OX_NEW(ctxt, seg));
+
+                seg->len = 0;
+                seg->next = NULL;
+
+                if (tail)
+                    tail->next = seg;
+                else
+                    head = seg;
+
+                tail = seg;
+            }
+
+            tail->objs[tail->len ++] = o;
+        } else {
+            if (o->ops->free)
+                o->ops->free(ctxt, o);
+        }
+    }
+
+    vm->gco_young = NULL;
+
+    /*The survivors are newer than the old objects.*/
+    if (tail) {
+        tail->next = vm->gc_segs;
+        vm->gc_segs = head;
+    }
+}
+
+/*Sweep at most "work" old objects in the sweeping segments.
+ *The survivors are moved to the front of the segments.
+ *Return OX_TRUE when all the segments are swept.*/
+static OX_Bool
+gc_sweep_segs (OX_Context *ctxt, size_t work)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+    OX_GcSegment *rseg = vm->gc_sweep_rseg, *wseg = vm->gc_sweep_wseg, *seg, *nseg;
+    size_t ridx = vm->gc_sweep_ridx, widx = vm->gc_sweep_widx;
+    OX_Bool freed = OX_FALSE;
+    OX_GcObject *o;
+
+    while (rseg) {
+
+        if (ridx == rseg->len) {
+            rseg = rseg->next;
+            ridx = 0;
+            continue;
+        }
+
+        if (!work)
+            break;
+
+        o = rseg->objs[ridx ++];
+        work --;
+
+        /*The objects' addresses are known, load them before checking.*/
+        if (ridx + 8 < rseg->len)
+            __builtin_prefetch(rseg->objs[ridx + 8]);
+
+        if (o->next_flags & OX_GC_FL_MARKED) {
+            gc_survive(ctxt, o);
+
+            /*The write position is always before the read position.*/
+            if (widx == OX_GC_SEGMENT_SIZE) {
+                wseg->len = OX_GC_SEGMENT_SIZE;
+                wseg = wseg->next;
+                widx = 0;
+            }
+
+            wseg->objs[widx ++] = o;
+        } else {
+            if (o->ops->free)
+                o->ops->free(ctxt, o);
+
+            freed = OX_TRUE;
+        }
+    }
+
+    /*Objects may be freed, invalidate the property caches.*/
+    if (freed)
+        ox_prop_cache_reset(ctxt);
+
+    vm->gc_sweep_rseg = rseg;
+    vm->gc_sweep_ridx = ridx;
+    vm->gc_sweep_wseg = wseg;
+    vm->gc_sweep_widx = widx;
+
+    if (rseg)
+        return OX_FALSE;
+
+    /*Free the empty segments.*/
+    wseg->len = widx;
+
+    for (seg = wseg->next; seg; seg = nseg) {
+        nseg = seg->next;
+        OX_DEL(ctxt, seg);
+    }
+
+    wseg->next = NULL;
+
+    /*The swept objects are older than the objects added while sweeping.*/
+    if (vm->gc_segs) {
+        for (seg = vm->gc_segs; seg->next; seg = seg->next);
+
+        seg->next = vm->gc_sweep_segs;
+    } else {
+        vm->gc_segs = vm->gc_sweep_segs;
+    }
+
+    vm->gc_sweep_segs = NULL;
+
+    /*Clear the flags of the objects allocated while sweeping.*/
+    gc_publish_all(ctxt);
+
+    for (o = vm->gco_young; o; o = gco_next(o))
+        o->next_flags &= ~OX_GC_FL_MASK;
+
+    vm->gc_last_size = gc_mem_size(ctxt);
+    vm->gc_full_size = vm->gc_last_size;
+
+    gc_finish(ctxt, OX_TRUE);
+
+    OX_LOG_D(ctxt, "sweep end, allocated: %"PRIdPTR"B", vm->gc_last_size);
+
+    return OX_TRUE;
+}
+
+/*Run a slice of the lazy sweeping.*/
+static void
+gc_sweep_slice (OX_Context *ctxt)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+
+    gc_pause_begin(ctxt);
+
+    if (!gc_sweep_segs(ctxt, vm->gc_sweep_work))
+        vm->gc_slice_start = gc_mem_size(ctxt);
+
+    gc_pause_end(ctxt);
+}
+
+/*Sweep the unused objects after marking.
+ *The young objects are swept at once.
+ *The old objects are swept lazily in the following allocations after the full marking.*/
+static void
+gc_sweep_all (OX_Context *ctxt, OX_Bool full)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+    OX_GcSegment *seg;
+    size_t n = 0;
+#if OX_LOG_LEVEL <= OX_LOG_LEVEL_DEBUG
+    size_t size = gc_mem_size(ctxt);
+#endif
+
+    /*Detach the old objects before the young survivors are added.*/
+    if (full && vm->gc_segs) {
+        vm->gc_sweep_segs = vm->gc_segs;
+        vm->gc_sweep_rseg = vm->gc_segs;
+        vm->gc_sweep_ridx = 0;
+        vm->gc_sweep_wseg = vm->gc_segs;
+        vm->gc_sweep_widx = 0;
+        vm->gc_segs = NULL;
+
+        for (seg = vm->gc_sweep_segs; seg; seg = seg->next)
+            n += seg->len;
+
+        vm->gc_sweep_work = OX_MAX(n / OX_GC_SWEEP_SLICES, OX_GC_SWEEP_WORK);
+    }
+
+    gc_sweep_young(ctxt);
+
+    /*Objects may be freed, invalidate the property caches.*/
+    ox_prop_cache_reset(ctxt);
+
+    vm->gc_last_size = gc_mem_size(ctxt);
+    vm->gc_slice_start = vm->gc_last_size;
+
+    if (full && !vm->gc_sweep_segs)
+        vm->gc_full_size = vm->gc_last_size;
+
+    /*The full collection finishes when the old objects are swept.*/
+    if (!full || !vm->gc_sweep_segs)
+        gc_finish(ctxt, full);
+
+    OX_LOG_D(ctxt, "gc end, collect %"PRIdPTR"B", size - vm->gc_last_size);
+}
+
+/*Finish the lazy sweeping.*/
+static void
+gc_sweep_finish (OX_Context *ctxt)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+
+    if (vm->gc_sweep_segs)
+        gc_sweep_segs(ctxt, SIZE_MAX);
+}
+
+/*Clear the marked flags of the old objects.*/
+static void
+gc_clear_old (OX_Context *ctxt)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+    OX_GcSegment *seg;
+    size_t i;
+
+    for (seg = vm->gc_segs; seg; seg = seg->next) {
+        for (i = 0; i < seg->len; i ++)
+            seg->objs[i]->next_flags &= ~OX_GC_FL_MASK;
+    }
+
+    vm->gc_remembered.len = 0;
+}
+
+/*Run the garbage collecter.
+ *The minor collection only marks and sweeps the young objects.
+ *The old objects keep the marked flag, and the old objects referencing
+ *young objects are found in the remembered set.*/
+static void
+gc_run (OX_Context *ctxt, OX_Bool full)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+
+    OX_LOG_D(ctxt, "%s gc start, allocated: %"PRIdPTR"B", full ? "full" : "minor", gc_mem_size(ctxt));
+
+    gc_pause_begin(ctxt);
+    gc_publish_all(ctxt);
+
+    vm->gc_marked_full = OX_FALSE;
+
+    if (full)
+        gc_clear_old(ctxt);
+
+    gc_scan_root(ctxt);
+
+    if (!full)
+        gc_scan_remembered(ctxt);
+
+    gc_scan_all(ctxt, full);
+
+    gc_sweep_all(ctxt, full);
+    gc_pause_end(ctxt);
+}
+
+/*Start the incremental marking of the full collection.*/
+static void
+gc_mark_start (OX_Context *ctxt)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+
+    OX_LOG_D(ctxt, "incremental gc start, allocated: %"PRIdPTR"B", gc_mem_size(ctxt));
+
+    gc_pause_begin(ctxt);
+    gc_publish_all(ctxt);
+
+    vm->gc_marked_full = OX_FALSE;
+
+    gc_clear_old(ctxt);
+    gc_scan_root(ctxt);
+
+    vm->gc_marking = OX_TRUE;
+    vm->gc_slice_start = gc_mem_size(ctxt);
+    gc_pause_end(ctxt);
+}
+
+/*Finish the incremental marking and sweep the unused objects.*/
+static void
+gc_mark_finish (OX_Context *ctxt)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+    size_t i;
+
+    /*The roots and the objects in the remembered set may be modified after scanned.
+     *Scan them again.
+     *The mutators are stopped now, so the objects scanned after here
+     *need not be recorded.
+     *The objects in the remembered set keep the remembered flag and stay in the set.*/
+    vm->gc_marking = OX_FALSE;
+
+    gc_publish_all(ctxt);
+
+    gc_scan_root(ctxt);
+
+    for (i = 0; i < vm->gc_remembered.len; i ++) {
+        OX_GcObject *o = ox_vector_item(&vm->gc_remembered, i);
+
+        if (o->ops->scan)
+            o->ops->scan(ctxt, o);
+    }
+
+    gc_scan_all(ctxt, OX_TRUE);
+
+    gc_sweep_all(ctxt, OX_TRUE);
+}
+
+/*Run a slice of the incremental marking.*/
 static void
-gc_scan_root (OX_Context *ctxt)
+gc_mark_slice (OX_Context *ctxt)
 {
     OX_VM *vm = ox_vm_get(ctxt);
-    OX_Context *c;
-    size_t i;
-    OX_GlobalRef *ref;
 
-    /*Scan global reference hash table.*/
-    ox_hash_foreach_c(&vm->global_ref_hash, i, ref, OX_GlobalRef, he) {
-        ox_gc_mark(ctxt, ref->he.key);
+    gc_pause_begin(ctxt);
+
+    if (gc_scan_objects(ctxt, OX_TRUE, vm->gc_slice_work))
+        gc_mark_finish(ctxt);
+    else
+        vm->gc_slice_start = gc_mem_size(ctxt);
+
+    gc_pause_end(ctxt);
+}
+
+/*Get the memory size to start the next full collection.
+ *With the maximum heap size, the full collection starts at latest
+ *in the middle of the last full collection's size and the maximum size.*/
+static size_t
+gc_full_limit (OX_VM *vm)
+{
+    size_t limit = vm->gc_full_size / 100 * vm->gc_growth
+            + vm->gc_full_size % 100 * vm->gc_growth / 100;
+
+    if (vm->gc_max_size && (vm->gc_full_size < vm->gc_max_size)) {
+        size_t half = vm->gc_full_size + (vm->gc_max_size - vm->gc_full_size) / 2;
+
+        if (limit > half)
+            limit = half;
     }
 
-    ox_list_foreach_c(&vm->ctxt_list, c, OX_Context, ln) {
-        /*Scan the value stack.*/
-        ox_gc_scan_values(ctxt, c->bot_v_stack.items, c->bot_v_stack.len);
+    return limit;
+}
 
-        /*Scan the frame stack.*/
-        if (c->frames)
-            ox_gc_mark(ctxt, c->frames);
+/**
+ * Add the GC managed object to the garbage collecter.
+ * @param ctxt The current running context.
+ * @param ptr The GC managed object's pointer.
+ */
+void
+ox_gc_add (OX_Context *ctxt, void *ptr)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+    OX_GcObject *gco = ptr;
 
-        if (c->error_frames)
-            ox_gc_mark(ctxt, c->error_frames);
+    /*The pending objects are published and the collecter is checked in batches.
+     *The new object is added to the pending list after the check,
+     *so the last added object is always in the pending list and
+     *can be kept by ox_gc_reclaim before it is referenced by any root.*/
+    if (ctxt->gco_pending_num >= OX_GC_PENDING_MAX) {
+        gc_publish(ctxt, ctxt);
 
-        if (c->main_frames)
-            ox_gc_mark(ctxt, c->main_frames);
+        vm->gco_adding = gco;
+        vm->gc_busy ++;
 
-        ox_gc_scan_value(ctxt, &c->error);
+        if (vm->gc_max_size
+                && (vm->gc_marking || vm->gc_sweep_segs)
+                && (vm->mem_allocted >= vm->gc_max_size / 8 * 7)) {
+            /*Near the maximum heap size, free the unused objects at once
+             *instead of failing the allocations while they are not swept.*/
+            gc_pause_begin(ctxt);
+            if (vm->gc_marking)
+                gc_mark_finish(ctxt);
+            gc_sweep_finish(ctxt);
+            gc_pause_end(ctxt);
+        } else if (vm->gc_marking) {
+            /*Mark a slice of objects each time OX_GC_SLICE_SIZE bytes allocated.*/
+            if (vm->mem_allocted > vm->gc_slice_start + OX_GC_SLICE_SIZE)
+                gc_mark_slice(ctxt);
+        } else if (vm->gc_sweep_segs) {
+            /*Sweep a slice of old objects each time OX_GC_SLICE_SIZE bytes allocated.*/
+            if (vm->mem_allocted > vm->gc_slice_start + OX_GC_SLICE_SIZE)
+                gc_sweep_slice(ctxt);
+        } else if ((vm->mem_allocted >= vm->gc_start_size)
+                || (vm->gc_max_size && (vm->mem_allocted >= vm->gc_max_size / 2))) {
+            if (vm->mem_allocted > gc_full_limit(vm))
+                gc_mark_start(ctxt);
+            else if (vm->mem_allocted > vm->gc_last_size + OX_GC_NURSERY_SIZE)
+                gc_run(ctxt, OX_FALSE);
+        }
 
-        /*Scan the status stack.*/
-        ox_gc_scan_stack(ctxt, &c->bot_s_stack);
+        vm->gc_busy --;
+        vm->gco_adding = NULL;
     }
 
-    /*Scan strings.*/
-    ox_gc_scan_values(ctxt, vm->strings, OX_STR_ID_MAX);
+    /*Add the object to the context's pending list.*/
+    if (!ctxt->gco_pending)
+        ctxt->gco_pending_last = gco;
 
-    /*Scan objects.*/
-    ox_gc_scan_values(ctxt, vm->objects, OX_OBJ_ID_MAX);
+    gco->next_flags = OX_PTR2SIZE(ctxt->gco_pending);
+    ctxt->gco_pending = gco;
+    ctxt->gco_pending_num ++;
 
-    /*Scan the scripts.*/
-    ox_gc_scan_script_hash(ctxt);
+    /*The unused old objects are not marked while sweeping,
+     *so the new objects are marked to be distinguished from them.*/
+    if (vm->gc_sweep_segs)
+        gco->next_flags |= OX_GC_FL_MASK;
+}
 
-    /*Scan the packages.*/
-    ox_gc_scan_package(ctxt);
+/**
+ * Publish the pending objects added by the context to the garbage collecter.
+ * @param ctxt The current running context.
+ */
+void
+ox_gc_publish (OX_Context *ctxt)
+{
+    gc_publish(ctxt, ctxt);
 }
 
-/*Scan the objects.*/
-static void
-gc_scan_objects (OX_Context *ctxt)
+/**
+ * Run the garbage collecter.
+ * All the objects are marked and swept.
+ * @param ctxt The current running context.
+ */
+void
+ox_gc_run (OX_Context *ctxt)
 {
     OX_VM *vm = ox_vm_get(ctxt);
 
-    while (1) {
-        OX_GcObject *o;
+    vm->gc_busy ++;
+    gc_pause_begin(ctxt);
 
-        while (ox_vector_length(&vm->gc_marked_stack)) {
-            vm->gc_marked_stack.len --;
-            o = ox_vector_item(&vm->gc_marked_stack, vm->gc_marked_stack.len);
+    if (vm->gc_marking) {
+        gc_mark_finish(ctxt);
+    } else {
+        gc_sweep_finish(ctxt);
+        gc_run(ctxt, OX_TRUE);
+    }
 
-            o->next_flags |= OX_GC_FL_SCANNED;
+    gc_sweep_finish(ctxt);
 
-            if (o->ops->scan) {
-                o->ops->scan(ctxt, o);
-            }
-        }
+    gc_pause_end(ctxt);
+    vm->gc_busy --;
+}
 
-        if (!vm->gc_marked_full)
-            break;
+/**
+ * Free the unused objects at once as an allocation exceeds the maximum heap size.
+ * The pending marking and sweeping are finished synchronously.
+ * The objects added by the context and not published are kept,
+ * as the last one may be not referenced by any root yet.
+ * @param ctxt The current running context.
+ */
+void
+ox_gc_reclaim (OX_Context *ctxt)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
 
-        vm->gc_marked_full = OX_FALSE;
-        vm->gc_scan_cnt ++;
+    OX_LOG_D(ctxt, "reclaim the unused objects, allocated: %"PRIdPTR"B", gc_mem_size(ctxt));
 
-        if (vm->gc_scan_cnt > 5) {
-            size_t cap = ox_vector_capacity(&vm->gc_marked_stack);
+    vm->gc_keep = ctxt->gco_pending;
+    vm->gc_keep_num = ctxt->gco_pending_num;
 
-            OX_LOG_D(ctxt, "expand GC marked stack to %"PRIdPTR"B", cap * 2);
-            ox_not_error(ox_vector_set_capacity(ctxt, &vm->gc_marked_stack, cap * 2));
+    ox_gc_run(ctxt);
 
-            vm->gc_scan_cnt = 0;
-        }
+    vm->gc_keep = NULL;
+    vm->gc_keep_num = 0;
+}
+
+/**
+ * Check if the GC managed object is unused and waiting to be freed.
+ * After a full collection, the unused objects are freed lazily.
+ * An object found in a table not scanned by the garbage collecter
+ * must be checked before it is used again.
+ * @param ctxt The current running context.
+ * @param gco The GC managed object.
+ * @retval OX_TRUE The object is unused.
+ * @retval OX_FALSE The object is still alive.
+ */
+OX_Bool
+ox_gc_is_dead (OX_Context *ctxt, OX_GcObject *gco)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
 
-        for (o = vm->gco_list; o; o = gco_next(o)) {
-            if ((o->next_flags & OX_GC_FL_MASK) == OX_GC_FL_MARKED) {
-                o->next_flags |= OX_GC_FL_SCANNED;
+    return vm->gc_sweep_segs && !(gco->next_flags & OX_GC_FL_MARKED);
+}
 
-                if (o->ops->scan) {
-                    o->ops->scan(ctxt, o);
-                }
-            }
-        }
+/**
+ * Add the old GC managed object to the remembered set.
+ * When the incremental marking is running, the scanned object
+ * is added to the remembered set and will be scanned again
+ * when the marking finished.
+ * @param ctxt The current running context.
+ * @param gco The GC managed object.
+ */
+void
+ox_gc_remember (OX_Context *ctxt, OX_GcObject *gco)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+
+    /*The object not scanned yet will get the new references when it is scanned.*/
+    if (vm->gc_marking && !(gco->next_flags & OX_GC_FL_SCANNED))
+        return;
+
+    gco->next_flags |= OX_GC_FL_REMEMBERED;
+
+    vm->gc_busy ++;
+    ox_not_error(ox_vector_append(ctxt, &vm->gc_remembered, gco));
+    vm->gc_busy --;
+}
+
+/**
+ * Mark the GC managed object as used.
+ * This function must be invoked in garbage collection process.
+ * @param ctxt The current running context.
+ * @param gco The GC managed object.
+ */
+void
+ox_gc_mark_inner (OX_Context *ctxt, OX_GcObject *gco)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+
+    if (vm->gc_parallel) {
+        OX_GcMarker *m = ctxt->gc_marker;
+
+        /*The object may be marked by another marker at the same time.*/
+        if (__atomic_fetch_or(&gco->next_flags, OX_GC_FL_MARKED, __ATOMIC_RELAXED) & OX_GC_FL_MARKED)
+            return;
+
+        if (m->buf_len == OX_GC_MARKER_BUF_SIZE)
+            gc_marker_share(vm, m);
+
+        m->buf[m->buf_len ++] = gco;
+        return;
     }
+
+    gco->next_flags |= OX_GC_FL_MARKED;
+
+    gc_marked_push(ctxt, gco);
 }
 
-/*Sweep th unused objects.*/
+/*Stop the marking threads and free the markers.
+ *"n" is the number of the markers, the first marker has no thread.*/
 static void
-gc_sweep (OX_Context *ctxt)
+gc_markers_free (OX_Context *ctxt, int n)
 {
     OX_VM *vm = ox_vm_get(ctxt);
-    OX_GcObject **po = &vm->gco_list;
-    OX_GcObject *o;
+    int i;
 
-    while ((o = *po)) {
-        if (o->next_flags & OX_GC_FL_MARKED) {
-            o->next_flags = OX_PTR2SIZE(gco_next(o));
+    ox_mutex_lock(&vm->gc_lock);
 
-            po = (OX_GcObject**)&o->next_flags;
-        } else {
-            *po = gco_next(o);
+    vm->gc_quit = OX_TRUE;
 
-            if (o->ops->free)
-                o->ops->free(ctxt, o);
+    for (i = 1; i < n; i ++)
+        ox_cond_var_signal(&vm->gc_start_cv);
+
+    ox_mutex_unlock(&vm->gc_lock);
+
+    for (i = 1; i < n; i ++)
+        ox_thread_join(ctxt, &vm->gc_markers[i].thread);
+
+    for (i = 0; i < vm->gc_marker_num; i ++) {
+        OX_GcMarker *m = &vm->gc_markers[i];
+
+        ox_vector_deinit(ctxt, &m->stack);
+        ox_mutex_deinit(&m->lock);
+    }
+
+    OX_DEL_N(ctxt, vm->gc_markers, vm->gc_marker_num);
+
+    vm->gc_markers = NULL;
+    vm->gc_marker_num = 0;
+    vm->gc_thread_num = 1;
+    vm->gc_quit = OX_FALSE;
+}
+
+/**
+ * Set the number of the threads used in the marking process.
+ * The current thread works as the first marker,
+ * so "n - 1" helper threads are created.
+ * @param ctxt The current running context.
+ * @param n Number of the marking threads.
+ * @retval OX_OK On success.
+ * @retval OX_ERR On error.
+ */
+OX_Result
+ox_gc_set_thread_num (OX_Context *ctxt, int n)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+    int i;
+    OX_Result r;
+
+    if (n < 1)
+        n = 1;
+    else if (n > OX_GC_THREAD_MAX)
+        n = OX_GC_THREAD_MAX;
+
+    if (n == vm->gc_thread_num)
+        return OX_OK;
+
+    if (vm->gc_markers)
+        gc_markers_free(ctxt, vm->gc_marker_num);
+
+    if (n == 1)
+        return OX_OK;
+
+    if (!OX_NEW_N_0(ctxt, vm->gc_markers, n))
+        return ox_throw_no_mem_error(ctxt);
+
+    vm->gc_marker_num = n;
+
+    for (i = 0; i < n; i ++) {
+        OX_GcMarker *m = &vm->gc_markers[i];
+
+        m->ctxt.base.vm = vm;
+        m->ctxt.gc_marker = m;
+        m->seq = vm->gc_mark_seq;
+
+        ox_mutex_init(&m->lock);
+        ox_vector_init(&m->stack);
+    }
+
+    for (i = 1; i < n; i ++) {
+        OX_GcMarker *m = &vm->gc_markers[i];
+
+        if ((r = ox_thread_create(ctxt, &m->thread, gc_marker_entry, m)) == OX_ERR) {
+            /*Stop the threads created, the marking runs in the current thread only.*/
+            gc_markers_free(ctxt, i);
+            return r;
         }
     }
+
+    vm->gc_thread_num = n;
+
+    return OX_OK;
 }
 
 /**
- * Add the GC managed object to the garbage collecter.
+ * Set the memory size to start running the garbage collecter.
  * @param ctxt The current running context.
- * @param ptr The GC managed object's pointer.
+ * @param size The memory size in bytes.
  */
 void
-ox_gc_add (OX_Context *ctxt, void *ptr)
+ox_gc_set_start_size (OX_Context *ctxt, size_t size)
 {
     OX_VM *vm = ox_vm_get(ctxt);
-    OX_GcObject *gco = ptr;
 
-    gco->next_flags = OX_PTR2SIZE(vm->gco_list);
-    vm->gco_list = gco;
+    vm->gc_start_size = size;
+}
 
-    if ((vm->mem_allocted >= vm->gc_start_size)
-            && (vm->mem_allocted * 3 > vm->gc_last_size * 4)) {
-        ox_gc_run(ctxt);
-    }
+/**
+ * Get the memory size to start running the garbage collecter.
+ * @param ctxt The current running context.
+ * @return The memory size in bytes.
+ */
+size_t
+ox_gc_get_start_size (OX_Context *ctxt)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+
+    return vm->gc_start_size;
 }
 
 /**
- * Run the garbage collecter.
+ * Set the memory growth to start the next full collection.
+ * The full collection starts when the allocated memory size exceeds
+ * "percent"% of the size after the last full collection.
  * @param ctxt The current running context.
+ * @param percent The growth in percent, at least 101.
  */
 void
-ox_gc_run (OX_Context *ctxt)
+ox_gc_set_growth (OX_Context *ctxt, int percent)
 {
     OX_VM *vm = ox_vm_get(ctxt);
-#if OX_LOG_LEVEL <= OX_LOG_LEVEL_DEBUG
-    size_t size = vm->mem_allocted;
-#endif
 
-    OX_LOG_D(ctxt, "gc start, allocated: %"PRIdPTR"B", vm->mem_allocted);
+    if (percent < 101)
+        percent = 101;
 
-    vm->gc_marked_full = OX_FALSE;
-    vm->gc_scan_cnt = 0;
+    vm->gc_growth = percent;
+}
 
-    gc_scan_root(ctxt);
+/**
+ * Get the memory growth to start the next full collection.
+ * @param ctxt The current running context.
+ * @return The growth in percent.
+ */
+int
+ox_gc_get_growth (OX_Context *ctxt)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+
+    return vm->gc_growth;
+}
+
+/**
+ * Set the number of objects scanned in an incremental marking slice.
+ * A smaller value shortens the pauses of the allocations,
+ * and a larger value finishes the marking in less slices.
+ * @param ctxt The current running context.
+ * @param n Number of objects, at least 1.
+ */
+void
+ox_gc_set_slice_work (OX_Context *ctxt, size_t n)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
 
-    gc_scan_objects(ctxt);
+    if (n < 1)
+        n = 1;
 
-    gc_sweep(ctxt);
+    vm->gc_slice_work = n;
+}
 
-    vm->gc_last_size = vm->mem_allocted;
+/**
+ * Get the number of objects scanned in an incremental marking slice.
+ * @param ctxt The current running context.
+ * @return Number of objects.
+ */
+size_t
+ox_gc_get_slice_work (OX_Context *ctxt)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
 
-    OX_LOG_D(ctxt, "gc end, collect %"PRIdPTR"B", size - vm->mem_allocted);
+    return vm->gc_slice_work;
 }
 
 /**
- * Mark the GC managed object as used.
- * This function must be invoked in garbage collection process.
+ * Set the maximum heap size.
+ * An allocation exceeding the maximum heap size runs a full collection first.
+ * If it still exceeds the maximum heap size, the allocation fails,
+ * and the caller throws a no memory error.
  * @param ctxt The current running context.
- * @param gco The GC managed object.
+ * @param size The maximum heap size in bytes, 0 means no limit.
  */
 void
-ox_gc_mark_inner (OX_Context *ctxt, OX_GcObject *gco)
+ox_gc_set_max_size (OX_Context *ctxt, size_t size)
 {
     OX_VM *vm = ox_vm_get(ctxt);
-    size_t left;
 
-    gco->next_flags |= OX_GC_FL_MARKED;
+    vm->gc_max_size = size;
+}
+
+/**
+ * Get the maximum heap size.
+ * @param ctxt The current running context.
+ * @return The maximum heap size in bytes, 0 means no limit.
+ */
+size_t
+ox_gc_get_max_size (OX_Context *ctxt)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
 
-    left = ox_vector_space(&vm->gc_marked_stack);
-    if (left) {
-        size_t len = ox_vector_length(&vm->gc_marked_stack);
+    return vm->gc_max_size;
+}
 
-        ox_vector_item(&vm->gc_marked_stack, len) = gco;
-        vm->gc_marked_stack.len ++;
-    } else {
-        vm->gc_marked_full = OX_TRUE;
+/**
+ * Get the statistics of the garbage collecter.
+ * @param ctxt The current running context.
+ * @param[out] stats Return the statistics.
+ */
+void
+ox_gc_get_stats (OX_Context *ctxt, OX_GcStats *stats)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+    OX_Context *c;
+
+    assert(stats);
+
+    /*Fold the memory size counted by the contexts.*/
+    ox_list_foreach_c(&vm->ctxt_list, c, OX_Context, ln) {
+        ox_mem_flush(ctxt, c);
+    }
+
+    stats->minor_count = vm->gc_minor_count;
+    stats->full_count = vm->gc_full_count;
+    stats->pause_total = vm->gc_pause_total;
+    stats->pause_max = vm->gc_pause_max;
+    stats->allocated = vm->mem_alloc_total;
+    stats->freed = vm->mem_free_total;
+    stats->live_size = vm->gc_last_size;
+    stats->mem_size = vm->mem_allocted;
+    stats->max_mem_size = vm->mem_max_allocated;
+}
+
+/**
+ * Set the callback function invoked when a collection finished.
+ * The callback is invoked in the garbage collecter,
+ * it must not allocate GC managed objects or run scripts.
+ * @param ctxt The current running context.
+ * @param cb The callback function, NULL means no callback.
+ * @param data The user defined data passed to the callback.
+ */
+void
+ox_gc_set_callback (OX_Context *ctxt, OX_GcCallback cb, void *data)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+
+    vm->gc_cb = cb;
+    vm->gc_cb_data = data;
+}
+
+/**
+ * Parse the memory size string.
+ * The string is a decimal number with an optional suffix "K", "M" or "G".
+ * @param str The size string.
+ * @param[out] psize Return the size in bytes.
+ * @retval OX_OK On success.
+ * @retval OX_ERR The string is not a valid size.
+ */
+OX_Result
+ox_gc_parse_size (const char *str, size_t *psize)
+{
+    unsigned long long n;
+    char *end;
+    int shift = 0;
+
+    if (!ox_char_is_digit(*str))
+        return OX_ERR;
+
+    errno = 0;
+    n = strtoull(str, &end, 10);
+    if (errno)
+        return OX_ERR;
+
+    switch (*end) {
+    case 'k':
+    case 'K':
+        shift = 10;
+        break;
+    case 'm':
+    case 'M':
+        shift = 20;
+        break;
+    case 'g':
+    case 'G':
+        shift = 30;
+        break;
+    default:
+        break;
     }
+
+    if (shift)
+        end ++;
+
+    if (*end || (n > (SIZE_MAX >> shift)))
+        return OX_ERR;
+
+    *psize = n << shift;
+    return OX_OK;
+}
+
+/**
+ * Parse the memory growth percent string.
+ * @param str The growth string.
+ * @param[out] pgrowth Return the growth percent.
+ * @retval OX_OK On success.
+ * @retval OX_ERR The string is not a valid growth, it must be an integer greater than 100.
+ */
+OX_Result
+ox_gc_parse_growth (const char *str, int *pgrowth)
+{
+    long n;
+    char *end;
+
+    if (!ox_char_is_digit(*str))
+        return OX_ERR;
+
+    errno = 0;
+    n = strtol(str, &end, 10);
+    if (errno || *end || (n <= 100) || (n > INT_MAX))
+        return OX_ERR;
+
+    *pgrowth = n;
+    return OX_OK;
 }
 
 /**
@@ -240,13 +1681,52 @@ ox_gc_init (OX_Context *ctxt)
 {
     OX_VM *vm = ox_vm_get(ctxt);
 
-    vm->gc_start_size = 64 * 1024;
+    vm->gc_start_size = OX_GC_START_SIZE;
+    vm->gc_growth = OX_GC_GROWTH;
+    vm->gc_max_size = 0;
+    vm->gc_keep = NULL;
+    vm->gc_keep_num = 0;
+    vm->gc_busy = 0;
+    vm->gc_minor_count = 0;
+    vm->gc_full_count = 0;
+    vm->gc_pause_total = 0;
+    vm->gc_pause_max = 0;
+    vm->gc_pause_start = 0;
+    vm->gc_pause_depth = 0;
+    vm->gc_finished = 0;
+    vm->gc_cb = NULL;
+    vm->gc_cb_data = NULL;
     vm->gc_last_size = 0;
-    vm->gco_list = NULL;
+    vm->gc_full_size = 0;
+    vm->gc_segs = NULL;
+    vm->gco_young = NULL;
+    vm->gc_sweep_segs = NULL;
+    vm->gco_adding = NULL;
+    vm->gc_marking = OX_FALSE;
+    vm->gc_slice_start = 0;
+    vm->gc_slice_work = OX_GC_SLICE_WORK;
+    vm->gc_thread_num = 1;
+    vm->gc_markers = NULL;
+    vm->gc_marker_num = 0;
+    vm->gc_parallel = OX_FALSE;
+    vm->gc_quit = OX_FALSE;
+    vm->gc_mark_seq = 0;
+
+    ox_mutex_init(&vm->gc_lock);
+    ox_cond_var_init(&vm->gc_start_cv);
+    ox_cond_var_init(&vm->gc_end_cv);
+    ox_cond_var_init(&vm->gc_idle_cv);
 
     /*Initialize the marked object stack.*/
-    ox_vector_init(&vm->gc_marked_stack);
-    ox_not_error(ox_vector_set_capacity(ctxt, &vm->gc_marked_stack, 64));
+    ox_not_null(OX_NEW(ctxt, vm->gc_marked_stack.top));
+    vm->gc_marked_stack.top->prev = NULL;
+    vm->gc_marked_stack.spare = NULL;
+    vm->gc_marked_stack.len = 0;
+    vm->gc_marked_stack.num = 0;
+    vm->gc_marked_stack.chunk_num = 1;
+    vm->gc_marked_stack.max = OX_GC_MARK_STACK_MAX;
+
+    ox_vector_init(&vm->gc_remembered);
 }
 
 /**
@@ -258,15 +1738,47 @@ ox_gc_deinit (OX_Context *ctxt)
 {
     OX_VM *vm = ox_vm_get(ctxt);
     OX_GcObject *o, *no;
+    OX_GcSegment *seg;
+
+    /*Stop the marking threads.*/
+    if (vm->gc_markers)
+        gc_markers_free(ctxt, vm->gc_marker_num);
+
+    /*Finish the pending sweeping.*/
+    gc_publish_all(ctxt);
+    gc_sweep_finish(ctxt);
 
     /*Free all the objects.*/
-    for (o = vm->gco_list; o; o = no) {
+    for (o = vm->gco_young; o; o = no) {
         no = gco_next(o);
 
         if (o->ops->free)
             o->ops->free(ctxt, o);
     }
 
+    while ((seg = vm->gc_segs)) {
+        size_t i;
+
+        for (i = 0; i < seg->len; i ++) {
+            o = seg->objs[i];
+
+            if (o->ops->free)
+                o->ops->free(ctxt, o);
+        }
+
+        vm->gc_segs = seg->next;
+        OX_DEL(ctxt, seg);
+    }
+
     /*Free the marked object stack.*/
-    ox_vector_deinit(ctxt, &vm->gc_marked_stack);
+    gc_marked_clear(ctxt);
+    OX_DEL(ctxt, vm->gc_marked_stack.top);
+    if (vm->gc_marked_stack.spare)
+        OX_DEL(ctxt, vm->gc_marked_stack.spare);
+    ox_vector_deinit(ctxt, &vm->gc_remembered);
+
+    ox_cond_var_deinit(&vm->gc_start_cv);
+    ox_cond_var_deinit(&vm->gc_end_cv);
+    ox_cond_var_deinit(&vm->gc_idle_cv);
+    ox_mutex_deinit(&vm->gc_lock);
 }
@@ -127,6 +127,40 @@ add_inherit (OX_Context *ctxt, OX_Interface *inf, OX_Interface *iinf)
     return r;
 }
 
+/*Add the parent interface's property to the interface.*/
+static OX_Result
+inherit_prop (OX_Context *ctxt, OX_String *key, OX_Property *p, void *data)
+{
+    OX_Value *inf = data;
+    OX_VS_PUSH(ctxt, pn)
+    OX_Result r;
+
+    ox_value_set_gco(ctxt, pn, key);
+
+    if (ox_string_equal(ctxt, pn, OX_STRING(ctxt, _class))
+            || ox_string_equal(ctxt, pn, OX_STRING(ctxt, _scope))) {
+        r = OX_OK;
+        goto end;
+    }
+
+    switch (p->type) {
+    case OX_PROPERTY_CONST:
+    case OX_PROPERTY_VAR:
+        r = ox_object_add_prop(ctxt, inf, p->type, pn, &p->p.v, NULL);
+        break;
+    case OX_PROPERTY_ACCESSOR:
+        r = ox_object_add_prop(ctxt, inf, p->type, pn, &p->p.a.get, &p->p.a.set);
+        break;
+    default:
+        assert(0);
+        r = OX_ERR;
+        break;
+    }
+end:
+    OX_VS_POP(ctxt, pn)
+    return r;
+}
+
 /**
  * Inherit properties from the parent interface.
  * @param ctxt The current running context.
@@ -138,9 +172,7 @@ add_inherit (OX_Context *ctxt, OX_Interface *inf, OX_Interface *iinf)
 OX_Result
 ox_interface_inherit (OX_Context *ctxt, OX_Value *inf, OX_Value *pinf)
 {
-    OX_VS_PUSH(ctxt, pn)
     OX_Interface *ip, *iip;
-    OX_Property *p;
     size_t i;
     OX_HashEntry *e;
     OX_Result r;
@@ -153,29 +185,8 @@ ox_interface_inherit (OX_Context *ctxt, OX_Value *inf, OX_Value *pinf)
     iip = ox_value_get_gco(ctxt, pinf);
 
     /*Add properties.*/
-    ox_list_foreach_c(&iip->o.p_list, p, OX_Property, ln) {
-        ox_value_set_gco(ctxt, pn, p->he.key);
-
-        if (ox_string_equal(ctxt, pn, OX_STRING(ctxt, _class))
-                || ox_string_equal(ctxt, pn, OX_STRING(ctxt, _scope)))
-            continue;
-
-        switch (p->type) {
-        case OX_PROPERTY_CONST:
-        case OX_PROPERTY_VAR:
-            r = ox_object_add_prop(ctxt, inf, p->type, pn, &p->p.v, NULL);
-            break;
-        case OX_PROPERTY_ACCESSOR:
-            r = ox_object_add_prop(ctxt, inf, p->type, pn, &p->p.a.get, &p->p.a.set);
-            break;
-        default:
-            assert(0);
-            break;
-        }
-
-        if (r == OX_ERR)
-            goto end;
-    }
+    if ((r = ox_object_foreach_prop(ctxt, &iip->o, inherit_prop, inf)) == OX_ERR)
+        goto end;
 
     /*Add the interface.*/
     if ((r = add_inherit(ctxt, ip, iip)) == OX_ERR)
@@ -188,7 +199,6 @@ ox_interface_inherit (OX_Context *ctxt, OX_Value *inf, OX_Value *pinf)
 
     r = OX_OK;
 end:
-    OX_VS_POP(ctxt, pn)
     return r;
 }
 
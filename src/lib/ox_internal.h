@@ -244,6 +244,10 @@ typedef enum {
 #define OX_DECL_TYPE_MASK  0xff
 /** Declaration is an auto closed variable.*/
 #define OX_DECL_AUTO_CLOSE (1 << 8) 
+/** Declaration is referenced by an inner function.*/
+#define OX_DECL_CAPTURED   (1 << 9)
+/** Captured declaration is stored in a cell shared with the inner functions.*/
+#define OX_DECL_BOXED      (1 << 10)
 
 /** Script declaration entry.*/
 typedef struct {
@@ -254,7 +258,24 @@ typedef struct {
 } OX_ScriptDecl;
 
 /** The function has this argument.*/
-#define OX_SCRIPT_FUNC_FL_THIS (1 << 0)
+#define OX_SCRIPT_FUNC_FL_THIS          (1 << 0)
+
+/** Source of the value captured by the function.*/
+typedef enum {
+    OX_SCRIPT_CAP_LOCAL, /**< The local declaration of the outer function.*/
+    OX_SCRIPT_CAP_THIS,  /**< The this argument of the outer function.*/
+    OX_SCRIPT_CAP_OUTER  /**< The value captured by the outer function.*/
+} OX_ScriptCapType;
+
+/** Value captured by the function.*/
+typedef struct {
+    OX_ScriptDecl *decl; /**< The captured declaration, NULL for this argument.*/
+    uint16_t       type; /**< Source of the value.*/
+    uint16_t       id;   /**< Index of the declaration in the outer frame or the value captured by the outer function.*/
+} OX_ScriptCapture;
+
+/** Native code of the script function generated by the JIT compiler.*/
+typedef struct OX_JitCode_s OX_JitCode;
 
 /** Script function data.*/
 typedef struct {
@@ -263,11 +284,17 @@ typedef struct {
     OX_List      decl_list; /**< Declaration list.*/
     size_t       loc_start; /**< Location offset.*/
     size_t       bc_start;  /**< Byte code start offset.*/
+    size_t       try_start; /**< Exception handling table offset.*/
+    uint16_t     try_len;   /**< Exception handling table length.*/
     uint16_t     loc_len;   /**< Location length.*/
     uint16_t     bc_len;    /**< Byte code length of the function.*/
+    uint16_t     cap_num;   /**< Number of the captured values.*/
+    OX_ScriptCapture *caps; /**< The captured values.*/
     uint8_t      frame_num; /**< Referenced frames' number.*/
     uint8_t      reg_num;   /**< Used regisers' number.*/
     uint16_t     flags;     /**< Flags.*/
+    uint32_t     jit_cnt;   /**< Hot counter of calls and jumps before JIT compiling.*/
+    OX_JitCode  *jit;       /**< The native code compiled by the JIT compiler.*/
 } OX_ScriptFunc;
 
 /** Script reference item.*/
@@ -292,6 +319,8 @@ struct OX_Frame_s {
     OX_Value     func; /**< The function.*/
     int          ip;   /**< Insruction pointer.*/
     size_t       len;  /**< Length of the value buffer.*/
+    size_t       cap;  /**< Capacity of the value buffer.*/
+    OX_Bool      escaped; /**< The frame is referenced out of the stack and managed by GC.*/
     OX_Frame    *bot;  /**< The bottom frame.*/
     OX_Value     thiz; /**< This argument.*/
     OX_Value    *v;    /**< The value buffer.*/
@@ -319,6 +348,23 @@ typedef struct {
     uint16_t ip;   /**< Instruction pointer.*/
 } OX_ScriptLoc;
 
+/** The try statement has a catch block.*/
+#define OX_SCRIPT_TRY_FL_CATCH   (1 << 0)
+/** The try statement has a finally block.*/
+#define OX_SCRIPT_TRY_FL_FINALLY (1 << 1)
+
+/**
+ * Exception handling entry of a try statement.
+ * The try block is [start, catch_ip) and the catch block is [catch_ip, finally_ip).
+ */
+typedef struct {
+    uint16_t start;      /**< Instruction pointer of the try block.*/
+    uint16_t catch_ip;   /**< Instruction pointer of the catch block.*/
+    uint16_t finally_ip; /**< Instruction pointer of the finally block.*/
+    uint16_t level;      /**< Status stack level of the try statement in the function.*/
+    uint16_t flags;      /**< Flags.*/
+} OX_ScriptTry;
+
 /** Script.*/
 typedef struct OX_Script_s OX_Script;
 
@@ -339,6 +385,57 @@ struct OX_Script_s {
     OX_Value          text_domain;  /**< Text domain.*/
 };
 
+/**
+ * Maximum number of properties in a shape mode object.
+ * The shape looks up the key by linear searching,
+ * an object with more properties is switched to dictionary mode.
+ */
+#define OX_SHAPE_PROP_MAX 32
+
+/** Shape of the objects.*/
+struct OX_Shape_s {
+    OX_HashEntry  he;     /**< Hash table entry in the parent's transitions table.*/
+    OX_Shape     *parent; /**< The parent shape.*/
+    OX_String   **keys;   /**< Properties' keys array, the index is the property's slot.*/
+    size_t        num;    /**< Number of properties.*/
+    OX_Hash       t_hash; /**< Transitions hash table (key -> child shape).*/
+    size_t        ref;    /**< Reference counter.*/
+};
+
+/** Property entry in the properties dictionary.*/
+typedef struct {
+    OX_HashEntry he;   /**< Hash table entry data.*/
+    OX_List      ln;   /**< List node data.*/
+    OX_Property  prop; /**< The property.*/
+} OX_PropertyEntry;
+
+/** Properties dictionary of the object.*/
+struct OX_PropertyDict_s {
+    OX_List p_list; /**< Properties list.*/
+    OX_Hash p_hash; /**< Properties hash table.*/
+};
+
+/** Number of entries in a property cache.*/
+#define OX_PROP_CACHE_ENTRY_NUM 4
+
+/** Property cache entry.*/
+typedef struct {
+    const OX_GcObjectOps *ops; /**< The object's operation functions.*/
+    void        *layout;    /**< The object's shape, or the object itself in dictionary mode.*/
+    OX_String   *key;       /**< The property's key.*/
+    OX_Object   *inf;       /**< The interface owned the property, NULL if the object owned it.*/
+    OX_Shape    *inf_shape; /**< The interface's shape.*/
+    OX_Property *prop;      /**< The property in a dictionary mode object.*/
+    size_t       id;        /**< The property's slot in a shape mode object.*/
+    size_t       p_num;     /**< Number of the dictionary mode object's own properties.*/
+    size_t       ver;       /**< Version of the cache.*/
+} OX_PropCacheEntry;
+
+/** Property cache of a property accessing instruction.*/
+typedef struct {
+    OX_PropCacheEntry e[OX_PROP_CACHE_ENTRY_NUM]; /**< Entries.*/
+} OX_PropCache;
+
 /** Bytecode script.*/
 struct OX_BcScript_s {
     OX_Script         script;       /**< Base script data.*/
@@ -348,6 +445,8 @@ struct OX_BcScript_s {
     size_t            cv_num;       /**< Number of contant values.*/
     OX_Value         *pps;          /**< Private property array.*/
     size_t            pp_num;       /**< Number of private properties.*/
+    OX_PropCache     *pcs;          /**< Property cache array.*/
+    size_t            pc_num;       /**< Number of property caches.*/
     OX_Value         *ts;           /**< Text string array.*/
     OX_Value         *lts;          /**< Localized text string array.*/
     size_t            t_num;        /**< Number of localized text strings.*/
@@ -360,6 +459,8 @@ struct OX_BcScript_s {
     size_t            bc_len;       /**< Length of the bytecode buffer.*/
     OX_ScriptLoc     *loc_tab;      /**< Location table.*/
     size_t            loc_tab_len;  /**< Length of the location table.*/
+    OX_ScriptTry     *try_tab;      /**< Exception handling table.*/
+    size_t            try_tab_len;  /**< Length of the exception handling table.*/
 };
 
 /** Native script.*/
@@ -369,18 +470,37 @@ typedef struct {
     size_t     frame_size; /**< Size of the frame.*/
 } OX_NativeScript;
 
+/** Cell stores a declaration captured by the inner functions.*/
+typedef struct {
+    OX_GcObject gco; /**< Base GC managed object data.*/
+    OX_Value    v;   /**< The value.*/
+} OX_Cell;
+
 /** Function.*/
 typedef struct {
     OX_Object       o;      /**< Base object data.*/
     OX_ScriptFunc  *sfunc;  /**< The script function of this function.*/
-    OX_Frame      **frames; /**< The referenced frames.*/
+    OX_Frame      **frames; /**< The referenced script frames.*/
+    OX_Value       *caps;   /**< The captured values, the cells or the values never changed.*/
 } OX_Function;
 
+/** Intrinsic operation of the native function.*/
+typedef enum {
+    OX_INTRINSIC_NONE,          /**< No intrinsic operation.*/
+    OX_INTRINSIC_MATH_SQRT,     /**< Math.sqrt.*/
+    OX_INTRINSIC_MATH_FLOOR,    /**< Math.floor.*/
+    OX_INTRINSIC_ARRAY_LENGTH,  /**< Array.$inf.length get.*/
+    OX_INTRINSIC_ARRAY_PUSH,    /**< Array.$inf.push.*/
+    OX_INTRINSIC_STRING_LENGTH, /**< String.$inf.length get.*/
+    OX_INTRINSIC_OBJECT_KEYS    /**< Object.keys.*/
+} OX_Intrinsic;
+
 /** Native function.*/
 typedef struct {
-    OX_Object  o;      /**< Base object data.*/
-    OX_Script *script; /**< The script contains this function.*/
-    OX_CFunc   cf;     /**< C function's pointer.*/
+    OX_Object     o;         /**< Base object data.*/
+    OX_Script    *script;    /**< The script contains this function.*/
+    OX_CFunc      cf;        /**< C function's pointer.*/
+    OX_Intrinsic  intrinsic; /**< The intrinsic operation the interpreter can run inline.*/
 } OX_NativeFunc;
 
 /** Stack entry's type.*/
@@ -400,13 +520,6 @@ typedef enum {
     OX_STACK_RETURN   /**< Return.*/
 } OX_StackType;
 
-/** Try state.*/
-typedef enum {
-    OX_TRY_STATE_TRY,     /**< In try block.*/
-    OX_TRY_STATE_CATCH,   /**< In catch block.*/
-    OX_TRY_STATE_FINALLY  /**< In finally block.*/
-} OX_TryState;
-
 /** Value entry.*/
 typedef struct {
     OX_HashEntry he; /**< Hash table entry.*/
@@ -422,8 +535,21 @@ typedef struct {
     OX_Frame    *frame;/**< The frame pointer.*/
     size_t       vp;   /**< Value stack pointer.*/
     size_t       sp;   /**< Status stack pointer.*/
+    size_t       ap;   /**< Arguments' value stack pointer of the direct call.*/
 } OX_RunStatusRec;
 
+/**
+ * Fast iteration step function of a builtin container.
+ * @param ctxt The current running context.
+ * @param c The container.
+ * @param[in,out] pos The current position in the container.
+ * @param[out] v Return the current value.
+ * @retval OX_TRUE Get the value and move to the next position.
+ * @retval OX_FALSE The iteration is end.
+ * @retval OX_ERR On error.
+ */
+typedef OX_Result (*OX_IterStepFunc) (OX_Context *ctxt, OX_Value *c, size_t *pos, OX_Value *v);
+
 /** Stack entry.*/
 typedef struct {
     OX_StackType type; /**< Entry's type.*/
@@ -441,15 +567,14 @@ typedef struct {
             size_t    argc;   /**< Arguments' count.*/
         } c;                  /**< Call entry data.*/
         struct {
-            OX_TryState state;         /**< The current state.*/
             OX_Result   r;             /**< Result.*/
-            int         catch_label;   /**< Catch jump label.*/
-            int         finally_label; /**< Finally jump label.*/
             size_t      jmp_ip;        /**< Deep jump's instruction pointer.*/
             size_t      jmp_sp;        /**< Deep jump's stack pointer.*/
         } t;                           /**< Try entry data.*/
         struct {
-            OX_Value *iter;   /**< Iterator.*/
+            OX_Value *iter;   /**< Iterator, or the container iterated by the step function.*/
+            OX_IterStepFunc step; /**< Fast iteration step function.*/
+            size_t    pos;    /**< Position of the fast iteration.*/
         } i;                  /**< Iterator entry data.*/
         struct {
             OX_Value *a;      /**< Array.*/
@@ -512,6 +637,96 @@ typedef struct {
     OX_RunStatusRec rsr;     /**< Run status record.*/
 } OX_Fiber;
 
+/** Parallel marker of the garbage collecter.*/
+typedef struct OX_GcMarker_s OX_GcMarker;
+
+/** Number of objects in a GC object segment.*/
+#define OX_GC_SEGMENT_SIZE 1024
+
+/** Segment of the old GC managed objects.*/
+typedef struct OX_GcSegment_s OX_GcSegment;
+
+/** Segment of the old GC managed objects.*/
+struct OX_GcSegment_s {
+    OX_GcSegment *next; /**< The next segment.*/
+    size_t        len;  /**< Number of objects in the segment.*/
+    OX_GcObject  *objs[OX_GC_SEGMENT_SIZE]; /**< The objects.*/
+};
+
+/** Number of objects in a chunk of the GC mark stack.*/
+#define OX_GC_MARK_CHUNK_SIZE 1024
+
+/** Maximum memory size of the GC mark stack.*/
+#define OX_GC_MARK_STACK_MAX (64 * 1024 * 1024)
+
+/** Chunk of the GC mark stack.*/
+typedef struct OX_GcMarkChunk_s OX_GcMarkChunk;
+
+/** Chunk of the GC mark stack.*/
+struct OX_GcMarkChunk_s {
+    OX_GcMarkChunk *prev; /**< The previous chunk.*/
+    OX_GcObject    *objs[OX_GC_MARK_CHUNK_SIZE]; /**< The marked objects.*/
+};
+
+/**
+ * Mark stack of the garbage collecter.
+ * The stack grows by chunks, so pushing never copies the stored objects.
+ * When the stack reaches its maximum size (OX_GC_MARK_STACK_MAX by default)
+ * or a chunk cannot be allocated,
+ * the object is left marked but not scanned, the overflow flag is set,
+ * and the collecter finds these objects by rescanning the object lists.
+ */
+typedef struct {
+    OX_GcMarkChunk *top;       /**< The top chunk.*/
+    OX_GcMarkChunk *spare;     /**< The free chunk kept for reusing.*/
+    size_t          len;       /**< Number of objects in the top chunk.*/
+    size_t          num;       /**< Number of objects in the stack.*/
+    size_t          chunk_num; /**< Number of the allocated chunks.*/
+    size_t          max;       /**< Maximum memory size of the stack.*/
+} OX_GcMarkStack;
+
+/*The slab allocator is disabled with the address sanitizer,
+ *so the sanitizer can check every buffer.*/
+#if defined(OX_SUPPORT_MMAP) && !defined(__SANITIZE_ADDRESS__)
+#define OX_MEM_SLAB
+#endif
+
+/** Size of a memory slab.*/
+#define OX_MEM_SLAB_SIZE (64 * 1024)
+
+/** Size step of the slab size classes.*/
+#define OX_MEM_SLAB_STEP 16
+
+/** Maximum buffer size allocated from the slabs.*/
+#define OX_MEM_SLAB_MAX 256
+
+/** Number of the slab size classes.*/
+#define OX_MEM_SLAB_CLASS_NUM (OX_MEM_SLAB_MAX / OX_MEM_SLAB_STEP)
+
+/** Maximum number of the free buffers cached by a context in a size class.*/
+#define OX_MEM_CACHE_MAX 64
+
+/** Number of the objects added by a context and published to the collecter in a batch.*/
+#define OX_GC_PENDING_MAX 64
+
+/** Memory size counted by a context before it is folded into the virtual machine.*/
+#define OX_MEM_FLUSH_SIZE (64 * 1024)
+
+/** Memory slab contains the small buffers with the same size.*/
+typedef struct {
+    OX_List  ln;   /**< List node data.*/
+    void    *free; /**< The freed buffers list.*/
+    size_t   top;  /**< Offset of the buffers never allocated.*/
+    size_t   used; /**< Number of the used buffers.*/
+    int      cls;  /**< Size class of the buffers.*/
+} OX_MemSlab;
+
+/** Memory slab size class.*/
+typedef struct {
+    OX_List  partial; /**< Slabs have free buffers.*/
+    OX_List  full;    /**< Slabs have no free buffer.*/
+} OX_MemSlabClass;
+
 /** Virtual machine.*/
 struct OX_VM_s {
     OX_BaseVM       base;         /**< The base virtual machine.*/
@@ -520,16 +735,59 @@ struct OX_VM_s {
     FILE           *log_file;     /**< Log output file.*/
     size_t          mem_allocted; /**< Allocated memory size.*/
     size_t          mem_max_allocated; /**< Maximum allocate memory size.*/
+    uint64_t        mem_alloc_total;/**< Total allocated memory size.*/
+    uint64_t        mem_free_total;/**< Total freed memory size.*/
+    OX_MemSlabClass mem_slabs[OX_MEM_SLAB_CLASS_NUM]; /**< The small buffers' slabs.*/
     size_t          gc_start_size;/**< The memory size start running garbage collecter.*/
+    int             gc_growth;    /**< Memory growth in percent of the last full collection to start the next one.*/
+    size_t          gc_max_size;  /**< Maximum heap size, 0 means no limit.*/
+    int             gc_busy;      /**< The maximum heap size is not checked when it is not 0.*/
+    size_t          gc_minor_count;/**< Number of the minor collections.*/
+    size_t          gc_full_count;/**< Number of the full collections.*/
+    uint64_t        gc_pause_total;/**< Total pause time in nanoseconds.*/
+    uint64_t        gc_pause_max; /**< Maximum pause time in nanoseconds.*/
+    uint64_t        gc_pause_start;/**< Start time of the current pause.*/
+    int             gc_pause_depth;/**< Nesting depth of the current pause.*/
+    int             gc_finished;  /**< The collections finished in the current pause.*/
+    OX_GcCallback   gc_cb;        /**< Callback invoked when a collection finished.*/
+    void           *gc_cb_data;   /**< User defined data of the callback.*/
     size_t          gc_last_size; /**< The memory size after last garbage collection.*/
-    OX_Bool         gc_marked_full;    /**< Marked GC object stack full flag.*/
-    int             gc_scan_cnt;  /**< GC scanning counter.*/
-    OX_VECTOR_TYPE_DECL(OX_GcObject*) gc_marked_stack; /**< Marked GC object stack.*/
-    OX_GcObject    *gco_list;     /**< The GC managed objects.*/
+    size_t          gc_full_size; /**< The memory size after last full garbage collection.*/
+    OX_Bool         gc_marking;   /**< The incremental marking is running.*/
+    size_t          gc_slice_start;/**< The memory size when last marking slice finished.*/
+    size_t          gc_slice_work;/**< Number of objects scanned in a marking slice.*/
+    OX_Bool         gc_marked_full;    /**< Marked GC object stack overflow flag.*/
+    OX_GcMarkStack  gc_marked_stack;   /**< Marked GC object stack.*/
+    OX_VECTOR_TYPE_DECL(OX_GcObject*) gc_remembered;   /**< Old objects may reference young objects.*/
+    OX_GcSegment   *gc_segs;      /**< Segments of the old GC managed objects.*/
+    OX_GcObject    *gco_young;    /**< The young GC managed objects allocated after last collection.*/
+    OX_GcSegment   *gc_sweep_segs;/**< The segments being swept.*/
+    OX_GcSegment   *gc_sweep_rseg;/**< The segment to be swept.*/
+    size_t          gc_sweep_ridx;/**< Index of the next object to be swept.*/
+    OX_GcSegment   *gc_sweep_wseg;/**< The segment to store the next surviving object.*/
+    size_t          gc_sweep_widx;/**< Index to store the next surviving object.*/
+    size_t          gc_sweep_work;/**< Number of objects swept in a sweeping slice.*/
+    OX_GcObject    *gco_adding;   /**< The object being added to the garbage collecter.*/
+    OX_GcObject    *gc_keep;      /**< The objects kept when reclaiming the memory.*/
+    size_t          gc_keep_num;  /**< Number of the kept objects.*/
+    int             gc_thread_num;/**< Number of the marking threads.*/
+    OX_GcMarker    *gc_markers;   /**< The parallel markers.*/
+    int             gc_marker_num;/**< Number of the parallel markers.*/
+    OX_Bool         gc_parallel;  /**< The parallel marking is running.*/
+    OX_Bool         gc_quit;      /**< The marking threads should quit.*/
+    int             gc_idle_num;  /**< Number of the idle markers.*/
+    int             gc_running_num;/**< Number of the running marking threads.*/
+    size_t          gc_mark_seq;  /**< Sequence number of the parallel marking.*/
+    OX_Mutex        gc_lock;      /**< The lock of the marking threads.*/
+    OX_CondVar      gc_start_cv;  /**< Wake up the marking threads.*/
+    OX_CondVar      gc_end_cv;    /**< The marking threads finished.*/
+    OX_CondVar      gc_idle_cv;   /**< Wake up the idle markers.*/
     OX_Hash         str_singleton_hash;/**< Singleton string hash table.*/
     char           *file_enc;     /**< File's character encoding.*/
     char           *install_dir;  /**< OX installation directory.*/
     OX_Bool         dump_throw;   /**< Dump stack when throw an error.*/
+    int             opt_level;    /**< Bytecode optimization level.*/
+    OX_Bool         jit;          /**< Enable the JIT compiler.*/
     OX_Value        strings[OX_STR_ID_MAX]; /**< Strings table.*/
     OX_Value        objects[OX_OBJ_ID_MAX]; /**< Objects table.*/
     OX_Hash         script_hash;  /**< Script hash table.*/
@@ -540,8 +798,20 @@ struct OX_VM_s {
     OX_List         ctxt_list;    /**< Contexts list.*/
     int             ref;          /**< Reference counter.*/
     OX_Hash         global_ref_hash; /**< Global reference hash table.*/
+    size_t          prop_cache_ver;  /**< Property cache version.*/
+    OX_Shape        root_shape;   /**< The root shape of the objects.*/
+#ifdef OX_MEM_CHECK
+    OX_MemSlab    **mem_slab_tab; /**< The slabs sorted by address.*/
+    size_t          mem_slab_num; /**< Number of the slabs.*/
+#endif /*OX_MEM_CHECK*/
 };
 
+/** Frame information recorded when an error is thrown.*/
+typedef struct {
+    OX_Value func; /**< The function of the frame.*/
+    int      ip;   /**< The instruction pointer.*/
+} OX_ErrorFrame;
+
 /** Running context.*/
 struct OX_Context_s {
     OX_BaseContext   base;         /**< The base context data.*/
@@ -550,11 +820,35 @@ struct OX_Context_s {
     OX_StatusBuffer  bot_s_stack;  /**< The bottom status stack.*/
     OX_List          ln;           /**< List node data.*/
     OX_Frame        *frames;       /**< The value frame stack.*/
-    OX_Frame        *error_frames; /**< Error frame stack.*/
+    OX_VECTOR_TYPE_DECL(OX_ErrorFrame) error_frames; /**< Error frame stack.*/
     OX_Frame        *main_frames;  /**< The main frame stack.*/
+    OX_Frame        *frame_cache;  /**< The free frames can be reused.*/
+    size_t           frame_cache_num; /**< Number of frames in the cache.*/
     OX_Value         error;        /**< The error value.*/
     OX_Script       *curr_script;  /**< The current script.*/
     int              lock_cnt;     /**< Lock counter.*/
+    OX_GcMarker     *gc_marker;    /**< The marker used in the parallel marking.*/
+    OX_GcObject     *gco_pending;  /**< The objects added by the context and not published.*/
+    OX_GcObject     *gco_pending_last; /**< The last object in the pending list.*/
+    size_t           gco_pending_num;  /**< Number of the pending objects.*/
+    void            *mem_cache[OX_MEM_SLAB_CLASS_NUM]; /**< The free small buffers cached by the context.*/
+    size_t           mem_cache_num[OX_MEM_SLAB_CLASS_NUM]; /**< Number of the cached buffers.*/
+    size_t           mem_alloc;    /**< Allocated memory size not folded into the virtual machine.*/
+    size_t           mem_free;     /**< Freed memory size not folded into the virtual machine.*/
+};
+
+/** Number of objects in the parallel marker's local buffer.*/
+#define OX_GC_MARKER_BUF_SIZE 256
+
+/** Parallel marker of the garbage collecter.*/
+struct OX_GcMarker_s {
+    OX_Context    ctxt;    /**< The context used by the marking thread.*/
+    OX_Thread     thread;  /**< The marking thread.*/
+    size_t        seq;     /**< Sequence number of the last parallel marking.*/
+    OX_Mutex      lock;    /**< Lock of the shared stack.*/
+    OX_VECTOR_TYPE_DECL(OX_GcObject*) stack; /**< Marked objects can be stolen by the other markers.*/
+    size_t        buf_len; /**< Number of objects in the local buffer.*/
+    OX_GcObject  *buf[OX_GC_MARKER_BUF_SIZE]; /**< Local marked objects buffer.*/
 };
 
 /** Get the internal string value.*/
@@ -600,6 +894,21 @@ ox_mem_init (OX_Context *ctxt);
 extern void
 ox_mem_deinit (OX_Context *ctxt);
 
+/**
+ * Return the free buffers cached by the context.
+ * @param ctxt The current running context.
+ */
+extern void
+ox_mem_cache_deinit (OX_Context *ctxt);
+
+/**
+ * Fold the memory size counted by a context into the virtual machine.
+ * @param ctxt The current running context.
+ * @param c The context to be flushed.
+ */
+extern void
+ox_mem_flush (OX_Context *ctxt, OX_Context *c);
+
 /**
  * Initialize the garbage collecter.
  * @param ctxt The running context.
@@ -614,6 +923,41 @@ ox_gc_init (OX_Context *ctxt);
 extern void
 ox_gc_deinit (OX_Context *ctxt);
 
+/**
+ * Publish the pending objects added by the context to the garbage collecter.
+ * @param ctxt The current running context.
+ */
+extern void
+ox_gc_publish (OX_Context *ctxt);
+
+/**
+ * Free the unused objects at once as an allocation exceeds the maximum heap size.
+ * @param ctxt The current running context.
+ */
+extern void
+ox_gc_reclaim (OX_Context *ctxt);
+
+/**
+ * Parse the memory size string.
+ * The string is a decimal number with an optional suffix "K", "M" or "G".
+ * @param str The size string.
+ * @param[out] psize Return the size in bytes.
+ * @retval OX_OK On success.
+ * @retval OX_ERR The string is not a valid size.
+ */
+extern OX_Result
+ox_gc_parse_size (const char *str, size_t *psize);
+
+/**
+ * Parse the memory growth percent string.
+ * @param str The growth string.
+ * @param[out] pgrowth Return the growth percent.
+ * @retval OX_OK On success.
+ * @retval OX_ERR The string is not a valid growth, it must be an integer greater than 100.
+ */
+extern OX_Result
+ox_gc_parse_growth (const char *str, int *pgrowth);
+
 /**
  * Initialize the singleton string hash table.
  * @param ctxt The running context.
@@ -628,6 +972,35 @@ ox_string_singleton_init (OX_Context *ctxt);
 extern void
 ox_string_singleton_deinit (OX_Context *ctxt);
 
+/**
+ * Initialize the root shape of the objects.
+ * @param ctxt The running context.
+ */
+extern void
+ox_shape_init (OX_Context *ctxt);
+
+/**
+ * Release the root shape of the objects.
+ * @param ctxt The running context.
+ */
+extern void
+ox_shape_deinit (OX_Context *ctxt);
+
+/** Property traverse function.*/
+typedef OX_Result (*OX_PropertyFunc) (OX_Context *ctxt, OX_String *key, OX_Property *p, void *data);
+
+/**
+ * Traverse the properties of the object in adding order.
+ * @param ctxt The current running context.
+ * @param op The object.
+ * @param func The function invoked for each property.
+ * @param data The user defined data.
+ * @retval OX_OK On success.
+ * @retval OX_ERR On error.
+ */
+extern OX_Result
+ox_object_foreach_prop (OX_Context *ctxt, OX_Object *op, OX_PropertyFunc func, void *data);
+
 /**
  * Initialize the lexical analyzer.
  * @param ctxt The current running context.
@@ -826,6 +1199,222 @@ ox_ast_get_loc (OX_Context *ctxt, OX_Value *ast, OX_Location *loc);
 extern void
 ox_ast_set_loc (OX_Context *ctxt, OX_Value *ast, OX_Location *loc);
 
+/**
+ * Get the fast iteration step function of the array.
+ * @param ctxt The current running context.
+ * @param v The value to be iterated.
+ * @param cf The "$iter" method of the value.
+ * @return The step function.
+ * @retval NULL The value is not an array or cf is not the array's "$iter" method.
+ */
+extern OX_IterStepFunc
+ox_array_iter_step_get (OX_Context *ctxt, OX_Value *v, OX_CFunc cf);
+
+/**
+ * Get the fast iteration step function of the string.
+ * @param ctxt The current running context.
+ * @param v The value to be iterated.
+ * @param cf The "$iter" method of the value.
+ * @return The step function.
+ * @retval NULL The value is not a string or cf is not the string's "$iter" method.
+ */
+extern OX_IterStepFunc
+ox_string_iter_step_get (OX_Context *ctxt, OX_Value *v, OX_CFunc cf);
+
+/**
+ * Get the fast iteration step function of the C array.
+ * @param ctxt The current running context.
+ * @param v The value to be iterated.
+ * @param cf The "$iter" method of the value.
+ * @return The step function.
+ * @retval NULL The value is not a C array with known length or cf is not the C pointer's "$iter" method.
+ */
+extern OX_IterStepFunc
+ox_carray_iter_step_get (OX_Context *ctxt, OX_Value *v, OX_CFunc cf);
+
+/**
+ * Get the fast iteration step function of the value.
+ * Builtin containers can be iterated by the step function without creating an iterator object.
+ * @param ctxt The current running context.
+ * @param v The value to be iterated.
+ * @param[out] pstep Return the step function, or NULL if the value must be iterated by an iterator object.
+ * @retval OX_OK On success.
+ * @retval OX_ERR On error.
+ */
+extern OX_Result
+ox_iterator_step_get (OX_Context *ctxt, OX_Value *v, OX_IterStepFunc *pstep);
+
+/**
+ * Invalidate all the property caches.
+ * @param ctxt The current running context.
+ */
+static inline void
+ox_prop_cache_reset (OX_Context *ctxt)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+
+    vm->prop_cache_ver ++;
+}
+
+/**
+ * Call the getter of the accessor property.
+ * The getter is copied to the value stack at first,
+ * as the property's slot may be moved when the getter adds properties to the object.
+ * @param ctxt The current running context.
+ * @param prop The accessor property.
+ * @param thiz This argument.
+ * @param[out] v Return the property value.
+ * @retval OX_OK On success.
+ * @retval OX_ERR On error.
+ */
+static inline OX_Result
+ox_prop_call_get (OX_Context *ctxt, OX_Property *prop, OX_Value *thiz, OX_Value *v)
+{
+    OX_VS_PUSH(ctxt, get)
+    OX_Result r;
+
+    ox_value_copy(ctxt, get, &prop->p.a.get);
+    r = ox_call(ctxt, get, thiz, NULL, 0, v);
+
+    OX_VS_POP(ctxt, get)
+    return r;
+}
+
+/**
+ * Lookup the property in the property cache.
+ * @param ctxt The current running context.
+ * @param pc The property cache.
+ * @param o The object value.
+ * @param p The property's key.
+ * @return The property.
+ * @retval NULL The property is not in the cache.
+ */
+static inline OX_Property*
+ox_prop_cache_lookup (OX_Context *ctxt, OX_PropCache *pc, OX_Value *o, OX_Value *p)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+    OX_PropCacheEntry *e;
+    OX_GcObject *gco;
+    OX_Object *op, *iop;
+    OX_String *s;
+    void *layout;
+
+    o = ox_value_get_pointer(ctxt, o);
+    p = ox_value_get_pointer(ctxt, p);
+
+    if ((ox_value_get_tag(o) != OX_VALUE_TAG_GCO)
+            || (ox_value_get_tag(p) != OX_VALUE_TAG_GCO))
+        return NULL;
+
+    gco = ox_value_pointer_get_gco(o);
+    if (!(gco->ops->type & OX_GCO_FL_OBJECT))
+        return NULL;
+
+    op = (OX_Object*)gco;
+    s = ox_value_pointer_get_gco(p);
+    layout = op->shape ? (void*)op->shape : (void*)op;
+
+    for (e = pc->e; e < pc->e + OX_PROP_CACHE_ENTRY_NUM; e ++) {
+        if ((e->layout == layout) && (e->key == s) && (e->ops == gco->ops)
+                && (e->ver == vm->prop_cache_ver)) {
+            if (!e->inf)
+                return op->shape ? &op->p.props[e->id] : e->prop;
+
+            /*The object may own a new property overriding the interface's property.*/
+            if (!op->shape && (e->p_num != op->p.dict->p_hash.e_num))
+                break;
+
+            /*Objects with the same shape may have different interfaces.*/
+            if ((ox_value_get_tag(&op->inf) != OX_VALUE_TAG_GCO)
+                    || (ox_value_pointer_get_gco(&op->inf) != e->inf))
+                break;
+
+            iop = e->inf;
+            if (iop->shape != e->inf_shape)
+                break;
+
+            return iop->shape ? &iop->p.props[e->id] : e->prop;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Get the property value and store the property to the cache.
+ * @param ctxt The current running context.
+ * @param o The object value.
+ * @param p The property's key.
+ * @param[out] v Return the property value.
+ * @param pc The property cache.
+ * @retval OX_OK On success.
+ * @retval OX_ERR On error.
+ */
+extern OX_Result
+ox_object_get_pc (OX_Context *ctxt, OX_Value *o, OX_Value *p, OX_Value *v, OX_PropCache *pc);
+
+/**
+ * Get the property value with this argument and store the property to the cache.
+ * @param ctxt The current running context.
+ * @param o The object value.
+ * @param p The property's key.
+ * @param[out] v Return the property value.
+ * @param pc The property cache.
+ * @param thiz This argument of the accessor.
+ * @retval OX_OK On success.
+ * @retval OX_ERR On error.
+ */
+extern OX_Result
+ox_object_get_pc_t (OX_Context *ctxt, OX_Value *o, OX_Value *p, OX_Value *v, OX_PropCache *pc, OX_Value *thiz);
+
+/**
+ * Set the intrinsic operation of the native method or accessor getter owned by the object.
+ * @param ctxt The current running context.
+ * @param o The object value.
+ * @param name The name of the property.
+ * @param id The intrinsic operation.
+ * @retval OX_OK On success.
+ * @retval OX_ERR On error.
+ */
+extern OX_Result
+ox_object_set_intrinsic_s (OX_Context *ctxt, OX_Value *o, const char *name, OX_Intrinsic id);
+
+/**
+ * Set the intrinsic operation of the native function.
+ * The interpreter runs the operation inline when the function is called directly.
+ * @param ctxt The current running context.
+ * @param f The native function.
+ * @param id The intrinsic operation.
+ */
+extern void
+ox_native_func_set_intrinsic (OX_Context *ctxt, OX_Value *f, OX_Intrinsic id);
+
+/**
+ * Lookup the owned property and store the property to the cache.
+ * @param ctxt The current running context.
+ * @param o The object value.
+ * @param p The property's key.
+ * @param[out] v Return the property value.
+ * @param pc The property cache.
+ * @retval OX_OK On success.
+ * @retval OX_ERR On error.
+ */
+extern OX_Result
+ox_object_lookup_pc (OX_Context *ctxt, OX_Value *o, OX_Value *p, OX_Value *v, OX_PropCache *pc);
+
+/**
+ * Set the property value and store the property to the cache.
+ * @param ctxt The current running context.
+ * @param o The object value.
+ * @param p The property's key.
+ * @param v The property's new value.
+ * @param pc The property cache.
+ * @retval OX_OK On success.
+ * @retval OX_ERR On error.
+ */
+extern OX_Result
+ox_object_set_pc (OX_Context *ctxt, OX_Value *o, OX_Value *p, OX_Value *v, OX_PropCache *pc);
+
 /**
  * Push a new frame to the stack.
  * @param ctxt The current running context.
@@ -836,6 +1425,103 @@ ox_ast_set_loc (OX_Context *ctxt, OX_Value *ast, OX_Location *loc);
 extern OX_Frame*
 ox_frame_push (OX_Context *ctxt, OX_Value *func, size_t len);
 
+/**
+ * Create a new frame managed by GC.
+ * The frame is not pushed to the stack.
+ * @param ctxt The current running context.
+ * @param func The function use this frame.
+ * @param len Frame's value buffer length.
+ * @return The new frame.
+ */
+extern OX_Frame*
+ox_frame_new (OX_Context *ctxt, OX_Value *func, size_t len);
+
+/**
+ * Escape the frame and the frames under it.
+ * The escaped frames are managed by GC and will not be reused when popped.
+ * Frames must be escaped before they are referenced by a closure, a fiber or an error.
+ * @param ctxt The current running context.
+ * @param f The frame.
+ */
+extern void
+ox_frame_escape (OX_Context *ctxt, OX_Frame *f);
+
+/**
+ * Free the value frame.
+ * @param ctxt The current running context.
+ * @param f The frame to be freed.
+ */
+extern void
+ox_frame_free (OX_Context *ctxt, OX_Frame *f);
+
+/**
+ * Release the frames in the context.
+ * @param ctxt The current running context.
+ */
+extern void
+ox_frame_cache_deinit (OX_Context *ctxt);
+
+/**
+ * Create a new cell.
+ * @param ctxt The current running context.
+ * @param[out] c Return the new cell.
+ * @param v The initial value.
+ * @retval OX_OK On success.
+ * @retval OX_ERR On error.
+ */
+extern OX_Result
+ox_cell_new (OX_Context *ctxt, OX_Value *c, OX_Value *v);
+
+/**
+ * Get the value stored in the slot.
+ * If the slot stores a cell, return the value in the cell.
+ * @param ctxt The current running context.
+ * @param v The slot.
+ * @return The value.
+ */
+static inline OX_Value*
+ox_cell_value (OX_Context *ctxt, OX_Value *v)
+{
+    if (ox_value_is_gco(ctxt, v, OX_GCO_CELL)) {
+        OX_Cell *c = ox_value_get_gco(ctxt, v);
+
+        return &c->v;
+    }
+
+    return v;
+}
+
+/**
+ * Set the value stored in the slot.
+ * If the slot stores a cell, set the value in the cell.
+ * @param ctxt The current running context.
+ * @param v The slot.
+ * @param s The new value.
+ */
+static inline void
+ox_cell_set (OX_Context *ctxt, OX_Value *v, OX_Value *s)
+{
+    if (ox_value_is_gco(ctxt, v, OX_GCO_CELL)) {
+        OX_Cell *c = ox_value_get_gco(ctxt, v);
+
+        ox_value_copy(ctxt, &c->v, s);
+        ox_gc_write_barrier(ctxt, c);
+    } else {
+        ox_value_copy(ctxt, v, s);
+    }
+}
+
+/**
+ * Scan the frames in the stack.
+ * @param ctxt The current running context.
+ * @param f The top frame of the stack.
+ */
+extern void
+ox_gc_scan_frames (OX_Context *ctxt, OX_Frame *f);
+
+/** Maximum number of frames in the context's frame cache.*/
+#define OX_FRAME_CACHE_MAX 256
+
 /**
  * Popup the top frame from the stack.
  * @param ctxt The current running context.
@@ -848,6 +1534,16 @@ ox_frame_pop (OX_Context *ctxt)
     assert(f);
 
     ctxt->frames = f->bot;
+
+    if (!f->escaped) {
+        if (ctxt->frame_cache_num < OX_FRAME_CACHE_MAX) {
+            f->bot = ctxt->frame_cache;
+            ctxt->frame_cache = f;
+            ctxt->frame_cache_num ++;
+        } else {
+            ox_frame_free(ctxt, f);
+        }
+    }
 }
 
 /**
@@ -888,6 +1584,24 @@ ox_function_new (OX_Context *ctxt, OX_Value *f, OX_ScriptFunc *sfunc);
 extern int
 ox_function_lookup_line (OX_Context *ctxt, OX_Value *f, int ip);
 
+/**
+ * Free the native code of the script function.
+ * @param ctxt The current running context.
+ * @param sf The script function.
+ */
+extern void
+ox_jit_free (OX_Context *ctxt, OX_ScriptFunc *sf);
+
+#ifdef OX_BC_STAT
+/**
+ * Dump the bytecode pair statistics.
+ * The result is written to the file specified by environment variable
+ * "OX_BC_STAT_FILE", or to the standard error output if it is not set.
+ */
+extern void
+ox_bc_stat_dump (void);
+#endif /*OX_BC_STAT*/
+
 /**
  * Initialize the script hash table.
  * @param ctxt The current running context.
@@ -1131,7 +1845,8 @@ ox_stack_pop (OX_Context *ctxt)
         ox_value_stack_pop(ctxt, se->s.c.f);
         break;
     case OX_STACK_ITER:
-        r = ox_close(ctxt, se->s.i.iter);
+        if (!se->s.i.step)
+            r = ox_close(ctxt, se->s.i.iter);
         ox_value_stack_pop(ctxt, se->s.i.iter);
         break;
     case OX_STACK_ARRAY:
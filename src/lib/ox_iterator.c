@@ -115,6 +115,45 @@ ox_iterator_value (OX_Context *ctxt, OX_Value *iter, OX_Value *v)
     return ox_get_throw(ctxt, iter, OX_STRING(ctxt, value), v);
 }
 
+/**
+ * Get the fast iteration step function of the value.
+ * Builtin containers can be iterated by the step function without creating an iterator object.
+ * @param ctxt The current running context.
+ * @param v The value to be iterated.
+ * @param[out] pstep Return the step function, or NULL if the value must be iterated by an iterator object.
+ * @retval OX_OK On success.
+ * @retval OX_ERR On error.
+ */
+OX_Result
+ox_iterator_step_get (OX_Context *ctxt, OX_Value *v, OX_IterStepFunc *pstep)
+{
+    OX_VS_PUSH(ctxt, fn)
+    OX_IterStepFunc step = NULL;
+    OX_Result r = OX_OK;
+
+    assert(ctxt && v && pstep);
+
+    if (ox_value_is_array(ctxt, v)
+            || ox_value_is_string(ctxt, v)
+            || ox_value_is_cvalue(ctxt, v)) {
+        /*The "$iter" method may be overridden.*/
+        if ((r = ox_get(ctxt, v, OX_STRING(ctxt, _iter), fn)) == OX_ERR)
+            goto end;
+
+        if (ox_value_is_gco(ctxt, fn, OX_GCO_NATIVE_FUNC)) {
+            OX_NativeFunc *nf = ox_value_get_gco(ctxt, fn);
+
+            if (!(step = ox_array_iter_step_get(ctxt, v, nf->cf))
+                    && !(step = ox_string_iter_step_get(ctxt, v, nf->cf)))
+                step = ox_carray_iter_step_get(ctxt, v, nf->cf);
+        }
+    }
+end:
+    *pstep = step;
+    OX_VS_POP(ctxt, fn)
+    return r;
+}
+
 /*Iterator.$inf.$iter*/
 static OX_Result
 Iterator_inf_iterator (OX_Context *ctxt, OX_Value *f, OX_Value *thiz, OX_Value *args, size_t argc, OX_Value *rv)
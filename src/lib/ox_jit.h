@@ -0,0 +1,619 @@
+/******************************************************************************
+ *                                 OX Language                                *
+ *                                                                            *
+ * Copyright 2024 Gong Ke                                                     *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the              *
+ * "Software"), to deal in the Software without restriction, including        *
+ * without limitation the rights to use, copy, modify, merge, publish,        *
+ * distribute, sublicense, and/or sell copies of the Software, and to permit  *
+ * persons to whom the Software is furnished to do so, subject to the         *
+ * following conditions:                                                      *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included    *
+ * in all copies or substantial portions of the Software.                     *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS    *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF                 *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN  *
+ * NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,   *
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR      *
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE  *
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.                                     *
+ ******************************************************************************/
+
+/**
+ * @file
+ * Baseline JIT compiler.
+ * Each bytecode of a hot script function is translated to a native code
+ * stencil which calls the instruction function in "ox_run.h" directly.
+ * The registers' addresses and the constant operands are embedded in the
+ * native code, so the dispatching and the operands decoding are removed.
+ */
+
+#if OX_JIT
+
+/*The function is compiled when its hot counter reaches this value.*/
+#define OX_JIT_THRESHOLD 64
+
+/*The instruction pointer must be stored to the frame before running the bytecode.*/
+#define OX_JIT_FL_SAVE_IP 1
+/*The bytecode only jumps to its label operand.*/
+#define OX_JIT_FL_BRANCH  2
+
+/*Instruction function.*/
+typedef void (*OX_JitFunc) (void);
+
+/*Native code entry.*/
+typedef OX_Result (*OX_JitEntry) (OX_Context *ctxt, OX_RunStatus *rs, uint8_t *pc);
+
+/*Bytecode's native code stencil.*/
+typedef struct {
+    OX_JitFunc  func;  /*The instruction function.*/
+    const char *model; /*The operands' model.*/
+    int         flags; /*Flags.*/
+} OX_JitStencil;
+
+/*Bytecode -> stencil table.*/
+static const OX_JitStencil
+bytecode_jit_table[] = {
+#include "ox_bytecode_jit.h"
+};
+
+/*Native code of the script function.*/
+struct OX_JitCode_s {
+    uint8_t  *code; /*The native code buffer.*/
+    size_t    size; /*Size of the native code buffer.*/
+    uint32_t *offs; /*Native code offset of each instruction pointer.*/
+    size_t    len;  /*Length of the offset table.*/
+};
+
+/*Jump instruction need to be patched.*/
+typedef struct {
+    size_t pos; /*Position of the 32 bits displacement.*/
+    int    ip;  /*The target instruction pointer.*/
+} OX_JitFixup;
+
+/*JIT compiler.*/
+typedef struct {
+    OX_VECTOR_TYPE_DECL(uint8_t) code;       /*The native code.*/
+    OX_VECTOR_TYPE_DECL(OX_JitFixup) fixups; /*The jumps to be patched.*/
+    size_t   exit;                           /*Offset of the exit code.*/
+    OX_Result r;                             /*Result.*/
+} OX_JitCompiler;
+
+/*x86-64 registers.*/
+enum {
+    X_RAX, X_RCX, X_RDX, X_RBX, X_RSP, X_RBP, X_RSI, X_RDI,
+    X_R8,  X_R9,  X_R10, X_R11, X_R12, X_R13, X_R14, X_R15
+};
+
+/*Register holds the current running context.*/
+#define X_CTXT  X_RBX
+/*Register holds the running status.*/
+#define X_RS    X_R12
+/*Register holds the registers' value stack pointer.*/
+#define X_REGS  X_R13
+/*Register holds the current frame.*/
+#define X_FRAME X_R14
+
+/*Arguments' registers of the System V AMD64 calling convention.*/
+static const uint8_t
+jit_arg_regs[] = {X_RDI, X_RSI, X_RDX, X_RCX, X_R8, X_R9};
+
+/*Condition codes.*/
+#define X_CC_E  0x4
+#define X_CC_NE 0x5
+
+/*Add bytes to the native code.*/
+static void
+jit_bytes (OX_Context *ctxt, OX_JitCompiler *jc, const void *p, size_t n)
+{
+    if (jc->r == OX_ERR)
+        return;
+
+    if (ox_vector_expand_capacity(ctxt, &jc->code, jc->code.len + n) == OX_ERR) {
+        jc->r = OX_ERR;
+        return;
+    }
+
+    memcpy(jc->code.items + jc->code.len, p, n);
+    jc->code.len += n;
+}
+
+/*Add a byte to the native code.*/
+static void
+jit_u8 (OX_Context *ctxt, OX_JitCompiler *jc, uint8_t b)
+{
+    jit_bytes(ctxt, jc, &b, 1);
+}
+
+/*Add a 32 bits integer to the native code.*/
+static void
+jit_u32 (OX_Context *ctxt, OX_JitCompiler *jc, uint32_t v)
+{
+    jit_bytes(ctxt, jc, &v, 4);
+}
+
+/*Add a 64 bits integer to the native code.*/
+static void
+jit_u64 (OX_Context *ctxt, OX_JitCompiler *jc, uint64_t v)
+{
+    jit_bytes(ctxt, jc, &v, 8);
+}
+
+/*Add the REX prefix.*/
+static void
+jit_rex (OX_Context *ctxt, OX_JitCompiler *jc, int w, int reg, int base)
+{
+    uint8_t rex = 0x40 | (w << 3) | ((reg >> 3) << 2) | (base >> 3);
+
+    if (rex != 0x40)
+        jit_u8(ctxt, jc, rex);
+}
+
+/*Add the ModRM byte addressing [base + disp].*/
+static void
+jit_mem (OX_Context *ctxt, OX_JitCompiler *jc, int reg, int base, int32_t disp)
+{
+    int mod = ((disp >= -128) && (disp <= 127)) ? 1 : 2;
+
+    jit_u8(ctxt, jc, (mod << 6) | ((reg & 7) << 3) | (base & 7));
+
+    if ((base & 7) == X_RSP)
+        jit_u8(ctxt, jc, 0x24);
+
+    if (mod == 1)
+        jit_u8(ctxt, jc, disp);
+    else
+        jit_u32(ctxt, jc, disp);
+}
+
+/*push reg*/
+static void
+jit_push (OX_Context *ctxt, OX_JitCompiler *jc, int reg)
+{
+    jit_rex(ctxt, jc, 0, 0, reg);
+    jit_u8(ctxt, jc, 0x50 | (reg & 7));
+}
+
+/*pop reg*/
+static void
+jit_pop (OX_Context *ctxt, OX_JitCompiler *jc, int reg)
+{
+    jit_rex(ctxt, jc, 0, 0, reg);
+    jit_u8(ctxt, jc, 0x58 | (reg & 7));
+}
+
+/*mov dst, src*/
+static void
+jit_mov (OX_Context *ctxt, OX_JitCompiler *jc, int dst, int src)
+{
+    jit_rex(ctxt, jc, 1, src, dst);
+    jit_u8(ctxt, jc, 0x89);
+    jit_u8(ctxt, jc, 0xc0 | ((src & 7) << 3) | (dst & 7));
+}
+
+/*mov dst, [base + disp]*/
+static void
+jit_load (OX_Context *ctxt, OX_JitCompiler *jc, int dst, int base, int32_t disp)
+{
+    jit_rex(ctxt, jc, 1, dst, base);
+    jit_u8(ctxt, jc, 0x8b);
+    jit_mem(ctxt, jc, dst, base, disp);
+}
+
+/*mov [base + disp], src*/
+static void
+jit_store (OX_Context *ctxt, OX_JitCompiler *jc, int base, int32_t disp, int src)
+{
+    jit_rex(ctxt, jc, 1, src, base);
+    jit_u8(ctxt, jc, 0x89);
+    jit_mem(ctxt, jc, src, base, disp);
+}
+
+/*mov dword [base + disp], imm*/
+static void
+jit_store_i32 (OX_Context *ctxt, OX_JitCompiler *jc, int base, int32_t disp, uint32_t imm)
+{
+    jit_rex(ctxt, jc, 0, 0, base);
+    jit_u8(ctxt, jc, 0xc7);
+    jit_mem(ctxt, jc, 0, base, disp);
+    jit_u32(ctxt, jc, imm);
+}
+
+/*lea dst, [base + disp]*/
+static void
+jit_lea (OX_Context *ctxt, OX_JitCompiler *jc, int dst, int base, int32_t disp)
+{
+    jit_rex(ctxt, jc, 1, dst, base);
+    jit_u8(ctxt, jc, 0x8d);
+    jit_mem(ctxt, jc, dst, base, disp);
+}
+
+/*mov dst, imm*/
+static void
+jit_mov_i (OX_Context *ctxt, OX_JitCompiler *jc, int dst, uint64_t imm)
+{
+    if (imm <= 0xffffffff) {
+        jit_rex(ctxt, jc, 0, 0, dst);
+        jit_u8(ctxt, jc, 0xb8 | (dst & 7));
+        jit_u32(ctxt, jc, imm);
+    } else {
+        jit_rex(ctxt, jc, 1, 0, dst);
+        jit_u8(ctxt, jc, 0xb8 | (dst & 7));
+        jit_u64(ctxt, jc, imm);
+    }
+}
+
+/*sub rsp, n / add rsp, n*/
+static void
+jit_adjust_sp (OX_Context *ctxt, OX_JitCompiler *jc, int n)
+{
+    jit_u8(ctxt, jc, 0x48);
+    jit_u8(ctxt, jc, 0x83);
+    jit_u8(ctxt, jc, (n < 0) ? 0xec : 0xc4);
+    jit_u8(ctxt, jc, OX_ABS(n));
+}
+
+/*call func*/
+static void
+jit_call (OX_Context *ctxt, OX_JitCompiler *jc, OX_JitFunc func)
+{
+    jit_mov_i(ctxt, jc, X_RAX, OX_PTR2SIZE(func));
+    jit_u8(ctxt, jc, 0xff);
+    jit_u8(ctxt, jc, 0xd0);
+}
+
+/*cmp eax, imm*/
+static void
+jit_cmp_eax (OX_Context *ctxt, OX_JitCompiler *jc, int8_t imm)
+{
+    jit_u8(ctxt, jc, 0x83);
+    jit_u8(ctxt, jc, 0xf8);
+    jit_u8(ctxt, jc, imm);
+}
+
+/*Jump to the exit code on condition.*/
+static void
+jit_jcc_exit (OX_Context *ctxt, OX_JitCompiler *jc, int cc)
+{
+    jit_u8(ctxt, jc, 0x0f);
+    jit_u8(ctxt, jc, 0x80 | cc);
+    jit_u32(ctxt, jc, jc->exit - (jc->code.len + 4));
+}
+
+/*Jump to the native code of the instruction pointer.
+ *cc == -1 means jump unconditionally.*/
+static void
+jit_jump_ip (OX_Context *ctxt, OX_JitCompiler *jc, int cc, int ip)
+{
+    OX_JitFixup fix;
+
+    if (cc == -1) {
+        jit_u8(ctxt, jc, 0xe9);
+    } else {
+        jit_u8(ctxt, jc, 0x0f);
+        jit_u8(ctxt, jc, 0x80 | cc);
+    }
+
+    fix.pos = jc->code.len;
+    fix.ip = ip;
+
+    jit_u32(ctxt, jc, 0);
+
+    if ((jc->r != OX_ERR) && (ox_vector_append(ctxt, &jc->fixups, fix) == OX_ERR))
+        jc->r = OX_ERR;
+}
+
+/*Load an operand to the argument register or the stack slot.*/
+static void
+jit_arg (OX_Context *ctxt, OX_JitCompiler *jc, OX_BcScript *s, int id, char c, int v)
+{
+    int reg = (id < (int)OX_N_ELEM(jit_arg_regs)) ? jit_arg_regs[id] : X_RAX;
+
+    switch (c) {
+    case 's':
+    case 'd':
+        /*Registers are in the value stack, their addresses are
+         *the stack pointer plus the index.*/
+        jit_lea(ctxt, jc, reg, X_REGS, v * 2);
+        break;
+    case 'c':
+        jit_mov_i(ctxt, jc, reg, OX_PTR2SIZE(&s->cvs[v]));
+        break;
+    case 'p':
+        jit_mov_i(ctxt, jc, reg, OX_PTR2SIZE(&s->pps[v]));
+        break;
+    case 'C':
+        jit_mov_i(ctxt, jc, reg, OX_PTR2SIZE(&s->pcs[v]));
+        break;
+    default:
+        jit_mov_i(ctxt, jc, reg, v);
+        break;
+    }
+
+    if (reg == X_RAX)
+        jit_store(ctxt, jc, X_RSP, (id - (int)OX_N_ELEM(jit_arg_regs)) * 8, X_RAX);
+}
+
+/*Native code reaches the end of the function.*/
+static OX_Result
+jit_end (OX_Context *ctxt, OX_RunStatus *rs)
+{
+    ox_value_set_null(ctxt, rs->rv);
+    return OX_RETURN;
+}
+
+/*Generate the native code of a bytecode.*/
+static int
+jit_bytecode (OX_Context *ctxt, OX_JitCompiler *jc, OX_BcScript *s, uint8_t *bc, int ip)
+{
+    const OX_JitStencil *st = &bytecode_jit_table[bc[0]];
+    const char *c;
+    int ops[8];
+    int n = 0, off = 1, label = -1, stack_size, i;
+
+    if (!st->func)
+        return -1;
+
+    /*Decode the operands.*/
+    for (c = st->model; *c; c ++) {
+        switch (*c) {
+        case 'i':
+        case 'c':
+        case 'p':
+        case 't':
+        case 'T':
+        case 'l':
+        case 'C':
+            ops[n] = (bc[off] << 8) | bc[off + 1];
+            off += 2;
+            break;
+        default:
+            ops[n] = bc[off];
+            off += 1;
+            break;
+        }
+
+        if (*c == 'l')
+            label = ops[n];
+
+        n ++;
+    }
+
+    if (bc[0] == OX_BC_nop)
+        return off;
+
+    if (bc[0] == OX_BC_jmp) {
+        jit_jump_ip(ctxt, jc, -1, label);
+        return off;
+    }
+
+    if (st->flags & OX_JIT_FL_SAVE_IP)
+        jit_store_i32(ctxt, jc, X_FRAME, OX_OFFSET_OF(OX_Frame, ip), ip);
+
+    /*Keep the stack 16 bytes aligned.*/
+    stack_size = n + 2 - (int)OX_N_ELEM(jit_arg_regs);
+    stack_size = (stack_size > 0) ? (stack_size + 1) & ~1 : 0;
+    stack_size *= 8;
+
+    if (stack_size)
+        jit_adjust_sp(ctxt, jc, -stack_size);
+
+    for (i = 0, c = st->model; *c; c ++, i ++)
+        jit_arg(ctxt, jc, s, i + 2, *c, ops[i]);
+
+    jit_mov(ctxt, jc, X_RDI, X_CTXT);
+    jit_mov(ctxt, jc, X_RSI, X_RS);
+    jit_call(ctxt, jc, st->func);
+
+    if (stack_size)
+        jit_adjust_sp(ctxt, jc, stack_size);
+
+    if (st->flags & OX_JIT_FL_BRANCH) {
+        jit_cmp_eax(ctxt, jc, OX_JUMP);
+        jit_jump_ip(ctxt, jc, X_CC_E, label);
+    }
+
+    jit_cmp_eax(ctxt, jc, OX_OK);
+    jit_jcc_exit(ctxt, jc, X_CC_NE);
+
+    return off;
+}
+
+/*Compile the script function to native code.*/
+static OX_Result
+jit_compile (OX_Context *ctxt, OX_ScriptFunc *sf)
+{
+    OX_BcScript *s = sf->script;
+    uint8_t *bc = s->bc + sf->bc_start;
+    OX_JitCompiler jc;
+    OX_JitCode *code = NULL;
+    uint32_t *offs = NULL;
+    size_t size, i;
+    void *p;
+    int ip, len;
+
+    ox_vector_init(&jc.code);
+    ox_vector_init(&jc.fixups);
+    jc.r = OX_OK;
+
+    if (!OX_NEW_N(ctxt, offs, sf->bc_len + 1))
+        goto error;
+
+    for (ip = 0; ip <= sf->bc_len; ip ++)
+        offs[ip] = UINT32_MAX;
+
+    /*Entry: save the callee saved registers and jump to the target.*/
+    jit_push(ctxt, &jc, X_RBX);
+    jit_push(ctxt, &jc, X_R12);
+    jit_push(ctxt, &jc, X_R13);
+    jit_push(ctxt, &jc, X_R14);
+    jit_push(ctxt, &jc, X_R15);
+    jit_mov(ctxt, &jc, X_CTXT, X_RDI);
+    jit_mov(ctxt, &jc, X_RS, X_RSI);
+    jit_load(ctxt, &jc, X_REGS, X_RSI, OX_OFFSET_OF(OX_RunStatus, regs));
+    jit_load(ctxt, &jc, X_FRAME, X_RSI, OX_OFFSET_OF(OX_RunStatus, frame));
+    jit_u8(ctxt, &jc, 0xff);
+    jit_u8(ctxt, &jc, 0xe2);
+
+    /*Exit: restore the registers and return the result in eax.*/
+    jc.exit = jc.code.len;
+    jit_pop(ctxt, &jc, X_R15);
+    jit_pop(ctxt, &jc, X_R14);
+    jit_pop(ctxt, &jc, X_R13);
+    jit_pop(ctxt, &jc, X_R12);
+    jit_pop(ctxt, &jc, X_RBX);
+    jit_u8(ctxt, &jc, 0xc3);
+
+    /*Bytecodes.*/
+    for (ip = 0; ip < sf->bc_len; ip += len) {
+        offs[ip] = jc.code.len;
+
+        if ((len = jit_bytecode(ctxt, &jc, s, bc + ip, ip)) == -1)
+            goto error;
+    }
+
+    /*End of the function.*/
+    offs[sf->bc_len] = jc.code.len;
+    jit_store_i32(ctxt, &jc, X_FRAME, OX_OFFSET_OF(OX_Frame, ip), sf->bc_len);
+    jit_mov(ctxt, &jc, X_RDI, X_CTXT);
+    jit_mov(ctxt, &jc, X_RSI, X_RS);
+    jit_call(ctxt, &jc, (OX_JitFunc)jit_end);
+    jit_u8(ctxt, &jc, 0xe9);
+    jit_u32(ctxt, &jc, jc.exit - (jc.code.len + 4));
+
+    if (jc.r == OX_ERR)
+        goto error;
+
+    /*Patch the jumps.*/
+    for (i = 0; i < jc.fixups.len; i ++) {
+        OX_JitFixup *fix = &ox_vector_item(&jc.fixups, i);
+        uint32_t dst = offs[fix->ip];
+        int32_t disp;
+
+        assert(dst != UINT32_MAX);
+
+        disp = dst - (fix->pos + 4);
+        memcpy(jc.code.items + fix->pos, &disp, 4);
+    }
+
+    /*Map the native code to executable memory.*/
+    size = jc.code.len;
+    p = mmap(NULL, size, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED)
+        goto error;
+
+    memcpy(p, jc.code.items, size);
+
+    if (mprotect(p, size, PROT_READ|PROT_EXEC) == -1) {
+        munmap(p, size);
+        goto error;
+    }
+
+    if (!OX_NEW(ctxt, code)) {
+        munmap(p, size);
+        goto error;
+    }
+
+    code->code = p;
+    code->size = size;
+    code->offs = offs;
+    code->len = sf->bc_len + 1;
+
+    sf->jit = code;
+
+    ox_vector_deinit(ctxt, &jc.code);
+    ox_vector_deinit(ctxt, &jc.fixups);
+    return OX_OK;
+error:
+    if (offs)
+        OX_DEL_N(ctxt, offs, sf->bc_len + 1);
+    ox_vector_deinit(ctxt, &jc.code);
+    ox_vector_deinit(ctxt, &jc.fixups);
+    return OX_ERR;
+}
+
+/*Count the script function's hotness and compile it when it is hot.*/
+static OX_Bool
+jit_hot (OX_Context *ctxt, OX_ScriptFunc *sf)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+
+    if (++ sf->jit_cnt < OX_JIT_THRESHOLD)
+        return OX_FALSE;
+
+    if (!vm->jit)
+        return OX_FALSE;
+
+    ox_lock(ctxt);
+
+    if (!sf->jit)
+        jit_compile(ctxt, sf);
+
+    ox_unlock(ctxt);
+
+    return sf->jit ? OX_TRUE : OX_FALSE;
+}
+
+/*Check if the current function can run in native code.*/
+OX_ALWAYS_INLINE OX_Bool
+jit_ready (OX_Context *ctxt, OX_RunStatus *rs)
+{
+    OX_ScriptFunc *sf = rs->sf;
+
+    if (sf->jit)
+        return !rs->fiber;
+
+    if (sf->jit_cnt >= OX_JIT_THRESHOLD)
+        return OX_FALSE;
+
+    return jit_hot(ctxt, sf) && !rs->fiber;
+}
+
+/*Run the native code from the frame's instruction pointer.*/
+static inline OX_Result
+jit_run (OX_Context *ctxt, OX_RunStatus *rs)
+{
+    OX_JitCode *code = rs->sf->jit;
+    uint32_t off = code->offs[rs->frame->ip];
+
+    assert(off != UINT32_MAX);
+    assert(OX_VALUE_IN_STACK(rs->regs));
+
+    return ((OX_JitEntry)code->code)(ctxt, rs, code->code + off);
+}
+
+/**
+ * Free the native code of the script function.
+ * @param ctxt The current running context.
+ * @param sf The script function.
+ */
+void
+ox_jit_free (OX_Context *ctxt, OX_ScriptFunc *sf)
+{
+    OX_JitCode *code = sf->jit;
+
+    if (code) {
+        munmap(code->code, code->size);
+        OX_DEL_N(ctxt, code->offs, code->len);
+        OX_DEL(ctxt, code);
+        sf->jit = NULL;
+    }
+}
+
+#else /*!OX_JIT*/
+
+/**
+ * Free the native code of the script function.
+ * @param ctxt The current running context.
+ * @param sf The script function.
+ */
+void
+ox_jit_free (OX_Context *ctxt, OX_ScriptFunc *sf)
+{
+}
+
+#endif /*OX_JIT*/
@@ -32,6 +32,308 @@
 
 #include "ox_internal.h"
 
+#ifdef OX_MEM_SLAB
+
+/*Offset of the first buffer in the slab.*/
+#define OX_MEM_SLAB_START\
+    ((sizeof(OX_MemSlab) + OX_MEM_SLAB_STEP - 1) & ~(OX_MEM_SLAB_STEP - 1))
+
+/*Get the slab size class of the buffer.
+ *Return -1 if the buffer is not allocated from the slabs.*/
+static inline int
+mem_slab_class (size_t size)
+{
+    if (!size || (size > OX_MEM_SLAB_MAX))
+        return -1;
+
+    return (size - 1) / OX_MEM_SLAB_STEP;
+}
+
+/*Get the slab contains the buffer.*/
+static inline OX_MemSlab*
+mem_slab_get (void *ptr)
+{
+    return OX_SIZE2PTR(OX_PTR2SIZE(ptr) & ~(size_t)(OX_MEM_SLAB_SIZE - 1));
+}
+
+/*Check if the slab has no free buffer.*/
+static inline OX_Bool
+mem_slab_full (OX_MemSlab *slab, size_t size)
+{
+    return !slab->free && (slab->top + size > OX_MEM_SLAB_SIZE);
+}
+
+#ifdef OX_MEM_CHECK
+
+/*Get the position of the slab in the sorted slab table.*/
+static size_t
+mem_slab_search (OX_VM *vm, OX_MemSlab *slab)
+{
+    size_t lo = 0, hi = vm->mem_slab_num;
+
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+
+        if (vm->mem_slab_tab[mid] < slab)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
+
+/*Add the new slab to the slab table.
+ *The table is allocated from the system, so the check does not change the heap size.*/
+static void
+mem_slab_register (OX_VM *vm, OX_MemSlab *slab)
+{
+    size_t i = mem_slab_search(vm, slab);
+
+    vm->mem_slab_tab = realloc(vm->mem_slab_tab, sizeof(OX_MemSlab*) * (vm->mem_slab_num + 1));
+    assert(vm->mem_slab_tab);
+
+    memmove(vm->mem_slab_tab + i + 1, vm->mem_slab_tab + i,
+            sizeof(OX_MemSlab*) * (vm->mem_slab_num - i));
+
+    vm->mem_slab_tab[i] = slab;
+    vm->mem_slab_num ++;
+}
+
+/*Remove the slab from the slab table.*/
+static void
+mem_slab_unregister (OX_VM *vm, OX_MemSlab *slab)
+{
+    size_t i = mem_slab_search(vm, slab);
+
+    assert((i < vm->mem_slab_num) && (vm->mem_slab_tab[i] == slab));
+
+    vm->mem_slab_num --;
+
+    memmove(vm->mem_slab_tab + i, vm->mem_slab_tab + i + 1,
+            sizeof(OX_MemSlab*) * (vm->mem_slab_num - i));
+}
+
+/*Check the buffer is allocated from the slabs if and only if its size is in a slab size class.
+ *A buffer freed with a wrong size would be returned to the wrong allocator.*/
+static void
+mem_slab_check (OX_Context *ctxt, void *ptr, int cls)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+    OX_MemSlab *slab = mem_slab_get(ptr);
+    size_t i = mem_slab_search(vm, slab);
+    OX_Bool owned = (i < vm->mem_slab_num) && (vm->mem_slab_tab[i] == slab);
+
+    if (cls == -1) {
+        assert(!owned);
+    } else {
+        size_t off = (uint8_t*)ptr - (uint8_t*)slab - OX_MEM_SLAB_START;
+
+        assert(owned);
+        assert(slab->cls == cls);
+        assert(off % ((cls + 1) * OX_MEM_SLAB_STEP) == 0);
+    }
+}
+
+#endif /*OX_MEM_CHECK*/
+
+/*Map a new slab aligned to OX_MEM_SLAB_SIZE.*/
+static OX_MemSlab*
+mem_slab_map (void)
+{
+    uint8_t *p, *start, *end;
+
+    p = mmap(NULL, OX_MEM_SLAB_SIZE * 2, PROT_READ|PROT_WRITE,
+            MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED)
+        return NULL;
+
+    start = OX_SIZE2PTR((OX_PTR2SIZE(p) + OX_MEM_SLAB_SIZE - 1)
+            & ~(size_t)(OX_MEM_SLAB_SIZE - 1));
+    end = start + OX_MEM_SLAB_SIZE;
+
+    /*Unmap the unaligned parts.*/
+    if (start > p)
+        munmap(p, start - p);
+    if (p + OX_MEM_SLAB_SIZE * 2 > end)
+        munmap(end, p + OX_MEM_SLAB_SIZE * 2 - end);
+
+    return (OX_MemSlab*)start;
+}
+
+/*Allocate a buffer from the slabs.*/
+static void*
+mem_slab_alloc (OX_Context *ctxt, int cls)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+    OX_MemSlabClass *sc = &vm->mem_slabs[cls];
+    size_t size = (cls + 1) * OX_MEM_SLAB_STEP;
+    OX_MemSlab *slab;
+    void *ptr;
+
+    if (ox_list_empty(&sc->partial)) {
+        if (!(slab = mem_slab_map()))
+            return NULL;
+
+        slab->free = NULL;
+        slab->top = OX_MEM_SLAB_START;
+        slab->used = 0;
+        slab->cls = cls;
+
+#ifdef OX_MEM_CHECK
+        mem_slab_register(vm, slab);
+#endif /*OX_MEM_CHECK*/
+
+        ox_list_prepend(&sc->partial, &slab->ln);
+    } else {
+        slab = ox_list_head_c(&sc->partial, OX_MemSlab, ln);
+    }
+
+    if (slab->free) {
+        ptr = slab->free;
+        slab->free = *(void**)ptr;
+    } else {
+        ptr = ((uint8_t*)slab) + slab->top;
+        slab->top += size;
+    }
+
+    slab->used ++;
+
+    if (mem_slab_full(slab, size)) {
+        ox_list_remove(&slab->ln);
+        ox_list_append(&sc->full, &slab->ln);
+    }
+
+    return ptr;
+}
+
+/*Free a buffer allocated from the slabs.*/
+static void
+mem_slab_free (OX_Context *ctxt, int cls, void *ptr)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+    OX_MemSlabClass *sc = &vm->mem_slabs[cls];
+    size_t size = (cls + 1) * OX_MEM_SLAB_STEP;
+    OX_MemSlab *slab = mem_slab_get(ptr);
+
+    if (mem_slab_full(slab, size)) {
+        ox_list_remove(&slab->ln);
+        ox_list_prepend(&sc->partial, &slab->ln);
+    }
+
+    *(void**)ptr = slab->free;
+    slab->free = ptr;
+    slab->used --;
+
+    /*Return the empty slab to the system.
+     *The last slab of the class is kept to avoid mapping it again soon.*/
+    if (!slab->used
+            && ((sc->partial.next != &slab->ln) || (sc->partial.prev != &slab->ln))) {
+        ox_list_remove(&slab->ln);
+#ifdef OX_MEM_CHECK
+        mem_slab_unregister(vm, slab);
+#endif /*OX_MEM_CHECK*/
+        munmap(slab, OX_MEM_SLAB_SIZE);
+    }
+}
+
+/*Allocate a small buffer.
+ *The buffers freed by the context are reused first.*/
+static void*
+mem_small_alloc (OX_Context *ctxt, int cls)
+{
+    void *ptr;
+
+    if ((ptr = ctxt->mem_cache[cls])) {
+        ctxt->mem_cache[cls] = *(void**)ptr;
+        ctxt->mem_cache_num[cls] --;
+        return ptr;
+    }
+
+    return mem_slab_alloc(ctxt, cls);
+}
+
+/*Free a small buffer.
+ *The buffer is cached by the context when the cache is not full.*/
+static void
+mem_small_free (OX_Context *ctxt, int cls, void *ptr)
+{
+    if (ctxt->mem_cache_num[cls] < OX_MEM_CACHE_MAX) {
+        *(void**)ptr = ctxt->mem_cache[cls];
+        ctxt->mem_cache[cls] = ptr;
+        ctxt->mem_cache_num[cls] ++;
+        return;
+    }
+
+    mem_slab_free(ctxt, cls, ptr);
+}
+
+/*Free the buffer.*/
+static void
+mem_release (OX_Context *ctxt, void *ptr, size_t size)
+{
+    int cls;
+
+    if (!ptr)
+        return;
+
+    cls = mem_slab_class(size);
+
+#ifdef OX_MEM_CHECK
+    mem_slab_check(ctxt, ptr, cls);
+#endif /*OX_MEM_CHECK*/
+
+    if (cls == -1)
+        free(ptr);
+    else
+        mem_small_free(ctxt, cls, ptr);
+}
+
+/*Resize the buffer.
+ *The small buffers are allocated from the slabs.*/
+static void*
+mem_resize (OX_Context *ctxt, void *optr, size_t osize, size_t nsize)
+{
+    int ocls = optr ? mem_slab_class(osize) : -1;
+    int ncls = mem_slab_class(nsize);
+    void *nptr;
+
+#ifdef OX_MEM_CHECK
+    if (optr)
+        mem_slab_check(ctxt, optr, ocls);
+#endif /*OX_MEM_CHECK*/
+
+    if ((ocls == -1) && (ncls == -1))
+        return realloc(optr, nsize);
+
+    /*The buffer is in the same size class.*/
+    if (ocls == ncls)
+        return optr;
+
+    if (ncls == -1)
+        nptr = malloc(nsize);
+    else
+        nptr = mem_small_alloc(ctxt, ncls);
+
+    if (nptr && optr) {
+        memcpy(nptr, optr, OX_MIN(osize, nsize));
+        mem_release(ctxt, optr, osize);
+    }
+
+    return nptr;
+}
+
+#endif /*OX_MEM_SLAB*/
+
+/*Get the allocated memory size including the size not folded by the context.*/
+static inline size_t
+mem_size (OX_Context *ctxt)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+
+    return vm->mem_allocted + ctxt->mem_alloc - ctxt->mem_free;
+}
+
 /**
  * Resize a member buffer.
  * @param ctxt The current running context.
@@ -39,7 +341,8 @@
  * @param osize The old buffer's size.
  * @param nsize The new buffer's size.
  * @return The new buffer's pointer.
- * @retval NULL Cannot allocate the new buffer if nsize is not 0.
+ * @retval NULL Cannot allocate the new buffer if nsize is not 0,
+ * or the allocation exceeds the maximum heap size.
  */
 void*
 ox_realloc (OX_Context *ctxt, void *optr, size_t osize, size_t nsize)
@@ -48,23 +351,93 @@ ox_realloc (OX_Context *ctxt, void *optr, size_t osize, size_t nsize)
     void *nptr;
 
     if (nsize) {
+        /*The collecter's own data is not limited by the maximum heap size.*/
+        if ((nsize > osize)
+                && vm->gc_max_size
+                && !vm->gc_busy
+                && (mem_size(ctxt) + nsize - osize > vm->gc_max_size)) {
+            /*Free the unused objects and retry once.*/
+            ox_gc_reclaim(ctxt);
+
+            if (mem_size(ctxt) + nsize - osize > vm->gc_max_size) {
+                OX_LOG_D(ctxt, "allocate %"PRIdPTR"B exceeds the maximum heap size", nsize - osize);
+                return NULL;
+            }
+        }
+
+#ifdef OX_MEM_SLAB
+        nptr = mem_resize(ctxt, optr, osize, nsize);
+#else
         nptr = realloc(optr, nsize);
+#endif /*OX_MEM_SLAB*/
         if (nptr) {
-            vm->mem_allocted += nsize - osize;
-            vm->mem_max_allocated = OX_MAX(vm->mem_max_allocated, vm->mem_allocted);
+            if (nsize > osize)
+                ctxt->mem_alloc += nsize - osize;
+            else
+                ctxt->mem_free += osize - nsize;
         } else {
             OX_LOG_F(ctxt, "realloc %"PRIdPTR" -> %"PRIdPTR" failed",
                     osize, nsize);
         }
     } else {
+#ifdef OX_MEM_SLAB
+        mem_release(ctxt, optr, osize);
+#else
         free(optr);
-        vm->mem_allocted -= osize;
+#endif /*OX_MEM_SLAB*/
+        ctxt->mem_free += osize;
         nptr = NULL;
     }
 
+    /*Only the context's counters are updated in the allocation.*/
+    if (ctxt->mem_alloc + ctxt->mem_free >= OX_MEM_FLUSH_SIZE)
+        ox_mem_flush(ctxt, ctxt);
+
     return nptr;
 }
 
+/**
+ * Fold the memory size counted by a context into the virtual machine.
+ * @param ctxt The current running context.
+ * @param c The context to be flushed.
+ */
+void
+ox_mem_flush (OX_Context *ctxt, OX_Context *c)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+
+    vm->mem_alloc_total += c->mem_alloc;
+    vm->mem_free_total += c->mem_free;
+    vm->mem_allocted += c->mem_alloc - c->mem_free;
+    vm->mem_max_allocated = OX_MAX(vm->mem_max_allocated, vm->mem_allocted);
+
+    c->mem_alloc = 0;
+    c->mem_free = 0;
+}
+
+/**
+ * Return the free buffers cached by the context.
+ * @param ctxt The current running context.
+ */
+void
+ox_mem_cache_deinit (OX_Context *ctxt)
+{
+#ifdef OX_MEM_SLAB
+    int i;
+
+    for (i = 0; i < OX_MEM_SLAB_CLASS_NUM; i ++) {
+        void *ptr;
+
+        while ((ptr = ctxt->mem_cache[i])) {
+            ctxt->mem_cache[i] = *(void**)ptr;
+            mem_slab_free(ctxt, i, ptr);
+        }
+
+        ctxt->mem_cache_num[i] = 0;
+    }
+#endif /*OX_MEM_SLAB*/
+}
+
 /**
  * Initialize the memory manager data in the context.
  * @param ctxt The running context.
@@ -73,9 +446,22 @@ void
 ox_mem_init (OX_Context *ctxt)
 {
     OX_VM *vm = ox_vm_get(ctxt);
+    int i;
 
     vm->mem_allocted = 0;
     vm->mem_max_allocated = 0;
+    vm->mem_alloc_total = 0;
+    vm->mem_free_total = 0;
+
+    for (i = 0; i < OX_MEM_SLAB_CLASS_NUM; i ++) {
+        ox_list_init(&vm->mem_slabs[i].partial);
+        ox_list_init(&vm->mem_slabs[i].full);
+    }
+
+#ifdef OX_MEM_CHECK
+    vm->mem_slab_tab = NULL;
+    vm->mem_slab_num = 0;
+#endif /*OX_MEM_CHECK*/
 }
 
 /**
@@ -86,6 +472,12 @@ void
 ox_mem_deinit (OX_Context *ctxt)
 {
     OX_VM *vm = ox_vm_get(ctxt);
+#ifdef OX_MEM_SLAB
+    OX_MemSlab *slab, *nslab;
+    int i;
+#endif /*OX_MEM_SLAB*/
+
+    ox_mem_flush(ctxt, ctxt);
 
     OX_LOG_D(ctxt, "maximum allocated memory: %"PRIdPTR"B",
             vm->mem_max_allocated);
@@ -94,4 +486,22 @@ ox_mem_deinit (OX_Context *ctxt)
         OX_LOG_E(ctxt, "unfreed memory: %"PRIdPTR"B",
                 vm->mem_allocted);
     }
+
+#ifdef OX_MEM_SLAB
+    /*Return all the slabs to the system.*/
+    ox_mem_cache_deinit(ctxt);
+
+    for (i = 0; i < OX_MEM_SLAB_CLASS_NUM; i ++) {
+        ox_list_foreach_safe_c(&vm->mem_slabs[i].partial, slab, nslab, OX_MemSlab, ln) {
+            munmap(slab, OX_MEM_SLAB_SIZE);
+        }
+        ox_list_foreach_safe_c(&vm->mem_slabs[i].full, slab, nslab, OX_MemSlab, ln) {
+            munmap(slab, OX_MEM_SLAB_SIZE);
+        }
+    }
+
+#ifdef OX_MEM_CHECK
+    free(vm->mem_slab_tab);
+#endif /*OX_MEM_CHECK*/
+#endif /*OX_MEM_SLAB*/
 }
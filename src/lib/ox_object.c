@@ -44,8 +44,6 @@ typedef struct {
 static void
 prop_scan (OX_Context *ctxt, OX_Property *p)
 {
-    ox_gc_mark(ctxt, p->he.key);
-
     switch (p->type) {
     case OX_PROPERTY_CONST:
     case OX_PROPERTY_VAR:
@@ -58,11 +56,316 @@ prop_scan (OX_Context *ctxt, OX_Property *p)
     }
 }
 
-/*Free the property.*/
+/*Get the properties array's capacity of a shape mode object.*/
+static size_t
+props_cap (size_t num)
+{
+    size_t cap;
+
+    if (!num)
+        return 0;
+
+    cap = 4;
+    while (cap < num)
+        cap <<= 1;
+
+    return cap;
+}
+
+/*Decrease the reference counter of the shape.*/
+static void
+shape_unref (OX_Context *ctxt, OX_Shape *sp)
+{
+    while (sp) {
+        OX_Shape *parent;
+
+        assert(sp->ref > 0);
+
+        if (-- sp->ref)
+            break;
+
+        parent = sp->parent;
+        assert(parent);
+
+        ox_hash_remove(ctxt, &parent->t_hash, sp->he.key, NULL);
+        ox_hash_deinit(ctxt, &sp->t_hash);
+        OX_DEL_N(ctxt, sp->keys, sp->num);
+        OX_DEL(ctxt, sp);
+
+        /*The shape's address may be reused by a new shape.*/
+        ox_prop_cache_reset(ctxt);
+
+        sp = parent;
+    }
+}
+
+/*Get the child shape with a new property's key.*/
+static OX_Shape*
+shape_add (OX_Context *ctxt, OX_Shape *sp, OX_String *s)
+{
+    OX_Shape *nsp;
+
+    nsp = ox_hash_lookup_c(ctxt, &sp->t_hash, s, NULL, OX_Shape, he);
+    if (!nsp) {
+        if (!OX_NEW(ctxt, nsp)) {
+            ox_throw_no_mem_error(ctxt);
+            return NULL;
+        }
+
+        if (!OX_NEW_N(ctxt, nsp->keys, sp->num + 1)) {
+            OX_DEL(ctxt, nsp);
+            ox_throw_no_mem_error(ctxt);
+            return NULL;
+        }
+
+        if (sp->num)
+            memcpy(nsp->keys, sp->keys, sizeof(OX_String*) * sp->num);
+
+        nsp->keys[sp->num] = s;
+        nsp->num = sp->num + 1;
+        nsp->parent = sp;
+        nsp->ref = 0;
+        ox_size_hash_init(&nsp->t_hash);
+
+        /*The allocation may run the garbage collecter and remove the unused shapes
+         *from the hash table, so the position is looked up again.*/
+        if (ox_hash_insert(ctxt, &sp->t_hash, s, &nsp->he, NULL) == OX_ERR) {
+            ox_hash_remove(ctxt, &sp->t_hash, s, NULL);
+            OX_DEL_N(ctxt, nsp->keys, nsp->num);
+            OX_DEL(ctxt, nsp);
+            return NULL;
+        }
+
+        sp->ref ++;
+    }
+
+    nsp->ref ++;
+    return nsp;
+}
+
+/**
+ * Initialize the root shape of the objects.
+ * @param ctxt The running context.
+ */
+void
+ox_shape_init (OX_Context *ctxt)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+    OX_Shape *sp = &vm->root_shape;
+
+    sp->parent = NULL;
+    sp->keys = NULL;
+    sp->num = 0;
+    sp->ref = 1;
+    ox_size_hash_init(&sp->t_hash);
+}
+
+/**
+ * Release the root shape of the objects.
+ * @param ctxt The running context.
+ */
+void
+ox_shape_deinit (OX_Context *ctxt)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+    OX_Shape *sp = &vm->root_shape;
+
+    assert(sp->ref == 1);
+
+    ox_hash_deinit(ctxt, &sp->t_hash);
+}
+
+/*Free the properties dictionary.*/
 static void
-prop_free (OX_Context *ctxt, OX_Property *p)
+prop_dict_free (OX_Context *ctxt, OX_PropertyDict *dict)
+{
+    OX_PropertyEntry *pe, *npe;
+
+    ox_list_foreach_safe_c(&dict->p_list, pe, npe, OX_PropertyEntry, ln) {
+        OX_DEL(ctxt, pe);
+    }
+
+    ox_hash_deinit(ctxt, &dict->p_hash);
+
+    OX_DEL(ctxt, dict);
+}
+
+/*Switch the object to dictionary mode.*/
+static OX_Result
+object_to_dict (OX_Context *ctxt, OX_Object *op)
+{
+    OX_Shape *sp = op->shape;
+    OX_PropertyDict *dict;
+    OX_PropertyEntry *pe;
+    size_t i;
+
+    assert(sp);
+
+    if (!OX_NEW(ctxt, dict))
+        return ox_throw_no_mem_error(ctxt);
+
+    ox_list_init(&dict->p_list);
+    ox_size_hash_init(&dict->p_hash);
+
+    for (i = 0; i < sp->num; i ++) {
+        if (!OX_NEW(ctxt, pe)) {
+            prop_dict_free(ctxt, dict);
+            return ox_throw_no_mem_error(ctxt);
+        }
+
+        pe->prop = op->p.props[i];
+        ox_list_append(&dict->p_list, &pe->ln);
+
+        if (ox_hash_insert(ctxt, &dict->p_hash, sp->keys[i], &pe->he, NULL) == OX_ERR) {
+            prop_dict_free(ctxt, dict);
+            return OX_ERR;
+        }
+    }
+
+    if (op->p.props)
+        OX_DEL_N(ctxt, op->p.props, props_cap(sp->num));
+
+    op->shape = NULL;
+    op->p.dict = dict;
+
+    shape_unref(ctxt, sp);
+    return OX_OK;
+}
+
+/*Lookup the object's own property.*/
+static OX_Property*
+prop_own_lookup (OX_Context *ctxt, OX_Object *op, OX_String *s)
+{
+    if (op->shape) {
+        OX_Shape *sp = op->shape;
+        size_t i;
+
+        for (i = 0; i < sp->num; i ++) {
+            if (sp->keys[i] == s)
+                return &op->p.props[i];
+        }
+    } else {
+        OX_PropertyEntry *pe;
+
+        pe = ox_hash_lookup_c(ctxt, &op->p.dict->p_hash, s, NULL, OX_PropertyEntry, he);
+        if (pe)
+            return &pe->prop;
+    }
+
+    return NULL;
+}
+
+/*Lookup the property in the object and its interface.*/
+static OX_Property*
+prop_lookup (OX_Context *ctxt, OX_Object *op, OX_String *s, OX_Object **piop)
+{
+    OX_Property *prop;
+
+    *piop = NULL;
+
+    prop = prop_own_lookup(ctxt, op, s);
+    if (!prop && !ox_value_is_null(ctxt, &op->inf)) {
+        OX_Object *iop = ox_value_get_gco(ctxt, &op->inf);
+
+        prop = prop_own_lookup(ctxt, iop, s);
+        *piop = iop;
+    }
+
+    return prop;
+}
+
+/*Add a new property slot to the object.*/
+static OX_Property*
+prop_new (OX_Context *ctxt, OX_Object *op, OX_String *s)
+{
+    OX_PropertyEntry *pe;
+
+    /*The key and the value will be stored in the object.*/
+    ox_gc_write_barrier(ctxt, op);
+
+    if (op->shape) {
+        OX_Shape *sp = op->shape, *nsp;
+
+        if (sp->num < OX_SHAPE_PROP_MAX) {
+            size_t ocap = props_cap(sp->num);
+            size_t ncap = props_cap(sp->num + 1);
+
+            if (!(nsp = shape_add(ctxt, sp, s)))
+                return NULL;
+
+            if (ncap != ocap) {
+                OX_Property *props = OX_RENEW(ctxt, op->p.props, ocap, ncap);
+
+                if (!props) {
+                    shape_unref(ctxt, nsp);
+                    ox_throw_no_mem_error(ctxt);
+                    return NULL;
+                }
+
+                op->p.props = props;
+            }
+
+            op->shape = nsp;
+            shape_unref(ctxt, sp);
+
+            return &op->p.props[nsp->num - 1];
+        }
+
+        /*Too many properties, switch to dictionary mode.*/
+        if (object_to_dict(ctxt, op) == OX_ERR)
+            return NULL;
+    }
+
+    if (!OX_NEW(ctxt, pe)) {
+        ox_throw_no_mem_error(ctxt);
+        return NULL;
+    }
+
+    ox_list_append(&op->p.dict->p_list, &pe->ln);
+    if (ox_hash_insert(ctxt, &op->p.dict->p_hash, s, &pe->he, NULL) == OX_ERR) {
+        ox_hash_remove(ctxt, &op->p.dict->p_hash, s, NULL);
+        ox_list_remove(&pe->ln);
+        OX_DEL(ctxt, pe);
+        return NULL;
+    }
+
+    return &pe->prop;
+}
+
+/**
+ * Traverse the properties of the object in adding order.
+ * @param ctxt The current running context.
+ * @param op The object.
+ * @param func The function invoked for each property.
+ * @param data The user defined data.
+ * @retval OX_OK On success.
+ * @retval OX_ERR On error.
+ */
+OX_Result
+ox_object_foreach_prop (OX_Context *ctxt, OX_Object *op, OX_PropertyFunc func, void *data)
 {
-    OX_DEL(ctxt, p);
+    OX_Result r;
+
+    assert(ctxt && op && func);
+
+    if (op->shape) {
+        OX_Shape *sp = op->shape;
+        size_t i;
+
+        for (i = 0; i < sp->num; i ++) {
+            if ((r = func(ctxt, sp->keys[i], &op->p.props[i], data)) == OX_ERR)
+                return r;
+        }
+    } else {
+        OX_PropertyEntry *pe;
+
+        ox_list_foreach_c(&op->p.dict->p_list, pe, OX_PropertyEntry, ln) {
+            if ((r = func(ctxt, pe->he.key, &pe->prop, data)) == OX_ERR)
+                return r;
+        }
+    }
+
+    return OX_OK;
 }
 
 /**
@@ -74,8 +377,14 @@ prop_free (OX_Context *ctxt, OX_Property *p)
 void
 ox_object_init (OX_Context *ctxt, OX_Object *o, OX_Value *inf)
 {
-    ox_list_init(&o->p_list);
-    ox_size_hash_init(&o->p_hash);
+    OX_VM *vm = ox_vm_get(ctxt);
+
+    /*Not managed by GC yet.*/
+    o->gco.next_flags = 0;
+
+    o->shape = &vm->root_shape;
+    o->shape->ref ++;
+    o->p.props = NULL;
 
     o->priv_ops = NULL;
     o->priv = NULL;
@@ -94,14 +403,15 @@ ox_object_init (OX_Context *ctxt, OX_Object *o, OX_Value *inf)
 void
 ox_object_deinit (OX_Context *ctxt, OX_Object *o)
 {
-    OX_Property *p, *np;
+    if (o->shape) {
+        if (o->p.props)
+            OX_DEL_N(ctxt, o->p.props, props_cap(o->shape->num));
 
-    ox_list_foreach_safe_c(&o->p_list, p, np, OX_Property, ln) {
-        prop_free(ctxt, p);
+        shape_unref(ctxt, o->shape);
+    } else {
+        prop_dict_free(ctxt, o->p.dict);
     }
 
-    ox_hash_deinit(ctxt, &o->p_hash);
-
     if (o->priv) {
         if (o->priv_ops && o->priv_ops->free)
             o->priv_ops->free(ctxt, o->priv);
@@ -117,12 +427,24 @@ void
 ox_object_scan (OX_Context *ctxt, OX_GcObject *gco)
 {
     OX_Object *o = (OX_Object*)gco;
-    OX_Property *p;
 
     ox_gc_scan_value(ctxt, &o->inf);
 
-    ox_list_foreach_c(&o->p_list, p, OX_Property, ln) {
-        prop_scan(ctxt, p);
+    if (o->shape) {
+        OX_Shape *sp = o->shape;
+        size_t i;
+
+        for (i = 0; i < sp->num; i ++) {
+            ox_gc_mark(ctxt, sp->keys[i]);
+            prop_scan(ctxt, &o->p.props[i]);
+        }
+    } else {
+        OX_PropertyEntry *pe;
+
+        ox_list_foreach_c(&o->p.dict->p_list, pe, OX_PropertyEntry, ln) {
+            ox_gc_mark(ctxt, pe->he.key);
+            prop_scan(ctxt, &pe->prop);
+        }
     }
 
     if (o->priv) {
@@ -159,7 +481,7 @@ prop_get (OX_Context *ctxt, OX_Value *thiz, OX_Property *prop, OX_Value *v)
         r = OX_OK;
         break;
     case OX_PROPERTY_ACCESSOR:
-        r = ox_call(ctxt, &prop->p.a.get, thiz, NULL, 0, v);
+        r = ox_prop_call_get(ctxt, prop, thiz, v);
         break;
     default:
         assert(0);
@@ -192,7 +514,7 @@ ox_object_lookup (OX_Context *ctxt, OX_Value *o, OX_Value *p, OX_Value *v)
             OX_String *s = ox_value_get_gco(ctxt, p);
             OX_Property *prop;
 
-            prop = ox_hash_lookup_c(ctxt, &op->p_hash, s, NULL, OX_Property, he);
+            prop = prop_own_lookup(ctxt, op, s);
             if (prop)
                 return prop_get(ctxt, o, prop, v);
         }
@@ -240,14 +562,10 @@ ox_object_get_t (OX_Context *ctxt, OX_Value *o, OX_Value *p, OX_Value *v, OX_Val
     if (ox_value_is_string(ctxt, p)) {
         if ((r = ox_string_singleton(ctxt, p)) == OX_OK) {
             OX_String *s = ox_value_get_gco(ctxt, p);
+            OX_Object *iop;
             OX_Property *prop;
 
-            prop = ox_hash_lookup_c(ctxt, &op->p_hash, s, NULL, OX_Property, he);
-            if (!prop && !ox_value_is_null(ctxt, &op->inf)) {
-                op = ox_value_get_gco(ctxt, &op->inf);
-                prop = ox_hash_lookup_c(ctxt, &op->p_hash, s, NULL, OX_Property, he);
-            }
-
+            prop = prop_lookup(ctxt, op, s, &iop);
             if (prop) {
                 r = prop_get(ctxt, thiz, prop, v);
             } else {
@@ -284,6 +602,56 @@ access_error (OX_Context *ctxt, OX_Value *p)
             ox_string_get_char_star(ctxt, p));
 }
 
+/*Set the property's value.*/
+static OX_Result
+prop_set (OX_Context *ctxt, OX_Object *op, OX_Value *thiz, OX_Value *p, OX_Property *prop, OX_Value *v)
+{
+    OX_Result r;
+
+    switch (prop->type) {
+    case OX_PROPERTY_CONST:
+        r = access_error(ctxt, p);
+        break;
+    case OX_PROPERTY_VAR:
+        ox_gc_write_barrier(ctxt, op);
+        ox_value_copy(ctxt, &prop->p.v, v);
+        r = OX_OK;
+        break;
+    case OX_PROPERTY_ACCESSOR:
+        if (ox_value_is_null(ctxt, &prop->p.a.set)) {
+            r = access_error(ctxt, p);
+        } else {
+            /*The property's slot may be moved when the setter adds properties.*/
+            OX_VS_PUSH_2(ctxt, set, rv)
+
+            ox_value_copy(ctxt, set, &prop->p.a.set);
+            r = ox_call(ctxt, set, thiz, v, 1, rv);
+
+            OX_VS_POP(ctxt, set)
+        }
+        break;
+    default:
+        assert(0);
+    }
+
+    return r;
+}
+
+/*Add a new variable property to the object.*/
+static OX_Property*
+prop_add_var (OX_Context *ctxt, OX_Object *op, OX_String *s, OX_Value *v)
+{
+    OX_Property *prop;
+
+    if (!(prop = prop_new(ctxt, op, s)))
+        return NULL;
+
+    prop->type = OX_PROPERTY_VAR;
+    ox_value_copy(ctxt, &prop->p.v, v);
+
+    return prop;
+}
+
 /**
  * Set the property value of an object with this argument.
  * @param ctxt The current running context.
@@ -297,7 +665,6 @@ access_error (OX_Context *ctxt, OX_Value *p)
 OX_Result
 ox_object_set_t (OX_Context *ctxt, OX_Value *o, OX_Value *p, OX_Value *v, OX_Value *thiz)
 {
-    OX_VS_PUSH(ctxt, rv)
     OX_Result r;
 
     assert(ox_value_is_object(ctxt, o));
@@ -305,56 +672,224 @@ ox_object_set_t (OX_Context *ctxt, OX_Value *o, OX_Value *p, OX_Value *v, OX_Val
     if (ox_value_is_string(ctxt, p)) {
         if ((r = ox_string_singleton(ctxt, p)) == OX_OK) {
             OX_Object *op = ox_value_get_gco(ctxt, o);
-            OX_HashEntry **pe;
             OX_String *s = ox_value_get_gco(ctxt, p);
+            OX_Object *iop;
             OX_Property *prop;
 
-            prop = ox_hash_lookup_c(ctxt, &op->p_hash, s, &pe, OX_Property, he);
-            if (!prop && !ox_value_is_null(ctxt, &op->inf)) {
-                OX_Object *iop = ox_value_get_gco(ctxt, &op->inf);
-
-                prop = ox_hash_lookup_c(ctxt, &iop->p_hash, s, NULL, OX_Property, he);
-            }
-
+            prop = prop_lookup(ctxt, op, s, &iop);
             if (prop) {
-                switch (prop->type) {
-                case OX_PROPERTY_CONST:
-                    r = access_error(ctxt, p);
-                    break;
-                case OX_PROPERTY_VAR:
-                    ox_value_copy(ctxt, &prop->p.v, v);
-                    r = OX_OK;
-                    break;
-                case OX_PROPERTY_ACCESSOR:
-                    if (ox_value_is_null(ctxt, &prop->p.a.set))
-                        r = access_error(ctxt, p);
-                    else
-                        r = ox_call(ctxt, &prop->p.a.set, thiz, v, 1, rv);
-                    break;
-                default:
-                    assert(0);
-                }
+                r = prop_set(ctxt, iop ? iop : op, thiz, p, prop, v);
             } else {
-                if (!OX_NEW(ctxt, prop)) {
-                    r = ox_throw_no_mem_error(ctxt);
-                } else {
-                    prop->type = OX_PROPERTY_VAR;
-                    ox_value_copy(ctxt, &prop->p.v, v);
-                    ox_list_append(&op->p_list, &prop->ln);
-                    if ((r = ox_hash_insert(ctxt, &op->p_hash, s, &prop->he, pe)) == OX_ERR) {
-                        OX_DEL(ctxt, prop);
-                    }
-                }
+                r = prop_add_var(ctxt, op, s, v) ? OX_OK : OX_ERR;
             }
         }
     } else {
         r = ox_throw_type_error(ctxt, OX_TEXT("object's property must be a string"));
     }
 
-    OX_VS_POP(ctxt, rv)
     return r;
 }
 
+/*Add a property to the property cache.*/
+static void
+prop_cache_add (OX_Context *ctxt, OX_PropCache *pc, OX_Object *op, OX_String *s,
+        OX_Property *prop, OX_Object *iop)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+    OX_PropCacheEntry *e = pc->e;
+    OX_Object *owner = iop ? iop : op;
+    void *layout = op->shape ? (void*)op->shape : (void*)op;
+    size_t i;
+
+    /*Move the entry to the head of the cache.*/
+    for (i = 0; i < OX_PROP_CACHE_ENTRY_NUM - 1; i ++) {
+        if ((e[i].layout == layout) && (e[i].key == s))
+            break;
+    }
+
+    if (i)
+        memmove(e + 1, e, sizeof(OX_PropCacheEntry) * i);
+
+    e->ops = op->gco.ops;
+    e->layout = layout;
+    e->key = s;
+    e->inf = iop;
+    e->inf_shape = iop ? iop->shape : NULL;
+    e->prop = prop;
+    e->id = owner->shape ? prop - owner->p.props : 0;
+    e->p_num = op->shape ? 0 : op->p.dict->p_hash.e_num;
+    e->ver = vm->prop_cache_ver;
+}
+
+/**
+ * Get the property value and store the property to the cache.
+ * @param ctxt The current running context.
+ * @param o The object value.
+ * @param p The property's key.
+ * @param[out] v Return the property value.
+ * @param pc The property cache.
+ * @retval OX_OK On success.
+ * @retval OX_ERR On error.
+ */
+OX_Result
+ox_object_get_pc (OX_Context *ctxt, OX_Value *o, OX_Value *p, OX_Value *v, OX_PropCache *pc)
+{
+    const OX_ObjectOps *ops;
+    OX_Object *op;
+    OX_String *s;
+    OX_Object *iop;
+    OX_Property *prop;
+    OX_Result r;
+
+    ops = ox_value_get_object_ops(ctxt, o);
+    if (!ops || (ops->get != ox_object_get) || !ox_value_is_string(ctxt, p))
+        return ox_get(ctxt, o, p, v);
+
+    if ((r = ox_string_singleton(ctxt, p)) == OX_ERR)
+        return r;
+
+    op = ox_value_get_gco(ctxt, o);
+    s = ox_value_get_gco(ctxt, p);
+
+    prop = prop_lookup(ctxt, op, s, &iop);
+    if (!prop) {
+        ox_value_set_null(ctxt, v);
+        return OX_OK;
+    }
+
+    prop_cache_add(ctxt, pc, op, s, prop, iop);
+
+    return prop_get(ctxt, o, prop, v);
+}
+
+/**
+ * Get the property value with this argument and store the property to the cache.
+ * @param ctxt The current running context.
+ * @param o The object value.
+ * @param p The property's key.
+ * @param[out] v Return the property value.
+ * @param pc The property cache.
+ * @param thiz This argument of the accessor.
+ * @retval OX_OK On success.
+ * @retval OX_ERR On error.
+ */
+OX_Result
+ox_object_get_pc_t (OX_Context *ctxt, OX_Value *o, OX_Value *p, OX_Value *v, OX_PropCache *pc, OX_Value *thiz)
+{
+    OX_Object *op;
+    OX_String *s;
+    OX_Object *iop;
+    OX_Property *prop;
+    OX_Result r;
+
+    assert(ox_value_is_object(ctxt, o));
+
+    if (!ox_value_is_string(ctxt, p)) {
+        ox_value_set_null(ctxt, v);
+        return OX_OK;
+    }
+
+    if ((r = ox_string_singleton(ctxt, p)) == OX_ERR)
+        return r;
+
+    op = ox_value_get_gco(ctxt, o);
+    s = ox_value_get_gco(ctxt, p);
+
+    prop = prop_lookup(ctxt, op, s, &iop);
+    if (!prop) {
+        ox_value_set_null(ctxt, v);
+        return OX_OK;
+    }
+
+    prop_cache_add(ctxt, pc, op, s, prop, iop);
+
+    return prop_get(ctxt, thiz, prop, v);
+}
+
+/**
+ * Lookup the owned property and store the property to the cache.
+ * @param ctxt The current running context.
+ * @param o The object value.
+ * @param p The property's key.
+ * @param[out] v Return the property value.
+ * @param pc The property cache.
+ * @retval OX_OK On success.
+ * @retval OX_ERR On error.
+ */
+OX_Result
+ox_object_lookup_pc (OX_Context *ctxt, OX_Value *o, OX_Value *p, OX_Value *v, OX_PropCache *pc)
+{
+    const OX_ObjectOps *ops;
+    OX_Object *op;
+    OX_String *s;
+    OX_Property *prop;
+    OX_Result r;
+
+    ops = ox_value_get_object_ops(ctxt, o);
+    if (!ops || (ops->lookup != ox_object_lookup) || !ox_value_is_string(ctxt, p))
+        return ox_lookup(ctxt, o, p, v);
+
+    if ((r = ox_string_singleton(ctxt, p)) == OX_ERR)
+        return r;
+
+    op = ox_value_get_gco(ctxt, o);
+    s = ox_value_get_gco(ctxt, p);
+
+    prop = prop_own_lookup(ctxt, op, s);
+    if (!prop) {
+        ox_value_set_null(ctxt, v);
+        return OX_OK;
+    }
+
+    prop_cache_add(ctxt, pc, op, s, prop, NULL);
+
+    return prop_get(ctxt, o, prop, v);
+}
+
+/**
+ * Set the property value and store the property to the cache.
+ * @param ctxt The current running context.
+ * @param o The object value.
+ * @param p The property's key.
+ * @param v The property's new value.
+ * @param pc The property cache.
+ * @retval OX_OK On success.
+ * @retval OX_ERR On error.
+ */
+OX_Result
+ox_object_set_pc (OX_Context *ctxt, OX_Value *o, OX_Value *p, OX_Value *v, OX_PropCache *pc)
+{
+    const OX_ObjectOps *ops;
+    OX_Object *op;
+    OX_String *s;
+    OX_Object *iop;
+    OX_Property *prop;
+    OX_Result r;
+
+    ops = ox_value_get_object_ops(ctxt, o);
+    if (!ops || (ops->set != ox_object_set) || !ox_value_is_string(ctxt, p))
+        return ox_set(ctxt, o, p, v);
+
+    if ((r = ox_string_singleton(ctxt, p)) == OX_ERR)
+        return r;
+
+    op = ox_value_get_gco(ctxt, o);
+    s = ox_value_get_gco(ctxt, p);
+
+    prop = prop_lookup(ctxt, op, s, &iop);
+    if (!prop) {
+        if (!(prop = prop_add_var(ctxt, op, s, v)))
+            return OX_ERR;
+
+        prop_cache_add(ctxt, pc, op, s, prop, NULL);
+        return OX_OK;
+    }
+
+    prop_cache_add(ctxt, pc, op, s, prop, iop);
+
+    return prop_set(ctxt, iop ? iop : op, o, p, prop, v);
+}
+
 /**
  * Call the object value.
  * @param ctxt The current running context.
@@ -479,6 +1014,9 @@ ox_object_set_priv (OX_Context *ctxt, OX_Value *o, const OX_PrivateOps *ops, voi
             op->priv_ops->free(ctxt, op->priv);
     }
 
+    /*The references in the private data are not tracked by the write barrier.*/
+    ox_gc_write_barrier(ctxt, op);
+
     op->priv_ops = ops;
     op->priv = data;
     return OX_OK;
@@ -584,7 +1122,6 @@ ox_object_add_prop (OX_Context *ctxt, OX_Value *o, OX_PropertyType type,
         OX_Value *name, OX_Value *v1, OX_Value *v2)
 {
     OX_Object *op;
-    OX_HashEntry **pe;
     OX_String *s;
     OX_Property *p;
     OX_Result r;
@@ -600,20 +1137,17 @@ ox_object_add_prop (OX_Context *ctxt, OX_Value *o, OX_PropertyType type,
     op = ox_value_get_gco(ctxt, o);
 
     s = ox_value_get_gco(ctxt, name);
-    p = ox_hash_lookup_c(ctxt, &op->p_hash, s, &pe, OX_Property, he);
+    p = prop_own_lookup(ctxt, op, s);
     if (!p) {
-        if (!OX_NEW(ctxt, p))
-            return ox_throw_no_mem_error(ctxt);
-
-        if ((r = ox_hash_insert(ctxt, &op->p_hash, s, &p->he, pe)) == OX_ERR) {
-            OX_DEL(ctxt, p);
-            return r;
-        }
-        ox_list_append(&op->p_list, &p->ln);
+        if (!(p = prop_new(ctxt, op, s)))
+            return OX_ERR;
 
         need_reset = OX_TRUE;
-    } else if (type != p->type) {
-        need_reset = OX_TRUE;
+    } else {
+        ox_gc_write_barrier(ctxt, op);
+
+        if (type != p->type)
+            need_reset = OX_TRUE;
     }
 
     if (need_reset) {
@@ -803,6 +1337,53 @@ ox_object_add_n_accessor_s (OX_Context *ctxt, OX_Value *o,
     return r;
 }
 
+/**
+ * Set the intrinsic operation of the native method or accessor getter owned by the object.
+ * @param ctxt The current running context.
+ * @param o The object value.
+ * @param name The name of the property.
+ * @param id The intrinsic operation.
+ * @retval OX_OK On success.
+ * @retval OX_ERR On error.
+ */
+OX_Result
+ox_object_set_intrinsic_s (OX_Context *ctxt, OX_Value *o, const char *name, OX_Intrinsic id)
+{
+    OX_VS_PUSH(ctxt, nv)
+    OX_Object *op, *iop;
+    OX_Property *prop;
+    OX_Value *f;
+    OX_Result r;
+
+    assert(ctxt && o && name);
+    assert(ox_value_is_object(ctxt, o));
+
+    if ((r = ox_string_from_const_char_star(ctxt, nv, name)) == OX_ERR)
+        goto end;
+
+    if ((r = ox_string_singleton(ctxt, nv)) == OX_ERR)
+        goto end;
+
+    op = ox_value_get_gco(ctxt, o);
+    prop = prop_lookup(ctxt, op, ox_value_get_gco(ctxt, nv), &iop);
+    if (!prop || iop) {
+        r = ox_throw_reference_error(ctxt, OX_TEXT("property \"%s\" is not found"), name);
+        goto end;
+    }
+
+    f = (prop->type == OX_PROPERTY_ACCESSOR) ? &prop->p.a.get : &prop->p.v;
+    if (!ox_value_is_gco(ctxt, f, OX_GCO_NATIVE_FUNC)) {
+        r = ox_throw_type_error(ctxt, OX_TEXT("property \"%s\" is not a native function"), name);
+        goto end;
+    }
+
+    ox_native_func_set_intrinsic(ctxt, f, id);
+    r = OX_OK;
+end:
+    OX_VS_POP(ctxt, nv)
+    return r;
+}
+
 /*Scan referenced objects in the object iterator.*/
 static void
 object_iter_scan (OX_Context *ctxt, void *ptr)
@@ -905,8 +1486,8 @@ ox_object_del (OX_Context *ctxt, OX_Value *o, OX_Value *p)
 {
     OX_Object *op;
     OX_String *s;
-    OX_HashEntry **pe;
-    OX_Property *prop;
+    OX_HashEntry **ppe;
+    OX_PropertyEntry *pe;
     OX_Result r;
 
     op = ox_value_get_gco(ctxt, o);
@@ -915,16 +1496,61 @@ ox_object_del (OX_Context *ctxt, OX_Value *o, OX_Value *p)
         return r;
 
     s = ox_value_get_gco(ctxt, p);
-    prop = ox_hash_lookup_c(ctxt, &op->p_hash, s, &pe, OX_Property, he);
-    if (prop) {
-        ox_hash_remove(ctxt, &op->p_hash, s, pe);
-        ox_list_remove(&prop->ln);
-        prop_free(ctxt, prop);
+
+    if (op->shape) {
+        OX_Shape *sp = op->shape;
+
+        if (!prop_own_lookup(ctxt, op, s))
+            return OX_OK;
+
+        if (sp->keys[sp->num - 1] == s) {
+            /*The last added property is deleted, revert to the parent shape.*/
+            OX_Shape *psp = sp->parent;
+            size_t ocap = props_cap(sp->num);
+            size_t ncap = props_cap(psp->num);
+
+            if (ncap != ocap) {
+                OX_Property *props = OX_RENEW(ctxt, op->p.props, ocap, ncap);
+
+                if (ncap && !props)
+                    return ox_throw_no_mem_error(ctxt);
+
+                op->p.props = props;
+            }
+
+            psp->ref ++;
+            op->shape = psp;
+            shape_unref(ctxt, sp);
+            return OX_OK;
+        }
+
+        /*Switch to dictionary mode when a property in the middle is deleted.*/
+        if ((r = object_to_dict(ctxt, op)) == OX_ERR)
+            return r;
+    }
+
+    pe = ox_hash_lookup_c(ctxt, &op->p.dict->p_hash, s, &ppe, OX_PropertyEntry, he);
+    if (pe) {
+        ox_hash_remove(ctxt, &op->p.dict->p_hash, s, ppe);
+        ox_list_remove(&pe->ln);
+        OX_DEL(ctxt, pe);
+        ox_prop_cache_reset(ctxt);
     }
 
     return OX_OK;
 }
 
+/*Append the property's key to the keys array.*/
+static OX_Result
+key_append (OX_Context *ctxt, OX_Value *keys, OX_Value *key, OX_String *s)
+{
+    if (s->chars[0] == '#')
+        return OX_OK;
+
+    ox_value_set_gco(ctxt, key, s);
+    return ox_array_append(ctxt, keys, key);
+}
+
 /**
  * Get the keys of the object.
  * @param ctxt The current running context.
@@ -945,20 +1571,25 @@ ox_object_keys (OX_Context *ctxt, OX_Value *o, OX_Value *keys)
 
     if (ox_value_is_null(ctxt, keys)) {
         op = ox_value_get_gco(ctxt, o);
-        OX_Property *p;
 
         if ((r = ox_array_new(ctxt, keys, 0)) == OX_ERR)
             goto end;
 
-        ox_list_foreach_c(&op->p_list, p, OX_Property, ln) {
-            OX_String *s = p->he.key;
+        if (op->shape) {
+            OX_Shape *sp = op->shape;
+            size_t i;
 
-            if (s->chars[0] == '#')
-                continue;
+            for (i = 0; i < sp->num; i ++) {
+                if ((r = key_append(ctxt, keys, key, sp->keys[i])) == OX_ERR)
+                    goto end;
+            }
+        } else {
+            OX_PropertyEntry *pe;
 
-            ox_value_set_gco(ctxt, key, p->he.key);
-            if ((r = ox_array_append(ctxt, keys, key)) == OX_ERR)
-                goto end;
+            ox_list_foreach_c(&op->p.dict->p_list, pe, OX_PropertyEntry, ln) {
+                if ((r = key_append(ctxt, keys, key, pe->he.key)) == OX_ERR)
+                    goto end;
+            }
         }
     }
 
@@ -1284,7 +1915,9 @@ object_set_inf (OX_Context *ctxt, OX_Value *f, OX_Value *thiz, OX_Value *args, s
     }
 
     op = ox_value_get_gco(ctxt, o);
+    ox_gc_write_barrier(ctxt, op);
     ox_value_copy(ctxt, &op->inf, inf);
+    ox_prop_cache_reset(ctxt);
 
     r = OX_OK;
 end:
@@ -1475,6 +2108,7 @@ ox_object_class_init (OX_Context *ctxt)
 
     ox_not_error(ox_object_add_n_method_s(ctxt, OX_OBJECT(ctxt, Object), "entries", object_entries));
     ox_not_error(ox_object_add_n_method_s(ctxt, OX_OBJECT(ctxt, Object), "keys", object_keys));
+    ox_not_error(ox_object_set_intrinsic_s(ctxt, OX_OBJECT(ctxt, Object), "keys", OX_INTRINSIC_OBJECT_KEYS));
     ox_not_error(ox_object_add_n_method_s(ctxt, OX_OBJECT(ctxt, Object), "values", object_values));
     ox_not_error(ox_object_add_n_method_s(ctxt, OX_OBJECT(ctxt, Object), "lookup", object_lookup));
     ox_not_error(ox_object_add_n_method_s(ctxt, OX_OBJECT(ctxt, Object), "get", object_get));
@@ -384,6 +384,85 @@ is_int64_binary (OX_Context *ctxt, OX_Value *v0, OX_Value *v1, OX_CTypeKind *pk0
     return OX_FALSE;
 }
 
+/*Check if both the operands are numbers.*/
+OX_ALWAYS_INLINE OX_Bool
+is_number_binary (OX_Context *ctxt, OX_Value *v0, OX_Value *v1)
+{
+    return ox_value_is_number(ctxt, v0) && ox_value_is_number(ctxt, v1);
+}
+
+/*Check if both the operands are 32 bits integer numbers.*/
+OX_ALWAYS_INLINE OX_Bool
+is_int32_binary (OX_Context *ctxt, OX_Value *v0, OX_Value *v1)
+{
+    return ox_value_is_int32(ctxt, v0) && ox_value_is_int32(ctxt, v1);
+}
+
+/*Store the integer result of the operation on 32 bits integer numbers.*/
+OX_ALWAYS_INLINE void
+set_int_result (OX_Context *ctxt, OX_Value *d, int64_t i)
+{
+    if ((i >= INT32_MIN) && (i <= INT32_MAX))
+        ox_value_set_int32(ctxt, d, i);
+    else
+        ox_value_set_number(ctxt, d, i);
+}
+
+/*Add 2 numbers.*/
+OX_ALWAYS_INLINE void
+add_num (OX_Context *ctxt, OX_Value *s0, OX_Value *s1, OX_Value *d)
+{
+    s0 = ox_value_get_pointer(ctxt, s0);
+    s1 = ox_value_get_pointer(ctxt, s1);
+
+    if (is_int32_binary(ctxt, s0, s1))
+        set_int_result(ctxt, d, (int64_t)ox_value_get_int32(ctxt, s0) + ox_value_get_int32(ctxt, s1));
+    else
+        ox_value_set_number(ctxt, d, ox_value_get_number(ctxt, s0) + ox_value_get_number(ctxt, s1));
+}
+
+/*Substract 2 numbers.*/
+OX_ALWAYS_INLINE void
+sub_num (OX_Context *ctxt, OX_Value *s0, OX_Value *s1, OX_Value *d)
+{
+    s0 = ox_value_get_pointer(ctxt, s0);
+    s1 = ox_value_get_pointer(ctxt, s1);
+
+    if (is_int32_binary(ctxt, s0, s1))
+        set_int_result(ctxt, d, (int64_t)ox_value_get_int32(ctxt, s0) - ox_value_get_int32(ctxt, s1));
+    else
+        ox_value_set_number(ctxt, d, ox_value_get_number(ctxt, s0) - ox_value_get_number(ctxt, s1));
+}
+
+/*Multiply 2 numbers.*/
+OX_ALWAYS_INLINE void
+mul_num (OX_Context *ctxt, OX_Value *s0, OX_Value *s1, OX_Value *d)
+{
+    s0 = ox_value_get_pointer(ctxt, s0);
+    s1 = ox_value_get_pointer(ctxt, s1);
+
+    if (is_int32_binary(ctxt, s0, s1)) {
+        int32_t i0 = ox_value_get_int32(ctxt, s0);
+        int32_t i1 = ox_value_get_int32(ctxt, s1);
+        int64_t i = (int64_t)i0 * i1;
+
+        /*0 multiplied by a negative number is -0, which must be stored as double.*/
+        if (i || ((i0 >= 0) && (i1 >= 0))) {
+            set_int_result(ctxt, d, i);
+            return;
+        }
+    }
+
+    ox_value_set_number(ctxt, d, ox_value_get_number(ctxt, s0) * ox_value_get_number(ctxt, s1));
+}
+
+/*Rewrite the current bytecode with its specialized or generic version.*/
+static inline void
+bc_rewrite (OX_RunStatus *rs, OX_ByteCode bc)
+{
+    rs->s->bc[rs->sf->bc_start + rs->frame->ip] = bc;
+}
+
 /*Add.*/
 static inline OX_Result
 do_add (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value *d)
@@ -391,6 +470,12 @@ do_add (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value
     OX_Result r;
     OX_CTypeKind k0, k1;
 
+    if (is_number_binary(ctxt, s0, s1)) {
+        bc_rewrite(rs, OX_BC_add_n);
+        add_num(ctxt, s0, s1, d);
+        return OX_OK;
+    }
+
     if (ox_value_is_string(ctxt, s0) || ox_value_is_string(ctxt, s1)) {
         OX_VS_PUSH_2(ctxt, str0, str1)
 
@@ -444,6 +529,12 @@ do_sub (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value
     OX_CTypeKind k0, k1;
     OX_Result r;
 
+    if (is_number_binary(ctxt, s0, s1)) {
+        bc_rewrite(rs, OX_BC_sub_n);
+        sub_num(ctxt, s0, s1, d);
+        return OX_OK;
+    }
+
     if (is_int64_binary(ctxt, s0, s1, &k0, &k1)) {
         if ((k0 == OX_CTYPE_U64) || (k1 == OX_CTYPE_U64)) {
             uint64_t i0, i1;
@@ -521,6 +612,12 @@ do_mul (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value
     OX_CTypeKind k0, k1;
     OX_Result r;
 
+    if (is_number_binary(ctxt, s0, s1)) {
+        bc_rewrite(rs, OX_BC_mul_n);
+        mul_num(ctxt, s0, s1, d);
+        return OX_OK;
+    }
+
     if (is_int64_binary(ctxt, s0, s1, &k0, &k1)) {
         if ((k0 == OX_CTYPE_U64) || (k1 == OX_CTYPE_U64)) {
             uint64_t i0, i1;
@@ -562,6 +659,18 @@ do_div (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value
     OX_CTypeKind k0, k1;
     OX_Result r;
 
+    if (is_int32_binary(ctxt, s0, s1)) {
+        int32_t i0 = ox_value_get_int32(ctxt, s0);
+        int32_t i1 = ox_value_get_int32(ctxt, s1);
+
+        /*Exact division without overflow or -0.*/
+        if (i1 && !((i0 == INT32_MIN) && (i1 == -1)) && !(i0 % i1)
+                && (i0 || (i1 > 0))) {
+            ox_value_set_int32(ctxt, d, i0 / i1);
+            return OX_OK;
+        }
+    }
+
     if (is_int64_binary(ctxt, s0, s1, &k0, &k1)) {
         if ((k0 == OX_CTYPE_U64) || (k1 == OX_CTYPE_U64)) {
             uint64_t i0, i1;
@@ -603,6 +712,21 @@ do_mod (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value
     OX_CTypeKind k0, k1;
     OX_Result r;
 
+    if (is_int32_binary(ctxt, s0, s1)) {
+        int32_t i0 = ox_value_get_int32(ctxt, s0);
+        int32_t i1 = ox_value_get_int32(ctxt, s1);
+
+        if (i1 && !((i0 == INT32_MIN) && (i1 == -1))) {
+            int32_t i = i0 % i1;
+
+            /*Negative number modulo without remainder is -0.*/
+            if (i || (i0 >= 0)) {
+                ox_value_set_int32(ctxt, d, i);
+                return OX_OK;
+            }
+        }
+    }
+
     if (is_int64_binary(ctxt, s0, s1, &k0, &k1)) {
         if ((k0 == OX_CTYPE_U64) || (k1 == OX_CTYPE_U64)) {
             uint64_t i0, i1;
@@ -644,6 +768,11 @@ do_shl (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value
     OX_CTypeKind kind;
     OX_Result r;
 
+    if (is_int32_binary(ctxt, s0, s1) && ((uint32_t)ox_value_get_int32(ctxt, s1) < 32)) {
+        set_int_result(ctxt, d, (uint32_t)ox_value_get_int32(ctxt, s0) << (uint32_t)ox_value_get_int32(ctxt, s1));
+        return OX_OK;
+    }
+
     if ((kind = ox_value_is_int64(ctxt, s0))) {
         uint64_t i0 = ox_value_get_uint64(ctxt, s0);
         uint32_t i1;
@@ -677,6 +806,11 @@ do_shr (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value
     OX_CTypeKind kind;
     OX_Result r;
 
+    if (is_int32_binary(ctxt, s0, s1) && ((uint32_t)ox_value_get_int32(ctxt, s1) < 32)) {
+        ox_value_set_int32(ctxt, d, ox_value_get_int32(ctxt, s0) >> (uint32_t)ox_value_get_int32(ctxt, s1));
+        return OX_OK;
+    }
+
     if ((kind = ox_value_is_int64(ctxt, s0))) {
         int64_t i0 = ox_value_get_int64(ctxt, s0);
         uint32_t i1;
@@ -712,6 +846,11 @@ do_ushr (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Valu
     OX_CTypeKind kind;
     OX_Result r;
 
+    if (is_int32_binary(ctxt, s0, s1) && ((uint32_t)ox_value_get_int32(ctxt, s1) < 32)) {
+        set_int_result(ctxt, d, (uint32_t)ox_value_get_int32(ctxt, s0) >> (uint32_t)ox_value_get_int32(ctxt, s1));
+        return OX_OK;
+    }
+
     if ((kind = ox_value_is_int64(ctxt, s0))) {
         uint64_t i0 = ox_value_get_uint64(ctxt, s0);
         uint32_t i1;
@@ -740,9 +879,9 @@ do_ushr (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Valu
     return OX_OK;
 }
 
-/*Less than.*/
-static inline OX_Result
-do_lt (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value *d)
+/*Less than operation.*/
+static OX_Result
+lt_op (OX_Context *ctxt, OX_Value *s0, OX_Value *s1, OX_Value *d)
 {
     OX_CTypeKind k0, k1;
     OX_Result r;
@@ -794,9 +933,22 @@ do_lt (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value
     return OX_OK;
 }
 
-/*Greater than.*/
+/*Less than.*/
 static inline OX_Result
-do_gt (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value *d)
+do_lt (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value *d)
+{
+    if (is_number_binary(ctxt, s0, s1)) {
+        bc_rewrite(rs, OX_BC_lt_n);
+        ox_value_set_bool(ctxt, d, ox_value_get_number(ctxt, s0) < ox_value_get_number(ctxt, s1));
+        return OX_OK;
+    }
+
+    return lt_op(ctxt, s0, s1, d);
+}
+
+/*Greater than operation.*/
+static OX_Result
+gt_op (OX_Context *ctxt, OX_Value *s0, OX_Value *s1, OX_Value *d)
 {
     OX_CTypeKind k0, k1;
     OX_Result r;
@@ -848,9 +1000,22 @@ do_gt (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value
     return OX_OK;
 }
 
-/*Less than or equal to.*/
+/*Greater than.*/
 static inline OX_Result
-do_le (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value *d)
+do_gt (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value *d)
+{
+    if (is_number_binary(ctxt, s0, s1)) {
+        bc_rewrite(rs, OX_BC_gt_n);
+        ox_value_set_bool(ctxt, d, ox_value_get_number(ctxt, s0) > ox_value_get_number(ctxt, s1));
+        return OX_OK;
+    }
+
+    return gt_op(ctxt, s0, s1, d);
+}
+
+/*Less than or equal to operation.*/
+static OX_Result
+le_op (OX_Context *ctxt, OX_Value *s0, OX_Value *s1, OX_Value *d)
 {
     OX_CTypeKind k0, k1;
     OX_Result r;
@@ -902,9 +1067,22 @@ do_le (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value
     return OX_OK;
 }
 
-/*Greater than or equal to.*/
+/*Less than or equal to.*/
 static inline OX_Result
-do_ge (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value *d)
+do_le (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value *d)
+{
+    if (is_number_binary(ctxt, s0, s1)) {
+        bc_rewrite(rs, OX_BC_le_n);
+        ox_value_set_bool(ctxt, d, ox_value_get_number(ctxt, s0) <= ox_value_get_number(ctxt, s1));
+        return OX_OK;
+    }
+
+    return le_op(ctxt, s0, s1, d);
+}
+
+/*Greater than or equal to operation.*/
+static OX_Result
+ge_op (OX_Context *ctxt, OX_Value *s0, OX_Value *s1, OX_Value *d)
 {
     OX_CTypeKind k0, k1;
     OX_Result r;
@@ -956,6 +1134,19 @@ do_ge (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value
     return OX_OK;
 }
 
+/*Greater than or equal to.*/
+static inline OX_Result
+do_ge (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value *d)
+{
+    if (is_number_binary(ctxt, s0, s1)) {
+        bc_rewrite(rs, OX_BC_ge_n);
+        ox_value_set_bool(ctxt, d, ox_value_get_number(ctxt, s0) >= ox_value_get_number(ctxt, s1));
+        return OX_OK;
+    }
+
+    return ge_op(ctxt, s0, s1, d);
+}
+
 /*Instance of.*/
 static inline OX_Result
 do_instof (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value *d)
@@ -975,6 +1166,12 @@ do_eq (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value
 {
     OX_Bool b;
 
+    if (is_number_binary(ctxt, s0, s1)) {
+        bc_rewrite(rs, OX_BC_eq_n);
+        ox_value_set_bool(ctxt, d, ox_value_get_number(ctxt, s0) == ox_value_get_number(ctxt, s1));
+        return OX_OK;
+    }
+
     b = ox_equal(ctxt, s0, s1);
 
     ox_value_set_bool(ctxt, d, b);
@@ -987,6 +1184,12 @@ do_ne (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value
 {
     OX_Bool b;
 
+    if (is_number_binary(ctxt, s0, s1)) {
+        bc_rewrite(rs, OX_BC_ne_n);
+        ox_value_set_bool(ctxt, d, ox_value_get_number(ctxt, s0) != ox_value_get_number(ctxt, s1));
+        return OX_OK;
+    }
+
     b = ox_equal(ctxt, s0, s1);
 
     ox_value_set_bool(ctxt, d, !b);
@@ -1000,6 +1203,11 @@ do_and (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value
     OX_CTypeKind k0, k1;
     OX_Result r;
 
+    if (is_int32_binary(ctxt, s0, s1)) {
+        set_int_result(ctxt, d, (uint32_t)ox_value_get_int32(ctxt, s0) & (uint32_t)ox_value_get_int32(ctxt, s1));
+        return OX_OK;
+    }
+
     if (is_int64_binary(ctxt, s0, s1, &k0, &k1)) {
         if ((k0 == OX_CTYPE_U64) || (k1 == OX_CTYPE_U64)) {
             uint64_t i0, i1;
@@ -1041,6 +1249,11 @@ do_xor (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value
     OX_CTypeKind k0, k1;
     OX_Result r;
 
+    if (is_int32_binary(ctxt, s0, s1)) {
+        set_int_result(ctxt, d, (uint32_t)ox_value_get_int32(ctxt, s0) ^ (uint32_t)ox_value_get_int32(ctxt, s1));
+        return OX_OK;
+    }
+
     if (is_int64_binary(ctxt, s0, s1, &k0, &k1)) {
         if ((k0 == OX_CTYPE_U64) || (k1 == OX_CTYPE_U64)) {
             uint64_t i0, i1;
@@ -1082,6 +1295,11 @@ do_or (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value
     OX_CTypeKind k0, k1;
     OX_Result r;
 
+    if (is_int32_binary(ctxt, s0, s1)) {
+        set_int_result(ctxt, d, (uint32_t)ox_value_get_int32(ctxt, s0) | (uint32_t)ox_value_get_int32(ctxt, s1));
+        return OX_OK;
+    }
+
     if (is_int64_binary(ctxt, s0, s1, &k0, &k1)) {
         if ((k0 == OX_CTYPE_U64) || (k1 == OX_CTYPE_U64)) {
             uint64_t i0, i1;
@@ -1117,6 +1335,123 @@ do_or (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value
     return OX_OK;
 }
 
+/*Add numbers.*/
+static inline OX_Result
+do_add_n (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value *d)
+{
+    if (is_number_binary(ctxt, s0, s1)) {
+        add_num(ctxt, s0, s1, d);
+        return OX_OK;
+    }
+
+    bc_rewrite(rs, OX_BC_add);
+    return do_add(ctxt, rs, s0, s1, d);
+}
+
+/*Substract numbers.*/
+static inline OX_Result
+do_sub_n (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value *d)
+{
+    if (is_number_binary(ctxt, s0, s1)) {
+        sub_num(ctxt, s0, s1, d);
+        return OX_OK;
+    }
+
+    bc_rewrite(rs, OX_BC_sub);
+    return do_sub(ctxt, rs, s0, s1, d);
+}
+
+/*Multiply numbers.*/
+static inline OX_Result
+do_mul_n (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value *d)
+{
+    if (is_number_binary(ctxt, s0, s1)) {
+        mul_num(ctxt, s0, s1, d);
+        return OX_OK;
+    }
+
+    bc_rewrite(rs, OX_BC_mul);
+    return do_mul(ctxt, rs, s0, s1, d);
+}
+
+/*Less than numbers.*/
+static inline OX_Result
+do_lt_n (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value *d)
+{
+    if (is_number_binary(ctxt, s0, s1)) {
+        ox_value_set_bool(ctxt, d, ox_value_get_number(ctxt, s0) < ox_value_get_number(ctxt, s1));
+        return OX_OK;
+    }
+
+    bc_rewrite(rs, OX_BC_lt);
+    return lt_op(ctxt, s0, s1, d);
+}
+
+/*Greater than numbers.*/
+static inline OX_Result
+do_gt_n (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value *d)
+{
+    if (is_number_binary(ctxt, s0, s1)) {
+        ox_value_set_bool(ctxt, d, ox_value_get_number(ctxt, s0) > ox_value_get_number(ctxt, s1));
+        return OX_OK;
+    }
+
+    bc_rewrite(rs, OX_BC_gt);
+    return gt_op(ctxt, s0, s1, d);
+}
+
+/*Less than or equal to numbers.*/
+static inline OX_Result
+do_le_n (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value *d)
+{
+    if (is_number_binary(ctxt, s0, s1)) {
+        ox_value_set_bool(ctxt, d, ox_value_get_number(ctxt, s0) <= ox_value_get_number(ctxt, s1));
+        return OX_OK;
+    }
+
+    bc_rewrite(rs, OX_BC_le);
+    return le_op(ctxt, s0, s1, d);
+}
+
+/*Greater than or equal to numbers.*/
+static inline OX_Result
+do_ge_n (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value *d)
+{
+    if (is_number_binary(ctxt, s0, s1)) {
+        ox_value_set_bool(ctxt, d, ox_value_get_number(ctxt, s0) >= ox_value_get_number(ctxt, s1));
+        return OX_OK;
+    }
+
+    bc_rewrite(rs, OX_BC_ge);
+    return ge_op(ctxt, s0, s1, d);
+}
+
+/*Equal to numbers.*/
+static inline OX_Result
+do_eq_n (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value *d)
+{
+    if (is_number_binary(ctxt, s0, s1)) {
+        ox_value_set_bool(ctxt, d, ox_value_get_number(ctxt, s0) == ox_value_get_number(ctxt, s1));
+        return OX_OK;
+    }
+
+    bc_rewrite(rs, OX_BC_eq);
+    return do_eq(ctxt, rs, s0, s1, d);
+}
+
+/*Not equal to numbers.*/
+static inline OX_Result
+do_ne_n (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value *d)
+{
+    if (is_number_binary(ctxt, s0, s1)) {
+        ox_value_set_bool(ctxt, d, ox_value_get_number(ctxt, s0) != ox_value_get_number(ctxt, s1));
+        return OX_OK;
+    }
+
+    bc_rewrite(rs, OX_BC_ne);
+    return do_ne(ctxt, rs, s0, s1, d);
+}
+
 /*Load null.*/
 static inline OX_Result
 do_load_null (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *d)
@@ -1327,9 +1662,119 @@ do_set_t_b_ac (OX_Context *ctxt, OX_RunStatus *rs, int off, int id, OX_Value *s)
     return OX_OK;
 }
 
+/*Store the local declaration captured by reference to a cell.*/
+static inline OX_Result
+do_cell_t (OX_Context *ctxt, OX_RunStatus *rs, int id)
+{
+    OX_Frame *f = ctxt->frames;
+
+    return ox_cell_new(ctxt, &f->v[id], &f->v[id]);
+}
+
+/*Get local declaration stored in a cell.*/
+static inline OX_Result
+do_get_t_c (OX_Context *ctxt, OX_RunStatus *rs, int id, OX_Value *d)
+{
+    OX_Frame *f = ctxt->frames;
+
+    ox_value_copy(ctxt, d, ox_cell_value(ctxt, &f->v[id]));
+    return OX_OK;
+}
+
+/*Set local declaration stored in a cell.*/
+static inline OX_Result
+do_set_t_c (OX_Context *ctxt, OX_RunStatus *rs, int id, OX_Value *s)
+{
+    OX_Frame *f = ctxt->frames;
+
+    ox_cell_set(ctxt, &f->v[id], s);
+    return OX_OK;
+}
+
+/*Set local auto closed declaration stored in a cell.*/
+static inline OX_Result
+do_set_t_c_ac (OX_Context *ctxt, OX_RunStatus *rs, int id, OX_Value *s)
+{
+    OX_Frame *f = ctxt->frames;
+    OX_Value *v = ox_cell_value(ctxt, &f->v[id]);
+    OX_Result r;
+
+    if (!ox_equal(ctxt, v, s)) {
+        if ((r = auto_close(ctxt, v)) == OX_ERR)
+            return r;
+
+        ox_cell_set(ctxt, &f->v[id], s);
+    }
+
+    return OX_OK;
+}
+
+/*Get the captured value.*/
+static inline OX_Result
+do_get_cap (OX_Context *ctxt, OX_RunStatus *rs, int id, OX_Value *d)
+{
+    ox_value_copy(ctxt, d, ox_cell_value(ctxt, &rs->f->caps[id]));
+    return OX_OK;
+}
+
+/*Set the captured value.*/
+static inline OX_Result
+do_set_cap (OX_Context *ctxt, OX_RunStatus *rs, int id, OX_Value *s)
+{
+    ox_cell_set(ctxt, &rs->f->caps[id], s);
+
+    /*The value captured by "eval" from the running frame may not be stored in a cell.*/
+    ox_gc_write_barrier(ctxt, rs->f);
+    return OX_OK;
+}
+
+/*Set the captured auto closed value.*/
+static inline OX_Result
+do_set_cap_ac (OX_Context *ctxt, OX_RunStatus *rs, int id, OX_Value *s)
+{
+    OX_Value *v = ox_cell_value(ctxt, &rs->f->caps[id]);
+    OX_Result r;
+
+    if (!ox_equal(ctxt, v, s)) {
+        if ((r = auto_close(ctxt, v)) == OX_ERR)
+            return r;
+
+        ox_cell_set(ctxt, &rs->f->caps[id], s);
+        ox_gc_write_barrier(ctxt, rs->f);
+    }
+
+    return OX_OK;
+}
+
+/*Get global declaration.*/
+static inline OX_Result
+do_get_g (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *c, OX_Value *d, OX_PropCache *pc)
+{
+    OX_Value *g = OX_OBJECT(ctxt, Global);
+    OX_Property *prop = ox_prop_cache_lookup(ctxt, pc, g, c);
+    OX_Result r;
+
+    if (prop) {
+        if (prop->type == OX_PROPERTY_ACCESSOR)
+            return ox_prop_call_get(ctxt, prop, g, d);
+
+        ox_value_copy(ctxt, d, &prop->p.v);
+        return OX_OK;
+    }
+
+    if ((r = ox_object_get_pc(ctxt, g, c, d, pc)) == OX_ERR)
+        return r;
+
+    /*Throw an error if the global declaration does not exist.*/
+    if (ox_value_is_null(ctxt, d))
+        r = ox_get_throw(ctxt, g, c, d);
+
+    return r;
+}
+
 /*Get declaration by name.*/
 static inline OX_Result
-do_get_n (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *c, OX_Value *d)
+do_get_n (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *c, OX_Value *d, OX_PropCache *pc)
 {
     OX_String *k;
     OX_ScriptFunc *sf = rs->s->sfuncs;
@@ -1346,28 +1791,24 @@ do_get_n (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *c, OX_Value *d)
 
     sdecl = ox_hash_lookup_c(ctxt, &sf->decl_hash, k, NULL, OX_ScriptDecl, he);
     if (sdecl) {
+        /*"get_r" is shorter than "get_n", fill the rest with "nop".*/
         bc[0] = OX_BC_get_r;
         bc[1] = sdecl->id >> 8;
         bc[2] = sdecl->id & 0xff;
+        bc[4] = OX_BC_nop;
+        bc[5] = OX_BC_nop;
 
         ox_value_copy(ctxt, d, &rs->s->script.frame->v[sdecl->id]);
         r = OX_OK;
     } else {
         bc[0] = OX_BC_get_g;
 
-        r = ox_get_throw(ctxt, OX_OBJECT(ctxt, Global), c, d);
+        r = do_get_g(ctxt, rs, c, d, pc);
     }
 
     return r;
 }
 
-/*Get global declaration.*/
-static inline OX_Result
-do_get_g (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *c, OX_Value *d)
-{
-    return ox_get_throw(ctxt, OX_OBJECT(ctxt, Global), c, d);
-}
-
 /*Get referenced declaration.*/
 static inline OX_Result
 do_get_r (OX_Context *ctxt, OX_RunStatus *rs, int id, OX_Value *d)
@@ -1376,25 +1817,144 @@ do_get_r (OX_Context *ctxt, OX_RunStatus *rs, int id, OX_Value *d)
     return OX_OK;
 }
 
+/*Run the intrinsic operation of the native function.
+ *Return OX_FALSE if the operation cannot be run inline,
+ *then the native function should be called.*/
+static inline OX_Result
+intrinsic_call (OX_Context *ctxt, OX_Value *f, OX_Value *thiz, OX_Value **argv, size_t argc, OX_Value *rv)
+{
+    OX_NativeFunc *nf;
+
+    if (!ox_value_is_gco(ctxt, f, OX_GCO_NATIVE_FUNC))
+        return OX_FALSE;
+
+    nf = ox_value_get_gco(ctxt, f);
+
+    switch (nf->intrinsic) {
+    case OX_INTRINSIC_NONE:
+        break;
+    case OX_INTRINSIC_MATH_SQRT:
+        if (argc && ox_value_is_number(ctxt, argv[0])) {
+            ox_value_set_number(ctxt, rv, sqrt(ox_value_get_number(ctxt, argv[0])));
+            return OX_OK;
+        }
+        break;
+    case OX_INTRINSIC_MATH_FLOOR:
+        if (argc && ox_value_is_number(ctxt, argv[0])) {
+            ox_value_set_number(ctxt, rv, floor(ox_value_get_number(ctxt, argv[0])));
+            return OX_OK;
+        }
+        break;
+    case OX_INTRINSIC_ARRAY_LENGTH:
+        if (ox_value_is_array(ctxt, thiz)) {
+            ox_value_set_number(ctxt, rv, ox_array_length(ctxt, thiz));
+            return OX_OK;
+        }
+        break;
+    case OX_INTRINSIC_ARRAY_PUSH:
+        if (ox_value_is_array(ctxt, thiz)) {
+            size_t i;
+            OX_Result r;
+
+            for (i = 0; i < argc; i ++) {
+                if ((r = ox_array_append(ctxt, thiz, argv[i])) == OX_ERR)
+                    return r;
+            }
+
+            ox_value_set_null(ctxt, rv);
+            return OX_OK;
+        }
+        break;
+    case OX_INTRINSIC_STRING_LENGTH:
+        if (ox_value_is_string(ctxt, thiz)) {
+            ox_value_set_number(ctxt, rv, ox_string_length(ctxt, thiz));
+            return OX_OK;
+        }
+        break;
+    case OX_INTRINSIC_OBJECT_KEYS:
+        /*The iterator references the object, so it cannot overwrite the argument.*/
+        if (argc && ox_value_is_object(ctxt, argv[0]) && (rv != argv[0]))
+            return ox_object_iter_new(ctxt, rv, argv[0], OX_OBJECT_ITER_KEY);
+        break;
+    }
+
+    return OX_FALSE;
+}
+
+/*Call the accessor's getter.*/
+static inline OX_Result
+prop_call_get (OX_Context *ctxt, OX_Property *prop, OX_Value *thiz, OX_Value *d)
+{
+    OX_Result r;
+
+    if ((r = intrinsic_call(ctxt, &prop->p.a.get, thiz, NULL, 0, d)) != OX_FALSE)
+        return r;
+
+    return ox_prop_call_get(ctxt, prop, thiz, d);
+}
+
 /*Get property.*/
 static inline OX_Result
-do_get_p (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value *d)
+do_get_p (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value *d, OX_PropCache *pc)
 {
-    return ox_get(ctxt, s0, s1, d);
+    OX_Property *prop;
+
+    /*String's properties are looked up in its interface.*/
+    if (ox_value_is_string(ctxt, s0) && ox_value_is_string(ctxt, s1)) {
+        OX_Value *inf = OX_OBJECT(ctxt, String_inf);
+
+        prop = ox_prop_cache_lookup(ctxt, pc, inf, s1);
+        if (!prop)
+            return ox_object_get_pc_t(ctxt, inf, s1, d, pc, s0);
+    } else {
+        prop = ox_prop_cache_lookup(ctxt, pc, s0, s1);
+        if (!prop)
+            return ox_object_get_pc(ctxt, s0, s1, d, pc);
+    }
+
+    if (prop->type == OX_PROPERTY_ACCESSOR)
+        return prop_call_get(ctxt, prop, s0, d);
+
+    ox_value_copy(ctxt, d, &prop->p.v);
+    return OX_OK;
 }
 
 /*Lookup property.*/
 static inline OX_Result
-do_lookup_p (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value *d)
+do_lookup_p (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value *d, OX_PropCache *pc)
 {
-    return ox_lookup(ctxt, s0, s1, d);
+    OX_Property *prop = ox_prop_cache_lookup(ctxt, pc, s0, s1);
+
+    if (prop) {
+        if (prop->type == OX_PROPERTY_ACCESSOR)
+            return ox_prop_call_get(ctxt, prop, s0, d);
+
+        ox_value_copy(ctxt, d, &prop->p.v);
+        return OX_OK;
+    }
+
+    return ox_object_lookup_pc(ctxt, s0, s1, d, pc);
 }
 
 /*Set property.*/
 static inline OX_Result
-do_set_p (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value *s2)
+do_set_p (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value *s2, OX_PropCache *pc)
 {
-    return ox_set(ctxt, s0, s1, s2);
+    OX_Property *prop = ox_prop_cache_lookup(ctxt, pc, s0, s1);
+
+    if (prop && (prop->type == OX_PROPERTY_VAR)) {
+        OX_Object *op = ox_value_get_gco(ctxt, s0);
+
+        /*The property may be owned by the object or its interface.*/
+        ox_gc_write_barrier(ctxt, op);
+        if (ox_value_get_tag(&op->inf) == OX_VALUE_TAG_GCO)
+            ox_gc_write_barrier(ctxt, ox_value_pointer_get_gco(&op->inf));
+
+        ox_value_copy(ctxt, &prop->p.v, s2);
+        return OX_OK;
+    }
+
+    return ox_object_set_pc(ctxt, s0, s1, s2, pc);
 }
 
 /*Get an argument.*/
@@ -1673,6 +2233,45 @@ end:
     return r;
 }
 
+/*Enter the script function and run it in the current dispatch loop.
+ *ap is the value stack pointer of the arguments copied by the direct call,
+ *or -1 if the function is called by "call_end".*/
+static inline void
+enter_func (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *f, OX_Value *thiz, OX_Value *args, size_t argc, OX_Value *rv, size_t ap)
+{
+    OX_Stack *ret;
+    OX_Frame *frame;
+    OX_Function *func;
+
+    ret = ox_stack_push(ctxt, OX_STACK_RETURN);
+
+    ret->s.r.frame = ctxt->frames;
+    ret->s.r.args = rs->args;
+    ret->s.r.argc = rs->argc;
+    ret->s.r.rv = rs->rv;
+    ret->s.r.vp = OX_VALUE_PTR2IDX(rs->regs);
+    ret->s.r.sp = rs->sp;
+    ret->s.r.ap = ap;
+
+    func = ox_value_get_gco(ctxt, f);
+    frame = ox_frame_push(ctxt, f, func->sfunc->decl_hash.e_num);
+
+    rs->f = func;
+    rs->thiz = thiz;
+    rs->args = args;
+    rs->argc = argc;
+    rs->rv = rv;
+    rs->frame = frame;
+    rs->frame->ip = 0;
+    rs->sf = rs->f->sfunc;
+    rs->s = rs->sf->script;
+    rs->regs = ox_value_stack_push_n(ctxt, rs->sf->reg_num + 1);
+    rs->argv = ox_values_item(ctxt, rs->regs, rs->sf->reg_num);
+    rs->sp = ctxt->s_stack->len;
+
+    ox_value_copy(ctxt, &rs->frame->thiz, thiz);
+}
+
 /*Call a function.*/
 static inline OX_Result
 call_func (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *f, OX_Value *thiz, OX_Value *args, size_t argc, OX_Value *rv)
@@ -1680,39 +2279,7 @@ call_func (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *f, OX_Value *thiz, OX_V
     OX_Result r;
 
     if (ox_value_is_gco(ctxt, f, OX_GCO_FUNCTION)) {
-        OX_Stack *ret;
-        OX_Frame *frame;
-        OX_Function *func;
-
-        ret = ox_stack_push(ctxt, OX_STACK_RETURN);
-
-        run_status_to_rec(ctxt, rs, &ret->s.r);
-
-        ret->s.r.frame = ctxt->frames;
-        ret->s.r.args = rs->args;
-        ret->s.r.argc = rs->argc;
-        ret->s.r.rv = rs->rv;
-        ret->s.r.vp = OX_VALUE_PTR2IDX(rs->regs);
-        ret->s.r.sp = rs->sp;
-
-        func = ox_value_get_gco(ctxt, f);
-        frame = ox_frame_push(ctxt, f, func->sfunc->decl_hash.e_num);
-
-        rs->f = ox_value_get_gco(ctxt, f);
-        rs->thiz = thiz;
-        rs->args = args;
-        rs->argc = argc;
-        rs->rv = rv;
-        rs->frame = frame;
-        rs->frame->ip = 0;
-        rs->sf = rs->f->sfunc;
-        rs->s = rs->sf->script;
-        rs->regs = ox_value_stack_push_n(ctxt, rs->sf->reg_num + 1);
-        rs->argv = ox_values_item(ctxt, rs->regs, rs->sf->reg_num);
-        rs->sp = ctxt->s_stack->len;
-
-        ox_value_copy(ctxt, &rs->frame->thiz, thiz);
-
+        enter_func(ctxt, rs, f, thiz, args, argc, rv, -1);
         return OX_JUMP;
     } else {
         if ((r = ox_call(ctxt, f, thiz, args, argc, rv)) == OX_ERR)
@@ -1725,6 +2292,35 @@ call_func (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *f, OX_Value *thiz, OX_V
     }
 }
 
+/*Call a function with fixed number of arguments in registers.
+ *No call entry is pushed. The arguments are copied to the value stack
+ *just below the callee's registers.*/
+static inline OX_Result
+call_direct (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *f, OX_Value *thiz, OX_Value **argv, size_t argc, OX_Value *rv)
+{
+    OX_Value *args;
+    size_t i;
+    OX_Result r;
+
+    if ((r = intrinsic_call(ctxt, f, thiz, argv, argc, rv)) != OX_FALSE)
+        return r;
+
+    args = ox_value_stack_push_n(ctxt, argc);
+
+    for (i = 0; i < argc; i ++)
+        ox_value_copy(ctxt, ox_values_item(ctxt, args, i), argv[i]);
+
+    if (ox_value_is_gco(ctxt, f, OX_GCO_FUNCTION)) {
+        enter_func(ctxt, rs, f, thiz, args, argc, rv, OX_VALUE_PTR2IDX(args));
+        return OX_JUMP;
+    }
+
+    r = ox_call(ctxt, f, thiz, args, argc, rv);
+
+    ox_value_stack_pop(ctxt, args);
+    return r;
+}
+
 /*Call end.*/
 static inline OX_Result
 do_call_end (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *d)
@@ -1772,30 +2368,16 @@ do_call_end_tail (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *d)
     return call_func(ctxt, rs, se->s.c.f, se->s.c.thiz, se->s.c.args, se->s.c.argc, d);
 }
 
-/*Try start.*/
+/*Try end.*/
 static inline OX_Result
-do_try_start (OX_Context *ctxt, OX_RunStatus *rs, int l0, int l1)
+do_try_end (OX_Context *ctxt, OX_RunStatus *rs, int l)
 {
     OX_Stack *se = ox_stack_push(ctxt, OX_STACK_TRY);
 
-    se->s.t.state = OX_TRY_STATE_TRY;
     se->s.t.r = OX_OK;
-    se->s.t.catch_label = l0;
-    se->s.t.finally_label = l1;
     se->s.t.jmp_ip = 0;
     se->s.t.jmp_sp = 0;
-
-    return OX_OK;
-}
-
-/*Try end.*/
-static inline OX_Result
-do_try_end (OX_Context *ctxt, OX_RunStatus *rs)
-{
-    OX_Stack *se = ox_stack_top(ctxt);
-
-    se->s.t.state = OX_TRY_STATE_FINALLY;
-    rs->frame->ip = se->s.t.finally_label;
+    rs->frame->ip = l;
 
     return OX_JUMP;
 }
@@ -1812,17 +2394,6 @@ do_catch (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *d)
     return OX_OK;
 }
 
-/*Catch end.*/
-static inline OX_Result
-do_catch_end (OX_Context *ctxt, OX_RunStatus *rs)
-{
-    OX_Stack *se = ox_stack_top(ctxt);
-
-    se->s.t.state = OX_TRY_STATE_FINALLY;
-
-    return OX_OK;
-}
-
 /*Finally.*/
 static inline OX_Result
 do_finally (OX_Context *ctxt, OX_RunStatus *rs)
@@ -1884,10 +2455,23 @@ do_s_pop (OX_Context *ctxt, OX_RunStatus *rs)
 static inline OX_Result
 do_iter_start (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s)
 {
-    OX_Stack *se = ox_stack_push(ctxt, OX_STACK_ITER);
+    OX_IterStepFunc step;
+    OX_Stack *se;
     OX_Result r;
 
+    if ((r = ox_iterator_step_get(ctxt, s, &step)) == OX_ERR)
+        return r;
+
+    se = ox_stack_push(ctxt, OX_STACK_ITER);
     se->s.i.iter = ox_value_stack_push(ctxt);
+    se->s.i.step = step;
+    se->s.i.pos = 0;
+
+    /*Builtin containers are iterated without iterator object.*/
+    if (step) {
+        ox_value_copy(ctxt, se->s.i.iter, s);
+        return OX_OK;
+    }
 
     if ((r = ox_iterator_new(ctxt, se->s.i.iter, s)) == OX_ERR) {
         ctxt->s_stack->len --;
@@ -1904,6 +2488,20 @@ do_iter_step (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *d, int l)
     OX_Stack *se = ox_stack_top(ctxt);
     OX_Result r;
 
+    if (se->s.i.step) {
+        if ((r = se->s.i.step(ctxt, se->s.i.iter, &se->s.i.pos, d)) == OX_ERR)
+            return r;
+
+        if (r)
+            return OX_OK;
+
+        if ((r = ox_stack_pop(ctxt)) == OX_ERR)
+            return r;
+
+        rs->frame->ip = l;
+        return OX_JUMP;
+    }
+
     if ((r = ox_iterator_end(ctxt, se->s.i.iter)) == OX_ERR)
         return r;
 
@@ -2694,6 +3292,215 @@ do_pprop_nn (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *p, OX_Value *s)
 }
 
 
+/*Get local declaration and check if it is not null.*/
+static inline OX_Result
+do_get_t_nn (OX_Context *ctxt, OX_RunStatus *rs, int id, OX_Value *c, OX_Value *d)
+{
+    do_get_t(ctxt, rs, id, d);
+
+    return do_name_nn(ctxt, rs, c, d);
+}
+
+/*Get property with a constant key.*/
+static inline OX_Result
+do_get_p_c (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s, OX_Value *c, OX_Value *d, OX_PropCache *pc)
+{
+    return do_get_p(ctxt, rs, s, c, d, pc);
+}
+
+/*Jump if the compare result is false.*/
+static inline OX_Result
+cmp_jf (OX_Context *ctxt, OX_RunStatus *rs, OX_ByteCode bc, OX_Value *s0, OX_Value *s1, int l)
+{
+    OX_VS_PUSH(ctxt, v)
+    OX_Result r;
+
+    switch (bc) {
+    case OX_BC_lt:
+        r = lt_op(ctxt, s0, s1, v);
+        break;
+    case OX_BC_gt:
+        r = gt_op(ctxt, s0, s1, v);
+        break;
+    case OX_BC_le:
+        r = le_op(ctxt, s0, s1, v);
+        break;
+    case OX_BC_ge:
+        r = ge_op(ctxt, s0, s1, v);
+        break;
+    case OX_BC_eq:
+        ox_value_set_bool(ctxt, v, ox_equal(ctxt, s0, s1));
+        r = OX_OK;
+        break;
+    default:
+        ox_value_set_bool(ctxt, v, !ox_equal(ctxt, s0, s1));
+        r = OX_OK;
+        break;
+    }
+
+    if (r == OX_OK)
+        r = do_jf(ctxt, rs, v, l);
+
+    OX_VS_POP(ctxt, v)
+    return r;
+}
+
+/*Jump if not less than.*/
+static inline OX_Result
+do_lt_jf (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, int l)
+{
+    if (is_number_binary(ctxt, s0, s1)) {
+        if (ox_value_get_number(ctxt, s0) < ox_value_get_number(ctxt, s1))
+            return OX_OK;
+
+        rs->frame->ip = l;
+        return OX_JUMP;
+    }
+
+    return cmp_jf(ctxt, rs, OX_BC_lt, s0, s1, l);
+}
+
+/*Jump if not greater than.*/
+static inline OX_Result
+do_gt_jf (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, int l)
+{
+    if (is_number_binary(ctxt, s0, s1)) {
+        if (ox_value_get_number(ctxt, s0) > ox_value_get_number(ctxt, s1))
+            return OX_OK;
+
+        rs->frame->ip = l;
+        return OX_JUMP;
+    }
+
+    return cmp_jf(ctxt, rs, OX_BC_gt, s0, s1, l);
+}
+
+/*Jump if not less than or equal to.*/
+static inline OX_Result
+do_le_jf (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, int l)
+{
+    if (is_number_binary(ctxt, s0, s1)) {
+        if (ox_value_get_number(ctxt, s0) <= ox_value_get_number(ctxt, s1))
+            return OX_OK;
+
+        rs->frame->ip = l;
+        return OX_JUMP;
+    }
+
+    return cmp_jf(ctxt, rs, OX_BC_le, s0, s1, l);
+}
+
+/*Jump if not greater than or equal to.*/
+static inline OX_Result
+do_ge_jf (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, int l)
+{
+    if (is_number_binary(ctxt, s0, s1)) {
+        if (ox_value_get_number(ctxt, s0) >= ox_value_get_number(ctxt, s1))
+            return OX_OK;
+
+        rs->frame->ip = l;
+        return OX_JUMP;
+    }
+
+    return cmp_jf(ctxt, rs, OX_BC_ge, s0, s1, l);
+}
+
+/*Jump if not equal to.*/
+static inline OX_Result
+do_eq_jf (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, int l)
+{
+    if (is_number_binary(ctxt, s0, s1)) {
+        if (ox_value_get_number(ctxt, s0) == ox_value_get_number(ctxt, s1))
+            return OX_OK;
+
+        rs->frame->ip = l;
+        return OX_JUMP;
+    }
+
+    return cmp_jf(ctxt, rs, OX_BC_eq, s0, s1, l);
+}
+
+/*Jump if equal to.*/
+static inline OX_Result
+do_ne_jf (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, int l)
+{
+    if (is_number_binary(ctxt, s0, s1)) {
+        if (ox_value_get_number(ctxt, s0) != ox_value_get_number(ctxt, s1))
+            return OX_OK;
+
+        rs->frame->ip = l;
+        return OX_JUMP;
+    }
+
+    return cmp_jf(ctxt, rs, OX_BC_ne, s0, s1, l);
+}
+
+/*Call a function without argument.*/
+static inline OX_Result
+do_call0 (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value *d)
+{
+    return call_direct(ctxt, rs, s0, s1, NULL, 0, d);
+}
+
+/*Call a function with 1 argument.*/
+static inline OX_Result
+do_call1 (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value *s2, OX_Value *d)
+{
+    OX_Value *argv[] = {s2};
+
+    return call_direct(ctxt, rs, s0, s1, argv, 1, d);
+}
+
+/*Call a function with 2 arguments.*/
+static inline OX_Result
+do_call2 (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value *s2, OX_Value *s3, OX_Value *d)
+{
+    OX_Value *argv[] = {s2, s3};
+
+    return call_direct(ctxt, rs, s0, s1, argv, 2, d);
+}
+
+/*Call a function with 3 arguments.*/
+static inline OX_Result
+do_call3 (OX_Context *ctxt, OX_RunStatus *rs, OX_Value *s0, OX_Value *s1, OX_Value *s2, OX_Value *s3, OX_Value *s4, OX_Value *d)
+{
+    OX_Value *argv[] = {s2, s3, s4};
+
+    return call_direct(ctxt, rs, s0, s1, argv, 3, d);
+}
+
+/*Get a parameter and store it to the local declaration.*/
+static inline OX_Result
+do_p_get_t (OX_Context *ctxt, OX_RunStatus *rs, int id)
+{
+    OX_Stack *se = ox_stack_top(ctxt);
+    OX_Frame *f = ctxt->frames;
+
+    if (se->s.p.id >= rs->argc) {
+        ox_value_set_null(ctxt, &f->v[id]);
+    } else {
+        ox_value_copy(ctxt, &f->v[id], ox_values_item(ctxt, rs->args, se->s.p.id));
+
+        se->s.p.id ++;
+    }
+
+    return OX_OK;
+}
+
+/*Get an argument and store it to the local declaration.*/
+static inline OX_Result
+do_get_a_t (OX_Context *ctxt, OX_RunStatus *rs, int aid, int id)
+{
+    OX_Frame *f = ctxt->frames;
+
+    if (aid >= rs->argc)
+        ox_value_set_null(ctxt, &f->v[id]);
+    else
+        ox_value_copy(ctxt, &f->v[id], ox_values_item(ctxt, rs->args, aid));
+
+    return OX_OK;
+}
+
 /*No operation.*/
 static inline OX_Result
 do_nop (OX_Context *ctxt, OX_RunStatus *rs)
@@ -54,6 +54,11 @@ script_func_deinit (OX_Context *ctxt, OX_ScriptFunc *sfunc)
     }
 
     ox_hash_deinit(ctxt, &sfunc->decl_hash);
+
+    if (sfunc->caps)
+        OX_DEL_N(ctxt, sfunc->caps, sfunc->cap_num);
+
+    ox_jit_free(ctxt, sfunc);
 }
 
 /*Scan referenced objects in the reference item.*/
@@ -195,6 +200,9 @@ bc_script_free (OX_Context *ctxt, OX_GcObject *gco)
     if (s->pps)
         OX_DEL_N(ctxt, s->pps, s->pp_num);
 
+    if (s->pcs)
+        OX_DEL_N(ctxt, s->pcs, s->pc_num);
+
     if (s->ts)
         OX_DEL_N(ctxt, s->ts, s->t_num);
 
@@ -222,6 +230,9 @@ bc_script_free (OX_Context *ctxt, OX_GcObject *gco)
     if (s->loc_tab)
         OX_DEL_N(ctxt, s->loc_tab, s->loc_tab_len);
 
+    if (s->try_tab)
+        OX_DEL_N(ctxt, s->try_tab, s->try_tab_len);
+
     script_deinit(ctxt, &s->script);
 
     OX_DEL(ctxt, s);
@@ -369,6 +380,8 @@ script_call (OX_Context *ctxt, OX_Value *o, OX_Value *thiz, OX_Value *args, size
 
     if (s->state == OX_SCRIPT_STATE_INITED) {
         if (!ox_value_is_null(ctxt, &s->func)) {
+            /*The script's frame is managed by GC, so the bottom frames must be escaped.*/
+            ox_frame_escape(ctxt, bf);
             s->frame->bot = bf;
             ctxt->frames = s->frame;
 
@@ -560,10 +573,9 @@ script_init_frame (OX_Context *ctxt, OX_Value *v)
     size_t len = s->pub_hash.e_num;
 
     /*Create frame.*/
-    if (!(s->frame = ox_frame_push(ctxt, ox_value_null(ctxt), len)))
+    if (!(s->frame = ox_frame_new(ctxt, ox_value_null(ctxt), len)))
         return OX_ERR;
 
-    ox_frame_pop(ctxt);
     return OX_OK;
 }
 
@@ -580,10 +592,9 @@ bc_script_init_frame (OX_Context *ctxt, OX_Value *v)
         return r;
 
     /*Create the frame.*/
-    if (!(bs->script.frame = ox_frame_push(ctxt, &bs->script.func, sf->decl_hash.e_num)))
+    if (!(bs->script.frame = ox_frame_new(ctxt, &bs->script.func, sf->decl_hash.e_num)))
         return OX_ERR;
 
-    ox_frame_pop(ctxt);
     return OX_OK;
 }
 
@@ -621,10 +632,9 @@ native_script_init_frame (OX_Context *ctxt, OX_Value *v)
     }
 
     /*Create frame.*/
-    if (!(ns->script.frame = ox_frame_push(ctxt, &ns->script.func, ns->frame_size)))
+    if (!(ns->script.frame = ox_frame_new(ctxt, &ns->script.func, ns->frame_size)))
         return OX_ERR;
 
-    ox_frame_pop(ctxt);
     return OX_OK;
 }
 
@@ -1147,6 +1157,8 @@ ox_bc_script_new (OX_Context *ctxt, OX_Value *sv, OX_Input *input, OX_Bool reg)
     s->cv_num = 0;
     s->pps = NULL;
     s->pp_num = 0;
+    s->pcs = NULL;
+    s->pc_num = 0;
     s->ts = NULL;
     s->lts = NULL;
     s->t_num = 0;
@@ -1159,6 +1171,8 @@ ox_bc_script_new (OX_Context *ctxt, OX_Value *sv, OX_Input *input, OX_Bool reg)
     s->bc_len = 0;
     s->loc_tab = NULL;
     s->loc_tab_len = 0;
+    s->try_tab = NULL;
+    s->try_tab_len = 0;
 
     ox_value_set_gco(ctxt, sv, s);
     ox_gc_add(ctxt, s);
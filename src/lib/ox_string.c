@@ -1153,15 +1153,34 @@ ox_string_singleton_inner (OX_Context *ctxt, OX_String *s, OX_String **ss)
 
     e = ox_hash_lookup(ctxt, &vm->str_singleton_hash, s, &pe);
     if (e) {
-        *ss = (OX_String*)e->key;
-        return OX_OK;
-    }
+        OX_String *os = (OX_String*)e->key;
 
-    if (!OX_NEW(ctxt, e))
-        return ox_throw_no_mem_error(ctxt);
+        if (!ox_gc_is_dead(ctxt, &os->gco)) {
+            *ss = os;
+            return OX_OK;
+        }
 
-    if ((r = ox_hash_insert(ctxt, &vm->str_singleton_hash, s, e, pe)) == OX_ERR)
-        return r;
+        /*The unused string is waiting to be freed, replace it with the new one.*/
+        ops = (OX_ObjectOps*)os->gco.ops;
+        if (ops == &singleton_string_ops)
+            os->gco.ops = (OX_GcObjectOps*)&string_ops;
+        else if (ops == &const_singleton_string_ops)
+            os->gco.ops = (OX_GcObjectOps*)&const_string_ops;
+#ifdef OX_SUPPORT_MMAP
+        else
+            os->gco.ops = (OX_GcObjectOps*)&map_string_ops;
+#endif /*OX_SUPPORT_MMAP*/
+
+        e->key = s;
+    } else {
+        if (!OX_NEW(ctxt, e))
+            return ox_throw_no_mem_error(ctxt);
+
+        /*The allocation may run the garbage collecter and remove the unused strings
+         *from the hash table, so the position is looked up again.*/
+        if ((r = ox_hash_insert(ctxt, &vm->str_singleton_hash, s, e, NULL)) == OX_ERR)
+            return r;
+    }
 
     ops = (OX_ObjectOps*)s->gco.ops;
     if (ops == &string_ops)
@@ -1393,6 +1412,42 @@ String_inf_iter (OX_Context *ctxt, OX_Value *f, OX_Value *thiz, OX_Value *args,
     return string_iter_new(ctxt, rv, thiz, OX_STRING_ITER_STR);
 }
 
+/*Fast iteration step of the string.*/
+static OX_Result
+string_iter_step (OX_Context *ctxt, OX_Value *s, size_t *pos, OX_Value *v)
+{
+    const char *c;
+    OX_Result r;
+
+    if (*pos >= ox_string_length(ctxt, s))
+        return OX_FALSE;
+
+    c = ox_string_get_char_star(ctxt, s);
+
+    if ((r = ox_string_from_chars(ctxt, v, c + *pos, 1)) == OX_ERR)
+        return r;
+
+    (*pos) ++;
+    return OX_TRUE;
+}
+
+/**
+ * Get the fast iteration step function of the string.
+ * @param ctxt The current running context.
+ * @param v The value to be iterated.
+ * @param cf The "$iter" method of the value.
+ * @return The step function.
+ * @retval NULL The value is not a string or cf is not the string's "$iter" method.
+ */
+OX_IterStepFunc
+ox_string_iter_step_get (OX_Context *ctxt, OX_Value *v, OX_CFunc cf)
+{
+    if ((cf != String_inf_iter) || !ox_value_is_string(ctxt, v))
+        return NULL;
+
+    return string_iter_step;
+}
+
 /*String.$inf.chars*/
 static OX_Result
 String_inf_chars (OX_Context *ctxt, OX_Value *f, OX_Value *thiz, OX_Value *args, size_t argc, OX_Value *rv)
@@ -2844,6 +2899,8 @@ ox_string_class_init (OX_Context *ctxt)
     /*String_inf*/
     ox_not_error(ox_object_add_n_accessor_s(ctxt, OX_OBJECT(ctxt, String_inf), "length",
             String_inf_length_get, NULL));
+    ox_not_error(ox_object_set_intrinsic_s(ctxt, OX_OBJECT(ctxt, String_inf), "length",
+            OX_INTRINSIC_STRING_LENGTH));
     ox_not_error(ox_object_add_n_method_s(ctxt, OX_OBJECT(ctxt, String_inf), "$iter",
             String_inf_iter));
     ox_not_error(ox_object_add_n_method_s(ctxt, OX_OBJECT(ctxt, String_inf), "chars",
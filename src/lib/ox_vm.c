@@ -53,13 +53,24 @@ context_init (OX_Context *ctxt, OX_VM *vm)
     ctxt->s_stack = &ctxt->bot_s_stack;
     ctxt->curr_script = NULL;
     ctxt->frames = NULL;
-    ctxt->error_frames = NULL;
     ctxt->main_frames = NULL;
+    ctxt->frame_cache = NULL;
+    ctxt->frame_cache_num = 0;
     ctxt->lock_cnt = 0;
+    ctxt->gc_marker = NULL;
+    ctxt->gco_pending = NULL;
+    ctxt->gco_pending_last = NULL;
+    ctxt->gco_pending_num = 0;
+
+    memset(ctxt->mem_cache, 0, sizeof(ctxt->mem_cache));
+    memset(ctxt->mem_cache_num, 0, sizeof(ctxt->mem_cache_num));
+    ctxt->mem_alloc = 0;
+    ctxt->mem_free = 0;
 
     ox_value_set_null(ctxt, &ctxt->error);
     ox_vector_init(&ctxt->bot_v_stack);
     ox_vector_init(&ctxt->bot_s_stack);
+    ox_vector_init(&ctxt->error_frames);
 
     ox_list_append(&vm->ctxt_list, &ctxt->ln);
 
@@ -84,6 +95,16 @@ context_deinit (OX_Context *ctxt)
 
     ox_vector_deinit(ctxt, &ctxt->bot_s_stack);
     ox_vector_deinit(ctxt, &ctxt->bot_v_stack);
+    ox_vector_deinit(ctxt, &ctxt->error_frames);
+
+    /*Free the frames.*/
+    while (ctxt->frames)
+        ox_frame_pop(ctxt);
+    ox_frame_cache_deinit(ctxt);
+
+    /*Publish the objects and return the cached buffers.*/
+    ox_gc_publish(ctxt);
+    ox_mem_cache_deinit(ctxt);
 
     vm->ref --;
 }
@@ -112,6 +133,7 @@ vm_free (OX_VM *vm)
     /*Free the resource in the virtual macine.*/
     ox_script_hash_deinit(ctxt);
     ox_gc_deinit(ctxt);
+    ox_shape_deinit(ctxt);
     ox_string_singleton_deinit(ctxt);
 
     /*File encoding.*/
@@ -122,6 +144,11 @@ vm_free (OX_VM *vm)
     if (vm->install_dir)
         ox_strfree(ctxt, vm->install_dir);
 
+#ifdef OX_BC_STAT
+    /*Dump the bytecode pair statistics.*/
+    ox_bc_stat_dump();
+#endif /*OX_BC_STAT*/
+
     ox_package_deinit(ctxt);
     ox_mem_deinit(ctxt);
     ox_log_deinit(ctxt);
@@ -181,6 +208,8 @@ ox_vm_new (void)
 {
     OX_VM *vm;
     OX_Context *ctxt;
+    char *env;
+    size_t size;
 
     /*Allocate the virtual machine and the main conext.*/
     vm = malloc(sizeof(OX_VM));
@@ -204,6 +233,7 @@ ox_vm_new (void)
     ox_log_init(ctxt);
     ox_mem_init(ctxt);
     ox_gc_init(ctxt);
+    ox_shape_init(ctxt);
     ox_string_singleton_init(ctxt);
     ox_script_hash_init(ctxt);
 
@@ -215,6 +245,15 @@ ox_vm_new (void)
     /*Dump stack when throw an error.*/
     vm->dump_throw = OX_FALSE;
 
+    /*Bytecode optimization level.*/
+    vm->opt_level = 0;
+
+    /*JIT compiler.*/
+    vm->jit = OX_TRUE;
+
+    /*Property cache version.*/
+    vm->prop_cache_ver = 1;
+
     ox_values_set_null(ctxt, vm->strings, OX_STR_ID_MAX);
     ox_values_set_null(ctxt, vm->objects, OX_OBJ_ID_MAX);
     ox_value_set_null(ctxt, &vm->base.v_null);
@@ -246,6 +285,45 @@ ox_vm_new (void)
     /*Package manager.*/
     ox_package_init(ctxt);
 
+    /*Parameters of the garbage collecter.*/
+    if ((env = getenv("OX_GC_START_SIZE"))) {
+        if (ox_gc_parse_size(env, &size) == OX_OK)
+            ox_gc_set_start_size(ctxt, size);
+        else
+            OX_LOG_W(ctxt, "illegal OX_GC_START_SIZE \"%s\"", env);
+    }
+
+    if ((env = getenv("OX_GC_GROWTH"))) {
+        int growth;
+
+        if (ox_gc_parse_growth(env, &growth) == OX_OK)
+            ox_gc_set_growth(ctxt, growth);
+        else
+            OX_LOG_W(ctxt, "illegal OX_GC_GROWTH "%s"", env);
+    }
+
+    if ((env = getenv("OX_GC_MAX_SIZE"))) {
+        if (ox_gc_parse_size(env, &size) == OX_OK)
+            ox_gc_set_max_size(ctxt, size);
+        else
+            OX_LOG_W(ctxt, "illegal OX_GC_MAX_SIZE \"%s\"", env);
+    }
+
+    if ((env = getenv("OX_GC_SLICE_WORK"))) {
+        if ((ox_gc_parse_size(env, &size) == OX_OK) && size)
+            ox_gc_set_slice_work(ctxt, size);
+        else
+            OX_LOG_W(ctxt, "illegal OX_GC_SLICE_WORK \"%s\"", env);
+    }
+
+    /*Marking threads of the garbage collecter.*/
+    if ((env = getenv("OX_GC_THREADS"))) {
+        if (ox_gc_set_thread_num(ctxt, strtol(env, NULL, 10)) == OX_ERR) {
+            OX_LOG_W(ctxt, "cannot create the marking threads");
+            ox_value_set_null(ctxt, &ctxt->error);
+        }
+    }
+
     return vm;
 }
 
@@ -66,12 +66,687 @@ object_ops = {
 
 static Object objects[OBJECT_NUM];
 
+static size_t full_cb_count;
+
+static void
+gc_callback (OX_Context *ctxt, OX_Bool full, const OX_GcStats *stats, void *data)
+{
+    TEST(data == &full_cb_count);
+
+    if (full) {
+        full_cb_count ++;
+        TEST(stats->full_count > 0);
+        TEST(stats->pause_total >= stats->pause_max);
+    }
+}
+
+/*Number of the objects added in the thread's context, less than a batch.*/
+#define CTXT_OBJECT_NUM 16
+/*Size of the buffer allocated in the thread's context.*/
+#define CTXT_BUF_SIZE   4096
+
+static Object ctxt_objects[CTXT_OBJECT_NUM];
+static void  *ctxt_buf;
+
+/*Add objects and allocate a buffer in a new context.
+ *The context is freed when the thread exits.*/
+static void*
+context_entry (void *arg)
+{
+    OX_VM *vm = arg;
+    OX_Context *ctxt = ox_context_get(vm);
+    Object *o;
+    int i;
+
+    ox_lock(ctxt);
+
+    for (i = 0; i < CTXT_OBJECT_NUM; i ++) {
+        o = &ctxt_objects[i];
+
+        o->gco.ops = &object_ops;
+        o->used = OX_TRUE;
+
+        if (i < CTXT_OBJECT_NUM - 1)
+            o->ptr = &ctxt_objects[i + 1];
+        else
+            o->ptr = NULL;
+
+        ox_gc_add(ctxt, o);
+    }
+
+    ctxt_buf = ox_alloc(ctxt, CTXT_BUF_SIZE);
+
+    /*The objects and the memory size are not published yet.*/
+    TEST(ctxt->gco_pending_num == CTXT_OBJECT_NUM);
+    TEST(ctxt->mem_alloc >= CTXT_BUF_SIZE);
+
+    ox_unlock(ctxt);
+
+    return NULL;
+}
+
+/*The pending objects and the memory size are published when the context is freed.*/
+static void
+context_test (OX_Context *ctxt)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+    OX_Thread th;
+    size_t size;
+    int i;
+
+    ox_mem_flush(ctxt, ctxt);
+    size = vm->mem_allocted;
+
+    TEST(ox_thread_create(ctxt, &th, context_entry, vm) == OX_OK);
+    TEST(ox_thread_join(ctxt, &th) == OX_OK);
+
+    TEST(ctxt_buf != NULL);
+    TEST(vm->mem_allocted == size + CTXT_BUF_SIZE);
+
+    /*The objects are managed by the collecter.*/
+    ox_gc_mark(ctxt, &ctxt_objects[0]);
+    ox_gc_run(ctxt);
+
+    for (i = 0; i < CTXT_OBJECT_NUM; i ++)
+        TEST(ctxt_objects[i].used);
+
+    ox_gc_run(ctxt);
+
+    for (i = 0; i < CTXT_OBJECT_NUM; i ++)
+        TEST(!ctxt_objects[i].used);
+
+    ox_free(ctxt, ctxt_buf, CTXT_BUF_SIZE);
+}
+
+/*Size of the buffers allocated to drive the incremental collection.*/
+#define STEP_BUF_SIZE (128 * 1024)
+/*Maximum number of the step buffers.*/
+#define STEP_BUF_MAX  1024
+
+static void  *step_bufs[STEP_BUF_MAX];
+static size_t step_buf_num;
+
+/*Allocate memory and add objects to run a step of the incremental collection.*/
+static void
+gc_step (OX_Context *ctxt)
+{
+    OX_VS_PUSH(ctxt, v)
+    int i;
+
+    TEST(step_buf_num < STEP_BUF_MAX);
+
+    step_bufs[step_buf_num ++] = ox_alloc(ctxt, STEP_BUF_SIZE);
+
+    /*The collecter is checked when a batch of objects is added.*/
+    for (i = 0; i < OX_GC_PENDING_MAX; i ++)
+        ox_not_error(ox_array_new(ctxt, v, 0));
+
+    OX_VS_POP(ctxt, v)
+}
+
+/*Free the step buffers.*/
+static void
+gc_step_end (OX_Context *ctxt)
+{
+    while (step_buf_num) {
+        step_buf_num --;
+        ox_free(ctxt, step_bufs[step_buf_num], STEP_BUF_SIZE);
+    }
+}
+
+/*Start the incremental collection from the next step.*/
+static void
+gc_incremental_begin (OX_Context *ctxt)
+{
+    ox_gc_run(ctxt);
+    ox_gc_set_start_size(ctxt, 0);
+    ox_gc_set_growth(ctxt, 101);
+}
+
+#define ITEM_NUM 512
+
+static Object items[ITEM_NUM];
+
+/*Initialize the item and add it to the garbage collecter.*/
+static void
+item_add (OX_Context *ctxt, Object *o, OX_Value *v)
+{
+    o->gco.ops = &object_ops;
+    o->ptr = NULL;
+    o->used = OX_TRUE;
+
+    ox_gc_add(ctxt, o);
+    ox_value_set_gco(ctxt, v, o);
+}
+
+/*Get the item stored in the array.*/
+static Object*
+item_get (OX_Context *ctxt, OX_Value *a, size_t id, OX_Value *v)
+{
+    ox_not_error(ox_array_get_item(ctxt, a, id, v));
+
+    if (ox_value_is_null(ctxt, v))
+        return NULL;
+
+    return ox_value_get_gco(ctxt, v);
+}
+
+/*The incremental marking runs in slices and the mutations between the slices are tracked.*/
+static void
+incremental_test (OX_Context *ctxt)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+    OX_VS_PUSH_3(ctxt, a, b, v)
+    size_t start_size = ox_gc_get_start_size(ctxt);
+    int growth = ox_gc_get_growth(ctxt);
+    size_t slice_work = ox_gc_get_slice_work(ctxt);
+    size_t half = ITEM_NUM / 2;
+    size_t slices = 0, moved = 0, added = 0;
+    OX_Bool marked = OX_FALSE, ok;
+    Object *o;
+    size_t i;
+
+    /*The old items are referenced by array "b", and array "a" is empty.*/
+    ox_not_error(ox_array_new(ctxt, a, ITEM_NUM));
+    ox_not_error(ox_array_new(ctxt, b, half));
+
+    for (i = 0; i < half; i ++) {
+        item_add(ctxt, &items[i], v);
+        ox_not_error(ox_array_set_item(ctxt, b, i, v));
+    }
+
+    gc_incremental_begin(ctxt);
+    ox_gc_set_slice_work(ctxt, 8);
+
+    while (!marked || vm->gc_marking) {
+        gc_step(ctxt);
+
+        if (!vm->gc_marking)
+            continue;
+
+        marked = OX_TRUE;
+        slices ++;
+
+        /*Move an old item from "b" to "a".
+         *"a" may be scanned before and "b" may be not scanned yet.*/
+        if (moved < half) {
+            o = item_get(ctxt, b, moved, v);
+            ox_not_error(ox_array_set_item(ctxt, a, moved, v));
+            ox_value_set_null(ctxt, v);
+            ox_not_error(ox_array_set_item(ctxt, b, moved, v));
+            moved ++;
+        }
+
+        /*Store a new item to "a".*/
+        if (added < half) {
+            item_add(ctxt, &items[half + added], v);
+            ox_not_error(ox_array_set_item(ctxt, a, half + added, v));
+            added ++;
+        }
+    }
+
+    ox_gc_set_slice_work(ctxt, slice_work);
+
+    /*The marking spans several slices.*/
+    TEST(slices > 1);
+    TEST(moved > 0);
+    TEST(added > 0);
+
+    /*The stored items are not swept.*/
+    ok = OX_TRUE;
+    for (i = 0; i < ITEM_NUM; i ++) {
+        o = item_get(ctxt, a, i, v);
+        if (o && (!o->used || ox_gc_is_dead(ctxt, &o->gco)))
+            ok = OX_FALSE;
+
+        if (i < half) {
+            o = item_get(ctxt, b, i, v);
+            if (o && (!o->used || ox_gc_is_dead(ctxt, &o->gco)))
+                ok = OX_FALSE;
+        }
+    }
+    TEST(ok);
+
+    ox_gc_run(ctxt);
+
+    ok = OX_TRUE;
+    for (i = 0; i < half + added; i ++) {
+        if (!items[i].used)
+            ok = OX_FALSE;
+    }
+    TEST(ok);
+
+    /*The items are freed when the arrays are unused.*/
+    ox_value_set_null(ctxt, a);
+    ox_value_set_null(ctxt, b);
+    ox_value_set_null(ctxt, v);
+    ox_gc_run(ctxt);
+
+    ok = OX_TRUE;
+    for (i = 0; i < half + added; i ++) {
+        if (items[i].used)
+            ok = OX_FALSE;
+    }
+    TEST(ok);
+
+    gc_step_end(ctxt);
+    ox_gc_set_start_size(ctxt, start_size);
+    ox_gc_set_growth(ctxt, growth);
+
+    OX_VS_POP(ctxt, a)
+}
+
+typedef struct {
+    OX_GcObject gco;
+    void *l;
+    void *r;
+    OX_Bool used;
+} Node;
+
+static void
+node_scan (OX_Context *ctxt, OX_GcObject *gco)
+{
+    Node *n = (Node*)gco;
+
+    if (n->l)
+        ox_gc_mark(ctxt, n->l);
+    if (n->r)
+        ox_gc_mark(ctxt, n->r);
+}
+
+static void
+node_free (OX_Context *ctxt, OX_GcObject *gco)
+{
+    Node *n = (Node*)gco;
+
+    n->used = OX_FALSE;
+}
+
+static const OX_GcObjectOps
+node_ops = {
+    0,
+    node_scan,
+    node_free
+};
+
+#define NODE_NUM 16384
+
+static Node nodes[NODE_NUM];
+static OX_Bool reached[NODE_NUM];
+static size_t node_stack[NODE_NUM];
+
+/*Build a binary tree with some edges cut and some edges linked to other nodes.*/
+static void
+graph_build (OX_Context *ctxt)
+{
+    size_t i;
+
+    for (i = 0; i < NODE_NUM; i ++) {
+        Node *n = &nodes[i];
+        size_t l = i * 2 + 1;
+        size_t r = i * 2 + 2;
+
+        n->gco.ops = &node_ops;
+        n->used = OX_TRUE;
+        n->l = (l < NODE_NUM) ? &nodes[l] : NULL;
+
+        if (i % 11 == 5)
+            n->r = &nodes[(i * 37) % NODE_NUM];
+        else if ((i % 7 == 3) || (r >= NODE_NUM))
+            n->r = NULL;
+        else
+            n->r = &nodes[r];
+
+        if (i % 13 == 6)
+            n->l = NULL;
+
+        ox_gc_add(ctxt, n);
+    }
+}
+
+/*Get the nodes reachable from the first node.*/
+static size_t
+graph_reach (void)
+{
+    size_t top = 0, cnt = 0;
+
+    memset(reached, 0, sizeof(reached));
+
+    reached[0] = OX_TRUE;
+    node_stack[top ++] = 0;
+
+    while (top) {
+        Node *n = &nodes[node_stack[-- top]];
+        void *c[2] = {n->l, n->r};
+        int i;
+
+        cnt ++;
+
+        for (i = 0; i < 2; i ++) {
+            size_t id;
+
+            if (!c[i])
+                continue;
+
+            id = (Node*)c[i] - nodes;
+            if (!reached[id]) {
+                reached[id] = OX_TRUE;
+                node_stack[top ++] = id;
+            }
+        }
+    }
+
+    return cnt;
+}
+
+/*Run a full collection with the marking threads and check the surviving nodes.*/
+static void
+graph_collect (OX_Context *ctxt, int thread_num)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+    OX_Bool ok;
+    size_t i;
+
+    TEST(ox_gc_set_thread_num(ctxt, thread_num) == OX_OK);
+    TEST(vm->gc_thread_num == thread_num);
+
+    graph_build(ctxt);
+
+    ox_gc_mark(ctxt, &nodes[0]);
+    ox_gc_run(ctxt);
+
+    ok = OX_TRUE;
+    for (i = 0; i < NODE_NUM; i ++) {
+        if (nodes[i].used != reached[i])
+            ok = OX_FALSE;
+    }
+    TEST(ok);
+
+    ox_gc_run(ctxt);
+
+    ok = OX_TRUE;
+    for (i = 0; i < NODE_NUM; i ++) {
+        if (nodes[i].used)
+            ok = OX_FALSE;
+    }
+    TEST(ok);
+}
+
+/*The parallel marking gets the same result as the marking in the current thread.*/
+static void
+parallel_test (OX_Context *ctxt)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+    int thread_num = vm->gc_thread_num;
+    size_t cnt;
+
+    graph_build(ctxt);
+    cnt = graph_reach();
+    ox_gc_run(ctxt);
+
+    TEST((cnt > 1) && (cnt < NODE_NUM));
+
+    graph_collect(ctxt, 1);
+    graph_collect(ctxt, 4);
+
+    TEST(ox_gc_set_thread_num(ctxt, thread_num) == OX_OK);
+}
+
+#define FILLER_NUM 4096
+
+/*Check if the object is in the segments not swept yet.*/
+static OX_Bool
+sweep_pending (OX_Context *ctxt, OX_GcObject *gco)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+    OX_GcSegment *seg;
+    size_t i = vm->gc_sweep_ridx;
+
+    for (seg = vm->gc_sweep_rseg; seg; seg = seg->next) {
+        for (; i < seg->len; i ++) {
+            if (seg->objs[i] == gco)
+                return OX_TRUE;
+        }
+
+        i = 0;
+    }
+
+    return OX_FALSE;
+}
+
+/*The unused singleton strings are dead while sweeping and are not returned by the lookup.*/
+static void
+sweep_test (OX_Context *ctxt)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+    OX_VS_PUSH_4(ctxt, live, dead, a, v)
+    size_t start_size = ox_gc_get_start_size(ctxt);
+    int growth = ox_gc_get_growth(ctxt);
+    size_t sweep_work;
+    OX_String *ls, *ds, *ns;
+    size_t i;
+
+    ox_not_error(ox_string_from_const_char_star(ctxt, live, "gc test live string"));
+    ox_not_error(ox_string_singleton(ctxt, live));
+    ox_not_error(ox_string_from_const_char_star(ctxt, dead, "gc test dead string"));
+    ox_not_error(ox_string_singleton(ctxt, dead));
+
+    ls = ox_value_get_gco(ctxt, live);
+    ds = ox_value_get_gco(ctxt, dead);
+
+    ox_gc_run(ctxt);
+
+    /*The fillers become old after the strings, so they are swept before the strings.*/
+    ox_not_error(ox_array_new(ctxt, a, FILLER_NUM));
+    for (i = 0; i < FILLER_NUM; i ++) {
+        ox_not_error(ox_array_new(ctxt, v, 0));
+        ox_not_error(ox_array_set_item(ctxt, a, i, v));
+    }
+
+    gc_incremental_begin(ctxt);
+
+    ox_value_set_null(ctxt, dead);
+
+    while (!vm->gc_sweep_segs)
+        gc_step(ctxt);
+
+    /*Sweep some slices.*/
+    sweep_work = vm->gc_sweep_work;
+    vm->gc_sweep_work = 16;
+
+    for (i = 0; i < 4; i ++)
+        gc_step(ctxt);
+
+    TEST(vm->gc_sweep_segs != NULL);
+    TEST(sweep_pending(ctxt, &ds->gco));
+    TEST(ox_gc_is_dead(ctxt, &ds->gco));
+    TEST(!ox_gc_is_dead(ctxt, &ls->gco));
+    TEST(!ox_gc_is_dead(ctxt, ox_value_get_gco(ctxt, a)));
+
+    /*The dead singleton string is replaced by a new one.*/
+    ox_not_error(ox_string_from_const_char_star(ctxt, v, "gc test dead string"));
+    ox_not_error(ox_string_singleton(ctxt, v));
+    ns = ox_value_get_gco(ctxt, v);
+    TEST(ns != ds);
+    TEST(!ox_gc_is_dead(ctxt, &ns->gco));
+    ox_value_copy(ctxt, dead, v);
+
+    /*The live singleton string is reused.*/
+    ox_not_error(ox_string_from_const_char_star(ctxt, v, "gc test live string"));
+    ox_not_error(ox_string_singleton(ctxt, v));
+    TEST(ox_value_get_gco(ctxt, v) == ls);
+
+    vm->gc_sweep_work = sweep_work;
+    ox_gc_run(ctxt);
+
+    /*The new singleton string is kept in the table after sweeping.*/
+    ox_not_error(ox_string_from_const_char_star(ctxt, v, "gc test dead string"));
+    ox_not_error(ox_string_singleton(ctxt, v));
+    TEST(ox_value_get_gco(ctxt, v) == ns);
+
+    gc_step_end(ctxt);
+    ox_gc_set_start_size(ctxt, start_size);
+    ox_gc_set_growth(ctxt, growth);
+
+    OX_VS_POP(ctxt, live)
+}
+
+/*Object referencing many objects.*/
+typedef struct {
+    OX_GcObject gco;
+    Object **objs;
+    size_t num;
+    OX_Bool used;
+} Fan;
+
+/*Maximum number of the mark stack's chunks when the fan object is scanned.*/
+static size_t fan_chunk_num;
+/*The mark stack overflowed when the fan object is scanned.*/
+static OX_Bool fan_stack_full;
+
+static void
+fan_scan (OX_Context *ctxt, OX_GcObject *gco)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+    Fan *f = (Fan*)gco;
+    size_t i;
+
+    for (i = 0; i < f->num; i ++)
+        ox_gc_mark(ctxt, f->objs[i]);
+
+    fan_chunk_num = OX_MAX(fan_chunk_num, vm->gc_marked_stack.chunk_num);
+    fan_stack_full |= vm->gc_marked_full;
+}
+
+static void
+fan_free (OX_Context *ctxt, OX_GcObject *gco)
+{
+    Fan *f = (Fan*)gco;
+
+    f->used = OX_FALSE;
+}
+
+static const OX_GcObjectOps
+fan_ops = {
+    0,
+    fan_scan,
+    fan_free
+};
+
+/*Number of the chains referenced by the fan object.*/
+#define CHAIN_NUM 8192
+/*Length of the chains.*/
+#define CHAIN_LEN 4
+
+static Fan     fan;
+static Object  chains[CHAIN_NUM * CHAIN_LEN];
+static Object *fan_objs[CHAIN_NUM * CHAIN_LEN];
+
+/*Check if all the objects referenced by the fan object are used.*/
+static OX_Bool
+fan_used (OX_Bool used)
+{
+    size_t i;
+
+    if (fan.used != used)
+        return OX_FALSE;
+
+    for (i = 0; i < CHAIN_NUM * CHAIN_LEN; i ++) {
+        if (chains[i].used != used)
+            return OX_FALSE;
+    }
+
+    return OX_TRUE;
+}
+
+/*Run a full collection and record the mark stack's state.*/
+static void
+fan_collect (OX_Context *ctxt)
+{
+    fan_chunk_num = 0;
+    fan_stack_full = OX_FALSE;
+
+    ox_gc_run(ctxt);
+}
+
+/*The mark stack grows by chunks, and the objects not pushed to the full stack
+ *are found by rescanning the object lists and segments.*/
+static void
+stack_test (OX_Context *ctxt)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+    OX_VS_PUSH(ctxt, v)
+    int thread_num = vm->gc_thread_num;
+    size_t max = vm->gc_marked_stack.max;
+    size_t i, j;
+
+    TEST(ox_gc_set_thread_num(ctxt, 1) == OX_OK);
+
+    /*The fan object references all the objects in the chains.*/
+    for (i = 0; i < CHAIN_NUM; i ++) {
+        for (j = 0; j < CHAIN_LEN; j ++) {
+            Object *o = &chains[i * CHAIN_LEN + j];
+
+            o->gco.ops = &object_ops;
+            o->used = OX_TRUE;
+            o->ptr = (j < CHAIN_LEN - 1) ? o + 1 : NULL;
+
+            ox_gc_add(ctxt, o);
+            fan_objs[i * CHAIN_LEN + j] = o;
+        }
+    }
+
+    fan.gco.ops = &fan_ops;
+    fan.objs = fan_objs;
+    fan.num = CHAIN_NUM * CHAIN_LEN;
+    fan.used = OX_TRUE;
+
+    ox_gc_add(ctxt, &fan);
+    ox_value_set_gco(ctxt, v, &fan);
+
+    /*All the objects are pushed, the stack grows and the chunks are freed after marking.*/
+    fan_collect(ctxt);
+    TEST(!fan_stack_full);
+    TEST(fan_chunk_num >= CHAIN_NUM * CHAIN_LEN / OX_GC_MARK_CHUNK_SIZE);
+    TEST(vm->gc_marked_stack.chunk_num <= 2);
+    TEST(fan_used(OX_TRUE));
+
+    /*Only the chain heads are referenced by the fan object.
+     *The heads not pushed to the full stack are found in the old objects' segments,
+     *and the following objects are marked when the heads are scanned.*/
+    fan.num = CHAIN_NUM;
+    for (i = 0; i < CHAIN_NUM; i ++)
+        fan_objs[i] = &chains[i * CHAIN_LEN];
+
+    vm->gc_marked_stack.max = 2 * sizeof(OX_GcMarkChunk);
+    fan_collect(ctxt);
+    vm->gc_marked_stack.max = max;
+
+    TEST(fan_stack_full);
+    TEST(fan_chunk_num <= 2);
+    TEST(!vm->gc_marked_full);
+    TEST(fan_used(OX_TRUE));
+
+    /*All the objects are freed when the fan object is unused.*/
+    ox_value_set_null(ctxt, v);
+    ox_gc_run(ctxt);
+    TEST(fan_used(OX_FALSE));
+
+    TEST(ox_gc_set_thread_num(ctxt, thread_num) == OX_OK);
+
+    OX_VS_POP(ctxt, v)
+}
+
 void
 gc_test (OX_Context *ctxt)
 {
+    OX_GcStats s1, s2;
     Object *o;
     int i;
 
+    ox_gc_get_stats(ctxt, &s1);
+    ox_gc_set_callback(ctxt, gc_callback, &full_cb_count);
+
     for (i = 0; i < OBJECT_NUM; i ++) {
         o = &objects[i];
 
@@ -100,4 +775,18 @@ gc_test (OX_Context *ctxt)
         o = &objects[i];
         TEST(!o->used);
     }
-}
\ No newline at end of file
+
+    ox_gc_set_callback(ctxt, NULL, NULL);
+    ox_gc_get_stats(ctxt, &s2);
+
+    TEST(s2.full_count - s1.full_count == full_cb_count);
+    TEST(full_cb_count >= 2);
+    TEST(s2.allocated - s2.freed == s2.mem_size);
+    TEST(s2.max_mem_size >= s2.mem_size);
+
+    context_test(ctxt);
+    incremental_test(ctxt);
+    parallel_test(ctxt);
+    sweep_test(ctxt);
+    stack_test(ctxt);
+}
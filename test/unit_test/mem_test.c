@@ -39,6 +39,123 @@ typedef struct {
 
 #define ARRAY_LEN 1024
 
+#ifdef OX_MEM_SLAB
+
+#include <sys/mman.h>
+#include <errno.h>
+
+/*Size of the buffers allocated from the slabs in the test.*/
+#define SLAB_BUF_SIZE 48
+/*Number of the buffers allocated in the slab test, filling several slabs.*/
+#define SLAB_BUF_NUM  (OX_MEM_SLAB_SIZE / SLAB_BUF_SIZE * 3)
+
+/*Count the slabs in the list.*/
+static size_t
+slab_count (OX_List *l)
+{
+    OX_List *n;
+    size_t cnt = 0;
+
+    ox_list_foreach(l, n)
+        cnt ++;
+
+    return cnt;
+}
+
+/*Get the slab contains the buffer.*/
+static void*
+slab_of (void *ptr)
+{
+    return OX_SIZE2PTR(OX_PTR2SIZE(ptr) & ~(size_t)(OX_MEM_SLAB_SIZE - 1));
+}
+
+/*Check if the address is mapped.*/
+static OX_Bool
+is_mapped (void *ptr)
+{
+    if (msync(ptr, OX_MEM_SLAB_SIZE, MS_ASYNC) == -1)
+        return errno != ENOMEM;
+
+    return OX_TRUE;
+}
+
+/*Allocate and free the buffers from the slabs.*/
+static void
+slab_test (OX_Context *ctxt)
+{
+    OX_VM *vm = ox_vm_get(ctxt);
+    OX_MemSlabClass *sc = &vm->mem_slabs[(SLAB_BUF_SIZE - 1) / OX_MEM_SLAB_STEP];
+    static uint8_t *bufs[SLAB_BUF_NUM];
+    size_t old_slabs, old_size;
+    void *slab;
+    size_t i, j, num;
+    OX_Bool ok;
+
+    /*Return the cached buffers, so the buffers are allocated from the slabs.*/
+    ox_mem_cache_deinit(ctxt);
+
+    old_slabs = slab_count(&sc->partial) + slab_count(&sc->full);
+    ox_mem_flush(ctxt, ctxt);
+    old_size = vm->mem_allocted;
+
+    for (i = 0; i < SLAB_BUF_NUM; i ++) {
+        bufs[i] = ox_alloc(ctxt, SLAB_BUF_SIZE);
+        memset(bufs[i], i & 0xff, SLAB_BUF_SIZE);
+    }
+
+    ox_mem_flush(ctxt, ctxt);
+    TEST(vm->mem_allocted == old_size + SLAB_BUF_NUM * SLAB_BUF_SIZE);
+    TEST(slab_count(&sc->partial) + slab_count(&sc->full) >= old_slabs + 3);
+
+    /*The buffers are not overlapped.*/
+    ok = OX_TRUE;
+    for (i = 0; i < SLAB_BUF_NUM; i ++) {
+        for (j = 0; j < SLAB_BUF_SIZE; j ++) {
+            if (bufs[i][j] != (i & 0xff))
+                ok = OX_FALSE;
+        }
+    }
+    TEST(ok);
+
+    /*The new slabs are full except the last one.*/
+    TEST(slab_count(&sc->full) >= 2);
+
+    /*Free the buffers of the first slab allocated in the test.*/
+    slab = slab_of(bufs[SLAB_BUF_NUM / 3]);
+    TEST(is_mapped(slab));
+
+    num = 0;
+    for (i = 0; i < SLAB_BUF_NUM; i ++) {
+        if (slab_of(bufs[i]) == slab) {
+            ox_free(ctxt, bufs[i], SLAB_BUF_SIZE);
+            bufs[i] = NULL;
+            num ++;
+        }
+    }
+    ox_mem_cache_deinit(ctxt);
+
+    TEST(num == (OX_MEM_SLAB_SIZE - ((sizeof(OX_MemSlab) + OX_MEM_SLAB_STEP - 1) & ~(OX_MEM_SLAB_STEP - 1))) / SLAB_BUF_SIZE);
+
+    /*The empty slab is returned to the system.*/
+    TEST(!is_mapped(slab));
+
+    /*The freed buffers are reused.*/
+    for (i = 0; i < SLAB_BUF_NUM; i ++) {
+        if (!bufs[i])
+            bufs[i] = ox_alloc(ctxt, SLAB_BUF_SIZE);
+    }
+
+    for (i = 0; i < SLAB_BUF_NUM; i ++)
+        ox_free(ctxt, bufs[i], SLAB_BUF_SIZE);
+    ox_mem_cache_deinit(ctxt);
+
+    ox_mem_flush(ctxt, ctxt);
+    TEST(vm->mem_allocted == old_size);
+    TEST(slab_count(&sc->partial) + slab_count(&sc->full) <= old_slabs + 1);
+}
+
+#endif /*OX_MEM_SLAB*/
+
 void
 mem_test (OX_Context *ctxt)
 {
@@ -103,6 +220,10 @@ mem_test (OX_Context *ctxt)
 
     OX_DEL_N(ctxt, p, ARRAY_LEN);
 
+#ifdef OX_MEM_SLAB
+    slab_test(ctxt);
+#endif /*OX_MEM_SLAB*/
+
     /*Assert.*/
     //ox_not_null(OX_NEW_N(ctxt, p, 0xffffffff));
 }